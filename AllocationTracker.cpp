@@ -0,0 +1,155 @@
+#include "AllocationTracker.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+const std::size_t tagCount = static_cast<std::size_t>(AllocTag::Count);
+
+struct TagCounters {
+    std::atomic<std::uint64_t> allocations{0};
+    std::atomic<std::uint64_t> frees{0};
+    std::atomic<std::uint64_t> bytesAllocated{0};
+    std::atomic<std::uint64_t> bytesFreed{0};
+    std::atomic<std::int64_t> liveBytes{0};
+    std::atomic<std::int64_t> peakLiveBytes{0};
+};
+
+// Zero-initialised statics, usable before any constructor has run
+TagCounters counters[tagCount];
+thread_local AllocTag currentTag = AllocTag::Other;
+
+} // namespace
+
+#ifdef TRIANGLE_ALLOC_TRACKING
+
+namespace {
+
+// Each block is prefixed with its size and owning tag. 16 bytes keeps the
+// pointer handed out at malloc's alignment.
+struct BlockHeader {
+    std::uint64_t size;
+    std::uint64_t tag;
+};
+static_assert(sizeof(BlockHeader) == 16, "allocation header must keep 16-byte alignment");
+
+void* trackedAllocate(std::size_t size) {
+    void* raw = std::malloc(sizeof(BlockHeader) + size);
+    if (!raw) {
+        throw std::bad_alloc();
+    }
+
+    std::size_t tag = static_cast<std::size_t>(currentTag);
+    BlockHeader* header = static_cast<BlockHeader*>(raw);
+    header->size = size;
+    header->tag = tag;
+
+    TagCounters& owner = counters[tag];
+    owner.allocations.fetch_add(1, std::memory_order_relaxed);
+    owner.bytesAllocated.fetch_add(size, std::memory_order_relaxed);
+    std::int64_t live = owner.liveBytes.fetch_add(static_cast<std::int64_t>(size), std::memory_order_relaxed) +
+                        static_cast<std::int64_t>(size);
+    std::int64_t peak = owner.peakLiveBytes.load(std::memory_order_relaxed);
+    while (live > peak && !owner.peakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+    return header + 1;
+}
+
+void trackedFree(void* pointer) {
+    if (!pointer) {
+        return;
+    }
+
+    BlockHeader* header = static_cast<BlockHeader*>(pointer) - 1;
+    TagCounters& current = counters[static_cast<std::size_t>(currentTag)];
+    current.frees.fetch_add(1, std::memory_order_relaxed);
+    current.bytesFreed.fetch_add(header->size, std::memory_order_relaxed);
+    counters[header->tag].liveBytes.fetch_sub(static_cast<std::int64_t>(header->size), std::memory_order_relaxed);
+    std::free(header);
+}
+
+} // namespace
+
+// The nothrow and array forms forward to these in the standard library.
+// Over-aligned new/delete are left alone; they never reach these operators.
+void* operator new(std::size_t size) {
+    return trackedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    trackedFree(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    trackedFree(pointer);
+}
+
+#endif
+
+ScopedAllocTag::ScopedAllocTag(AllocTag tag)
+    : previous(currentTag) {
+    currentTag = tag;
+}
+
+ScopedAllocTag::~ScopedAllocTag() {
+    currentTag = previous;
+}
+
+std::uint64_t AllocationSnapshot::totalAllocations() const {
+    std::uint64_t total = 0;
+    for (const AllocationCounters& tag : tags) {
+        total += tag.allocations;
+    }
+    return total;
+}
+
+namespace AllocationTracker {
+
+bool enabled() {
+#ifdef TRIANGLE_ALLOC_TRACKING
+    return true;
+#else
+    return false;
+#endif
+}
+
+AllocationSnapshot snapshot() {
+    AllocationSnapshot result;
+    for (std::size_t i = 0; i < tagCount; ++i) {
+        result.tags[i].allocations = counters[i].allocations.load(std::memory_order_relaxed);
+        result.tags[i].frees = counters[i].frees.load(std::memory_order_relaxed);
+        result.tags[i].bytesAllocated = counters[i].bytesAllocated.load(std::memory_order_relaxed);
+        result.tags[i].bytesFreed = counters[i].bytesFreed.load(std::memory_order_relaxed);
+        result.liveBytes[i] = counters[i].liveBytes.load(std::memory_order_relaxed);
+        result.peakLiveBytes[i] = counters[i].peakLiveBytes.load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+AllocationSnapshot difference(const AllocationSnapshot& before, const AllocationSnapshot& after) {
+    AllocationSnapshot result = after;
+    for (std::size_t i = 0; i < tagCount; ++i) {
+        result.tags[i].allocations -= before.tags[i].allocations;
+        result.tags[i].frees -= before.tags[i].frees;
+        result.tags[i].bytesAllocated -= before.tags[i].bytesAllocated;
+        result.tags[i].bytesFreed -= before.tags[i].bytesFreed;
+    }
+    return result;
+}
+
+const char* tagName(AllocTag tag) {
+    switch (tag) {
+        case AllocTag::Other: return "other";
+        case AllocTag::Timers: return "timers";
+        case AllocTag::Entities: return "entities";
+        case AllocTag::Collision: return "collision";
+        case AllocTag::UI: return "ui";
+        case AllocTag::Render: return "render";
+        case AllocTag::Count: break;
+    }
+    return "?";
+}
+
+} // namespace AllocationTracker
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Heap allocation accounting.
+// When built with TRIANGLE_ALLOC_TRACKING, AllocationTracker.cpp replaces the
+// global operator new/delete and attributes every allocation to the tag of the
+// innermost ScopedAllocTag on the calling thread. Without the define the
+// scopes still compile but every counter stays zero.
+
+// Subsystems allocations are charged to
+enum class AllocTag : std::uint8_t {
+    Other,       // Anything outside a tagged scope
+    Timers,
+    Entities,    // EntityStore columns and slot tables
+    Collision,
+    UI,          // HUD strings
+    Render,      // SFML drawables and text geometry
+    Count
+};
+
+struct AllocationCounters {
+    std::uint64_t allocations = 0;
+    std::uint64_t frees = 0;
+    std::uint64_t bytesAllocated = 0;
+    std::uint64_t bytesFreed = 0;
+};
+
+// Counters per tag, plus the live and peak live bytes owned by each tag.
+// A free is counted under the current tag; its bytes are returned to the tag
+// that made the allocation.
+struct AllocationSnapshot {
+    AllocationCounters tags[static_cast<std::size_t>(AllocTag::Count)];
+    std::int64_t liveBytes[static_cast<std::size_t>(AllocTag::Count)] = {};
+    std::int64_t peakLiveBytes[static_cast<std::size_t>(AllocTag::Count)] = {};
+
+    const AllocationCounters& operator[](AllocTag tag) const { return tags[static_cast<std::size_t>(tag)]; }
+    std::uint64_t totalAllocations() const;
+};
+
+// Charge allocations made while alive to `tag`; scopes nest
+class ScopedAllocTag {
+private:
+    AllocTag previous;
+
+public:
+    explicit ScopedAllocTag(AllocTag tag);
+    ~ScopedAllocTag();
+    ScopedAllocTag(const ScopedAllocTag&) = delete;
+    ScopedAllocTag& operator=(const ScopedAllocTag&) = delete;
+};
+
+namespace AllocationTracker {
+    bool enabled();                     // True when the global operators are replaced
+    AllocationSnapshot snapshot();
+    // Counter deltas between two snapshots (live/peak bytes are taken from `after`)
+    AllocationSnapshot difference(const AllocationSnapshot& before, const AllocationSnapshot& after);
+    const char* tagName(AllocTag tag);
+}
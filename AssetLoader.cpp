@@ -0,0 +1,56 @@
+#include "AssetLoader.h"
+
+AssetLoader::AssetLoader()
+    : stopping(false) {
+    worker = std::thread(&AssetLoader::workerLoop, this);
+}
+
+AssetLoader::~AssetLoader() {
+    {
+        std::lock_guard<std::mutex> lock(jobsMutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    worker.join();
+}
+
+void AssetLoader::enqueue(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(jobsMutex);
+        jobs.push_back(std::move(job));
+    }
+    wake.notify_one();
+}
+
+void AssetLoader::workerLoop() {
+    // Jobs still queued at shutdown are dropped
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(jobsMutex);
+            wake.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (stopping) {
+                return;
+            }
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        job();
+    }
+}
+
+AssetHandle<FontAsset> AssetLoader::loadFont(const std::vector<std::string>& candidates) {
+    return load<FontAsset>([candidates]() {
+        auto begin = std::chrono::steady_clock::now();
+        auto asset = std::make_shared<FontAsset>();
+        for (const auto& path : candidates) {
+            if (asset->font.loadFromFile(path)) {
+                asset->path = path;
+                asset->loadMs = std::chrono::duration<float, std::milli>(
+                    std::chrono::steady_clock::now() - begin).count();
+                return asset;
+            }
+        }
+        return std::shared_ptr<FontAsset>();
+    });
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// A load running (or queued) on the AssetLoader's thread. The game thread
+// polls ready() once per frame and never waits; get() is null until the load
+// has finished, and stays null if it failed.
+template <typename T>
+class AssetHandle {
+private:
+    std::shared_future<std::shared_ptr<T>> result;
+
+public:
+    AssetHandle() {}
+    explicit AssetHandle(std::shared_future<std::shared_ptr<T>> result) : result(std::move(result)) {}
+
+    bool valid() const { return result.valid(); }
+    bool ready() const {
+        return result.valid() && result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+    bool waitFor(std::chrono::milliseconds timeout) const {
+        return result.valid() && result.wait_for(timeout) == std::future_status::ready;
+    }
+    std::shared_ptr<T> get() const { return ready() ? result.get() : nullptr; }
+};
+
+struct FontAsset {
+    sf::Font font;
+    std::string path;
+    float loadMs = 0.0f;   // Time spent on the loader thread
+};
+
+// Decodes assets on one background thread so startup can present a window
+// before anything slow has finished. Jobs run in the order queued. Each
+// returns a shared_ptr (null on failure), handed over through a future, so
+// the finished asset is fully visible to the game thread once ready().
+class AssetLoader {
+private:
+    std::thread worker;
+    std::mutex jobsMutex;
+    std::condition_variable wake;
+    std::deque<std::function<void()>> jobs;
+    bool stopping;
+
+    void workerLoop();
+    void enqueue(std::function<void()> job);
+
+public:
+    AssetLoader();
+    ~AssetLoader();
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    template <typename T, typename Load>
+    AssetHandle<T> load(Load loadAsset) {
+        // packaged_task is move-only and std::function needs a copyable job
+        auto task = std::make_shared<std::packaged_task<std::shared_ptr<T>()>>(std::move(loadAsset));
+        AssetHandle<T> handle(task->get_future().share());
+        enqueue([task]() { (*task)(); });
+        return handle;
+    }
+
+    // First of the candidates that loads
+    AssetHandle<FontAsset> loadFont(const std::vector<std::string>& candidates);
+};
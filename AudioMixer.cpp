@@ -0,0 +1,211 @@
+#include "AudioMixer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const float pi = 3.14159265f;
+
+// Deterministic noise so every run sounds the same
+float noise(std::uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+    return static_cast<float>(state >> 8) / static_cast<float>(1u << 23) - 1.0f;
+}
+
+} // namespace
+
+AudioMixer::AudioMixer(std::unique_ptr<AudioSink> sink)
+    : sink(std::move(sink))
+    , mixBuffer(blockFrames * channels)
+    , outputBuffer(blockFrames * channels)
+    , running(false)
+    , activeVoices(0)
+    , peakVoices(0)
+    , voicesStolen(0)
+    , commandsDropped(0)
+    , blocksMixed(0) {
+    for (std::size_t i = 0; i < static_cast<std::size_t>(SoundId::Count); ++i) {
+        synthesize(static_cast<SoundId>(i), sounds[i]);
+    }
+}
+
+AudioMixer::~AudioMixer() {
+    stop();
+}
+
+void AudioMixer::synthesize(SoundId sound, std::vector<float>& samples) {
+    std::uint32_t seed = 12345u + static_cast<std::uint32_t>(sound);
+    float rate = static_cast<float>(sampleRate);
+
+    switch (sound) {
+        case SoundId::Explosion: {
+            // Low-passed noise burst with a long decay
+            samples.resize(static_cast<std::size_t>(0.6f * rate));
+            float filtered = 0.0f;
+            for (std::size_t i = 0; i < samples.size(); ++i) {
+                float t = i / rate;
+                filtered += 0.08f * (noise(seed) - filtered);
+                samples[i] = 2.5f * filtered * std::exp(-6.0f * t);
+            }
+            break;
+        }
+        case SoundId::PlayerHit: {
+            // Falling thump with a little grit
+            samples.resize(static_cast<std::size_t>(0.35f * rate));
+            float phase = 0.0f;
+            for (std::size_t i = 0; i < samples.size(); ++i) {
+                float t = i / rate;
+                float frequency = 60.0f + 160.0f * std::exp(-10.0f * t);
+                phase += 2.0f * pi * frequency / rate;
+                samples[i] = (0.8f * std::sin(phase) + 0.15f * noise(seed)) * std::exp(-8.0f * t);
+            }
+            break;
+        }
+        case SoundId::Dodge: {
+            // Short bright blip
+            samples.resize(static_cast<std::size_t>(0.08f * rate));
+            for (std::size_t i = 0; i < samples.size(); ++i) {
+                float t = i / rate;
+                samples[i] = 0.35f * std::sin(2.0f * pi * 880.0f * t) * std::exp(-40.0f * t);
+            }
+            break;
+        }
+        case SoundId::Click: {
+            // UI tick
+            samples.resize(static_cast<std::size_t>(0.03f * rate));
+            for (std::size_t i = 0; i < samples.size(); ++i) {
+                float t = i / rate;
+                float square = std::sin(2.0f * pi * 1500.0f * t) > 0.0f ? 1.0f : -1.0f;
+                samples[i] = 0.2f * square * std::exp(-120.0f * t);
+            }
+            break;
+        }
+        case SoundId::Count:
+            break;
+    }
+}
+
+bool AudioMixer::start() {
+    if (running || !sink || !sink->start(sampleRate, channels)) {
+        return false;
+    }
+    running = true;
+    mixerThread = std::thread(&AudioMixer::mixerLoop, this);
+    return true;
+}
+
+void AudioMixer::stop() {
+    if (!running) {
+        return;
+    }
+    running = false;
+    if (mixerThread.joinable()) {
+        mixerThread.join();
+    }
+    sink->stop();
+}
+
+bool AudioMixer::play(SoundId sound, float volume, float pan) {
+    if (!running) {
+        return false;
+    }
+    if (!commands.push(AudioCommand{sound, volume, pan})) {
+        commandsDropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+AudioStats AudioMixer::getStats() const {
+    AudioStats stats;
+    stats.activeVoices = activeVoices.load(std::memory_order_relaxed);
+    stats.peakVoices = peakVoices.load(std::memory_order_relaxed);
+    stats.voicesStolen = voicesStolen.load(std::memory_order_relaxed);
+    stats.commandsDropped = commandsDropped.load(std::memory_order_relaxed);
+    stats.blocksMixed = blocksMixed.load(std::memory_order_relaxed);
+    stats.underruns = sink ? sink->getUnderruns() : 0;
+    return stats;
+}
+
+void AudioMixer::mixerLoop() {
+    // The sink paces this loop (device backpressure or real-time sleeps)
+    while (running) {
+        AudioCommand command;
+        while (commands.pop(command)) {
+            startVoice(command);
+        }
+        mixBlock();
+        sink->write(outputBuffer.data(), blockFrames);
+        blocksMixed.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void AudioMixer::startVoice(const AudioCommand& command) {
+    std::size_t soundIndex = static_cast<std::size_t>(command.sound);
+    if (soundIndex >= static_cast<std::size_t>(SoundId::Count)) {
+        return;
+    }
+
+    // Free voice, or steal the one with the least left to play
+    Voice* target = nullptr;
+    for (Voice& voice : voices) {
+        if (!voice.active) {
+            target = &voice;
+            break;
+        }
+    }
+    if (!target) {
+        target = &voices[0];
+        for (Voice& voice : voices) {
+            if (voice.length - voice.position < target->length - target->position) {
+                target = &voice;
+            }
+        }
+        voicesStolen.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Equal-power pan
+    float pan = std::min(1.0f, std::max(-1.0f, command.pan));
+    float angle = (pan + 1.0f) * pi / 4.0f;
+    float volume = std::min(1.0f, std::max(0.0f, command.volume));
+
+    target->samples = sounds[soundIndex].data();
+    target->length = sounds[soundIndex].size();
+    target->position = 0;
+    target->gainLeft = volume * std::cos(angle);
+    target->gainRight = volume * std::sin(angle);
+    target->active = true;
+}
+
+void AudioMixer::mixBlock() {
+    std::fill(mixBuffer.begin(), mixBuffer.end(), 0.0f);
+
+    std::uint32_t voiceCount = 0;
+    for (Voice& voice : voices) {
+        if (!voice.active) {
+            continue;
+        }
+        voiceCount++;
+        std::size_t frames = std::min(blockFrames, voice.length - voice.position);
+        const float* source = voice.samples + voice.position;
+        for (std::size_t i = 0; i < frames; ++i) {
+            mixBuffer[2 * i] += source[i] * voice.gainLeft;
+            mixBuffer[2 * i + 1] += source[i] * voice.gainRight;
+        }
+        voice.position += frames;
+        if (voice.position >= voice.length) {
+            voice.active = false;
+        }
+    }
+
+    activeVoices.store(voiceCount, std::memory_order_relaxed);
+    if (voiceCount > peakVoices.load(std::memory_order_relaxed)) {
+        peakVoices.store(voiceCount, std::memory_order_relaxed);
+    }
+
+    // Soft clip, then convert
+    for (std::size_t i = 0; i < mixBuffer.size(); ++i) {
+        float sample = std::tanh(mixBuffer[i]);
+        outputBuffer[i] = static_cast<std::int16_t>(sample * 32767.0f);
+    }
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include "AudioSink.h"
+#include "SpscQueue.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Synthesised effects; generated once at startup, no asset files needed
+enum class SoundId : std::uint8_t {
+    Explosion,
+    PlayerHit,
+    Dodge,
+    Click,
+    Count
+};
+
+// What the game thread sends to the mixer. Fixed size, copied by value.
+struct AudioCommand {
+    SoundId sound;
+    float volume;   // 0..1
+    float pan;      // -1 left .. 1 right
+};
+
+struct AudioStats {
+    std::uint32_t activeVoices = 0;
+    std::uint32_t peakVoices = 0;
+    std::uint64_t voicesStolen = 0;
+    std::uint64_t commandsDropped = 0;  // Queue was full; the game never waits
+    std::uint64_t blocksMixed = 0;
+    std::uint64_t underruns = 0;
+};
+
+// Software mixer on its own thread.
+// play() pushes a command into a wait-free SPSC queue and returns; the mixer
+// thread drains the queue, mixes up to maxVoices voices into a preallocated
+// block and hands it to the sink. When every voice is busy the one closest
+// to finishing is stolen. Nothing on either side allocates after start().
+class AudioMixer {
+public:
+    static constexpr unsigned int sampleRate = 44100;
+    static constexpr unsigned int channels = 2;
+    static constexpr std::size_t blockFrames = 512;     // ~11.6 ms
+    static constexpr std::size_t maxVoices = 16;
+
+private:
+    struct Voice {
+        const float* samples = nullptr;
+        std::size_t length = 0;
+        std::size_t position = 0;
+        float gainLeft = 0.0f;
+        float gainRight = 0.0f;
+        bool active = false;
+    };
+
+    std::unique_ptr<AudioSink> sink;
+    SpscQueue<AudioCommand, 128> commands;
+    std::vector<float> sounds[static_cast<std::size_t>(SoundId::Count)];  // Mono banks
+    Voice voices[maxVoices];
+    std::vector<float> mixBuffer;
+    std::vector<std::int16_t> outputBuffer;
+
+    std::thread mixerThread;
+    std::atomic<bool> running;
+    std::atomic<std::uint32_t> activeVoices;
+    std::atomic<std::uint32_t> peakVoices;
+    std::atomic<std::uint64_t> voicesStolen;
+    std::atomic<std::uint64_t> commandsDropped;
+    std::atomic<std::uint64_t> blocksMixed;
+
+    void mixerLoop();
+    void startVoice(const AudioCommand& command);
+    void mixBlock();
+    static void synthesize(SoundId sound, std::vector<float>& samples);
+
+public:
+    explicit AudioMixer(std::unique_ptr<AudioSink> sink);
+    ~AudioMixer();
+    AudioMixer(const AudioMixer&) = delete;
+    AudioMixer& operator=(const AudioMixer&) = delete;
+
+    bool start();
+    void stop();
+
+    // Game thread only. Never blocks; returns false (and counts a drop) if the queue is full.
+    bool play(SoundId sound, float volume = 1.0f, float pan = 0.0f);
+    AudioStats getStats() const;
+};
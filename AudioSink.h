@@ -0,0 +1,21 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Destination for the mixer's output.
+// SfmlAudioSink plays through the sound device; NullAudioSink discards the
+// samples (optionally writing them to a WAV file) so audio can be exercised
+// without a device.
+class AudioSink {
+public:
+    virtual ~AudioSink() {}
+
+    virtual bool start(unsigned int sampleRate, unsigned int channels) = 0;
+    // Called on the mixer thread with one block of interleaved samples. May
+    // block to pace the mixer; must not call back into the game.
+    virtual void write(const std::int16_t* samples, std::size_t frameCount) = 0;
+    virtual void stop() = 0;
+
+    // Times the output ran dry (device) or the mixer fell behind real time
+    virtual std::uint64_t getUnderruns() const = 0;
+};
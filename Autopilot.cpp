@@ -0,0 +1,223 @@
+#include "Autopilot.h"
+#include "Obstacle.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const float clearanceCap = 80.0f;       // Gaps wider than this are all equally safe
+const float safetyMargin = 4.0f;        // Covers the tilt lag of the player's box
+const float clearanceDecay = 0.9f;      // Per step; near-term clearance matters most
+const float homeY = 650.0f;             // Where Player::reset() puts the triangle
+const float homePull = 0.05f;
+const float hitPenalty = 1.0e6f;
+const float farAway = 1.0e6f;           // Box corner for obstacles that left the screen
+
+} // namespace
+
+Autopilot::Autopilot(std::size_t obstacleCapacity, float budgetMicros)
+    : budgetMicros(budgetMicros)
+    , capacity(std::min<std::size_t>(obstacleCapacity, 0xFFFF))
+    , obstacleCount(0)
+    , predictedTicks(0)
+    , positions(capacity)
+    , velocities(capacity)
+    , radii(capacity)
+    , boxSizes(capacity)
+    , alive(capacity)
+    , predictedBoxes(static_cast<std::size_t>(horizonTicks) * capacity)
+    , bestScore(0.0f)
+    , haveBest(false)
+    , phase(0)
+    , rng(1) {
+    contacts.reserve(4 * capacity);
+    bestPlan.fill(4);
+}
+
+void Autopilot::reset() {
+    haveBest = false;
+    phase = 0;
+    bestPlan.fill(4);
+}
+
+sf::Vector2f Autopilot::actionDirection(std::uint8_t action) {
+    // 0..8 covers every combination of {left, none, right} x {forward, none, backward}; 4 is idle
+    return sf::Vector2f(static_cast<float>(action % 3) - 1.0f, static_cast<float>(action / 3) - 1.0f);
+}
+
+void Autopilot::predict(const Archetype& obstacles, float tickSeconds, Clock::time_point deadline) {
+    obstacleCount = std::min(obstacles.size(), capacity);
+    for (std::size_t i = 0; i < obstacleCount; ++i) {
+        float outline = obstacles.styles[i].outlineThickness;
+        positions[i] = obstacles.transforms[i].position;
+        velocities[i] = obstacles.velocities[i].linear;
+        radii[i] = obstacles.colliders[i].radius;
+        boxSizes[i] = 2.0f * (radii[i] + outline);
+        alive[i] = 1;
+    }
+
+    // Same order as Game::update: integrate, then dodges, then pair contacts
+    // Stops before a tick that might not finish by the deadline (1.5x the last one)
+    Clock::time_point tickStart = Clock::now();
+    Clock::duration tickCost = Clock::duration::zero();
+    int tick = 0;
+    for (; tick < horizonTicks; ++tick) {
+        if (tick > 0) {
+            Clock::time_point now = Clock::now();
+            tickCost = now - tickStart;
+            tickStart = now;
+            if (now + tickCost + tickCost / 2 > deadline) {
+                break;
+            }
+        }
+        sf::Vector2f* boxes = &predictedBoxes[static_cast<std::size_t>(tick) * capacity];
+        for (std::size_t i = 0; i < obstacleCount; ++i) {
+            positions[i] += velocities[i] * tickSeconds;
+            if (alive[i] && isObstacleOffscreen(Transform{positions[i]})) {
+                alive[i] = 0;
+            }
+            float outline = 0.5f * boxSizes[i] - radii[i];
+            boxes[i] = alive[i] ? positions[i] - sf::Vector2f(outline, outline) : sf::Vector2f(farAway, farAway);
+        }
+
+        contacts.clear();
+        for (std::size_t i = 0; i < obstacleCount; ++i) {
+            for (std::size_t j = i + 1; j < obstacleCount; ++j) {
+                if (boxes[i].x < boxes[j].x + boxSizes[j] && boxes[j].x < boxes[i].x + boxSizes[i] &&
+                    boxes[i].y < boxes[j].y + boxSizes[j] && boxes[j].y < boxes[i].y + boxSizes[i] &&
+                    contacts.size() < contacts.capacity()) {
+                    contacts.push_back(static_cast<std::uint32_t>((i << 16) | j));
+                }
+            }
+        }
+        for (std::uint32_t pair : contacts) {
+            std::size_t i = pair >> 16;
+            std::size_t j = pair & 0xFFFF;
+            resolveContact(positions[i], velocities[i], radii[i], positions[j], velocities[j], radii[j]);
+        }
+    }
+    predictedTicks = tick;
+}
+
+float Autopilot::evaluate(const Plan& plan, const PlayerModel& player, float tickSeconds) const {
+    sf::Vector2f position = player.position;
+    float move = player.speed * tickSeconds;
+    float half = player.halfExtent + safetyMargin;
+    float score = 0.0f;
+    float weight = 1.0f;
+    float stepGap = clearanceCap;
+
+    for (int tick = 0; tick < predictedTicks; ++tick) {
+        // Player moves first each tick, then obstacles; see Game::update
+        sf::Vector2f direction = actionDirection(plan[std::min(planSteps - 1, (tick + phase) / stepTicks)]);
+        position.x = std::min(Player::fieldWidth - player.size, std::max(player.size, position.x + direction.x * move));
+        position.y = std::min(Player::bottomLimit, std::max(Player::topLimit, position.y + direction.y * move));
+
+        const sf::Vector2f* boxes = &predictedBoxes[static_cast<std::size_t>(tick) * capacity];
+        float minGap = clearanceCap;
+        for (std::size_t i = 0; i < obstacleCount; ++i) {
+            float gapX = std::max(boxes[i].x - (position.x + half), (position.x - half) - (boxes[i].x + boxSizes[i]));
+            float gapY = std::max(boxes[i].y - (position.y + half), (position.y - half) - (boxes[i].y + boxSizes[i]));
+            minGap = std::min(minGap, std::max(gapX, gapY));
+        }
+        if (minGap < 0.0f) {
+            // Any hit loses to any miss; later hits lose less
+            return -hitPenalty * static_cast<float>(predictedTicks - tick);
+        }
+
+        stepGap = std::min(stepGap, minGap);
+        if ((tick + phase + 1) % stepTicks == 0) {
+            score += weight * stepGap;
+            weight *= clearanceDecay;
+            stepGap = clearanceCap;
+        }
+    }
+
+    // Drift back towards the start position when nothing is close
+    score -= homePull * (std::abs(position.y - homeY) + 0.5f * std::abs(position.x - 0.5f * Player::fieldWidth));
+    return score;
+}
+
+void Autopilot::advanceBestPlan() {
+    if (++phase < stepTicks) {
+        return;
+    }
+    phase = 0;
+    std::rotate(bestPlan.begin(), bestPlan.begin() + 1, bestPlan.end());
+    bestPlan[planSteps - 1] = bestPlan[planSteps - 2];
+}
+
+PlayerInput Autopilot::plan(const Archetype& obstacles, const PlayerModel& player, float tickSeconds) {
+    Clock::time_point start = Clock::now();
+    auto budget = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float, std::micro>(budgetMicros));
+    Clock::time_point deadline = start + budget;
+
+    // Up to half the budget for the prediction; a shorter horizon is better than no search
+    predict(obstacles, tickSeconds, start + budget / 2);
+
+    if (haveBest) {
+        advanceBestPlan();
+    }
+    bestScore = evaluate(bestPlan, player, tickSeconds);
+    haveBest = true;
+    int candidates = 1;
+
+    // Each candidate is only tried if 1.5x the last one's cost still fits before the deadline
+    Clock::time_point lastCheck = Clock::now();
+    auto hasTime = [&]() {
+        Clock::time_point now = Clock::now();
+        Clock::duration cost = now - lastCheck;
+        lastCheck = now;
+        return now + cost + cost / 2 <= deadline;
+    };
+    Plan candidate;
+    auto tryCandidate = [&]() {
+        float score = evaluate(candidate, player, tickSeconds);
+        candidates++;
+        if (score > bestScore) {
+            bestScore = score;
+            bestPlan = candidate;
+        }
+    };
+
+    // Hold one action for the whole horizon; idle (4) first so it wins ties
+    static const std::uint8_t constantOrder[] = {4, 0, 1, 2, 3, 5, 6, 7, 8};
+    for (std::uint8_t action : constantOrder) {
+        if (!hasTime()) {
+            break;
+        }
+        candidate.fill(action);
+        tryCandidate();
+    }
+
+    // Spend the rest of the budget on mutations of the best plan: one run of steps set to one action
+    std::uniform_int_distribution<int> stepDis(0, planSteps - 1);
+    std::uniform_int_distribution<int> actionDis(0, 8);
+    while (hasTime()) {
+        candidate = bestPlan;
+        int first = stepDis(rng);
+        int last = std::min(planSteps - 1, first + stepDis(rng) / 2);
+        std::fill(candidate.begin() + first, candidate.begin() + last + 1,
+                  static_cast<std::uint8_t>(actionDis(rng)));
+        tryCandidate();
+    }
+
+    float elapsed = std::chrono::duration<float, std::micro>(Clock::now() - start).count();
+    stats.plans++;
+    stats.candidatesEvaluated += static_cast<std::uint64_t>(candidates);
+    stats.lastCandidates = candidates;
+    stats.lastHorizonTicks = predictedTicks;
+    stats.lastPlanMicros = elapsed;
+    stats.worstPlanMicros = std::max(stats.worstPlanMicros, elapsed);
+    if (elapsed > budgetMicros) {
+        stats.budgetOverruns++;
+    }
+
+    sf::Vector2f direction = actionDirection(bestPlan[0]);
+    PlayerInput input;
+    input.left = direction.x < 0.0f;
+    input.right = direction.x > 0.0f;
+    input.forward = direction.y < 0.0f;
+    input.backward = direction.y > 0.0f;
+    return input;
+}
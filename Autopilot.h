@@ -0,0 +1,82 @@
+#pragma once
+#include "EntityStore.h"
+#include "Player.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+struct AutopilotStats {
+    std::uint64_t plans = 0;                  // plan() calls
+    std::uint64_t candidatesEvaluated = 0;
+    std::uint64_t budgetOverruns = 0;         // plan() calls that finished past the budget
+    float lastPlanMicros = 0.0f;
+    float worstPlanMicros = 0.0f;
+    int lastHorizonTicks = 0;                 // Lookahead predicted before the deadline
+    int lastCandidates = 0;
+};
+
+// Plays the game for attract mode and soak runs.
+// Each tick it forward-simulates the obstacles (movement plus the same
+// elastic pair contacts Game applies) and scores sequences of the nine
+// move-key combinations against that prediction. The search is anytime:
+// it stops at the time budget with the best plan found so far. The previous
+// tick's best plan, advanced by one tick, is always the first candidate, so
+// search effort carries over from tick to tick. No allocation after construction.
+class Autopilot {
+public:
+    static constexpr int stepTicks = 3;                          // Ticks each planned action is held
+    static constexpr int planSteps = 20;
+    static constexpr int horizonTicks = stepTicks * planSteps;   // 1 s at 60 Hz
+    static constexpr float defaultBudgetMicros = 500.0f;
+
+    // What the planner needs to know about the player
+    struct PlayerModel {
+        sf::Vector2f position;
+        float speed;
+        float size;          // x stays within [size, Player::fieldWidth - size]
+        float halfExtent;    // Half the side of the collision box
+    };
+
+private:
+    using Clock = std::chrono::steady_clock;
+    using Plan = std::array<std::uint8_t, planSteps>;  // Action per step, see actionDirection()
+
+    float budgetMicros;
+    std::size_t capacity;
+    std::size_t obstacleCount;
+    int predictedTicks;
+
+    // Scratch copy of the obstacles, stepped forward tick by tick
+    std::vector<sf::Vector2f> positions;
+    std::vector<sf::Vector2f> velocities;
+    std::vector<float> radii;
+    std::vector<float> boxSizes;
+    std::vector<std::uint8_t> alive;
+    std::vector<std::uint32_t> contacts;               // Pairs packed as (i << 16) | j
+    std::vector<sf::Vector2f> predictedBoxes;          // Box corner per [tick * capacity + i]
+
+    Plan bestPlan;
+    float bestScore;
+    bool haveBest;
+    int phase;               // Ticks already spent in bestPlan's first step
+    std::mt19937 rng;
+    AutopilotStats stats;
+
+    void predict(const Archetype& obstacles, float tickSeconds, Clock::time_point deadline);
+    float evaluate(const Plan& plan, const PlayerModel& player, float tickSeconds) const;
+    void advanceBestPlan();
+    static sf::Vector2f actionDirection(std::uint8_t action);
+
+public:
+    explicit Autopilot(std::size_t obstacleCapacity, float budgetMicros = defaultBudgetMicros);
+
+    void setBudget(float micros) { budgetMicros = micros; }
+    float getBudget() const { return budgetMicros; }
+    void reset();  // Forget the carried-over plan, e.g. after the player respawns
+
+    // Keys to hold this tick. Returns within roughly the budget.
+    PlayerInput plan(const Archetype& obstacles, const PlayerModel& player, float tickSeconds);
+    const AutopilotStats& getStats() const { return stats; }
+};
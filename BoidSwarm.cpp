@@ -0,0 +1,266 @@
+#include "BoidSwarm.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace {
+
+const std::uint32_t outside = 0xFFFFFFFFu;
+const sf::Color boidColor(255, 170, 40);
+
+static_assert(BoidSwarm::columns * BoidSwarm::cellSize >= BoidSwarm::maxX - BoidSwarm::minX,
+              "Grid does not cover the tracked width");
+static_assert(BoidSwarm::rows * BoidSwarm::cellSize >= BoidSwarm::maxY - BoidSwarm::minY,
+              "Grid does not cover the tracked height");
+
+// Neighbour sums for one boid over runs of the grid-ordered columns
+struct NeighbourSums {
+    float count = 0.0f;
+    float offsetX = 0.0f;
+    float offsetY = 0.0f;
+    float velocityX = 0.0f;
+    float velocityY = 0.0f;
+    float awayX = 0.0f;
+    float awayY = 0.0f;
+
+    // Branch-free reductions, so the loop vectorizes (the file is built to
+    // allow reassociation). The boid itself counts as its own neighbour at
+    // offset zero, which only adds its own velocity.
+    void add(const float* xs, const float* ys, const float* vxs, const float* vys,
+             std::size_t begin, std::size_t end, float x, float y) {
+        const float near = BoidSwarm::neighbourRadius * BoidSwarm::neighbourRadius;
+        const float close = BoidSwarm::separationRadius * BoidSwarm::separationRadius;
+        float n = 0.0f, ox = 0.0f, oy = 0.0f, vx = 0.0f, vy = 0.0f, ax = 0.0f, ay = 0.0f;
+        for (std::size_t j = begin; j < end; ++j) {
+            float dx = xs[j] - x;
+            float dy = ys[j] - y;
+            float d2 = dx * dx + dy * dy;
+            float inRange = d2 < near ? 1.0f : 0.0f;
+            float push = (d2 < close ? 1.0f : 0.0f) / (d2 + 1.0f);
+            n += inRange;
+            ox += inRange * dx;
+            oy += inRange * dy;
+            vx += inRange * vxs[j];
+            vy += inRange * vys[j];
+            ax -= push * dx;
+            ay -= push * dy;
+        }
+        count += n;
+        offsetX += ox;
+        offsetY += oy;
+        velocityX += vx;
+        velocityY += vy;
+        awayX += ax;
+        awayY += ay;
+    }
+};
+
+} // namespace
+
+BoidSwarm::BoidSwarm(std::size_t capacity)
+    : maxBoids(capacity)
+    , count(0)
+    , xs(capacity), ys(capacity), vxs(capacity), vys(capacity)
+    , spareXs(capacity), spareYs(capacity), spareVxs(capacity), spareVys(capacity)
+    , cells(capacity), spareCells(capacity)
+    , cellStart(rows * columns + 1, 0)
+    , cursors(rows * columns)
+    , steerX(capacity), steerY(capacity)
+    , vertices(capacity * 3)
+    , randomState(0) {
+}
+
+void BoidSwarm::clear(std::uint64_t seed) {
+    count = 0;
+    std::fill(cellStart.begin(), cellStart.end(), 0);
+    randomState = seed;
+}
+
+float BoidSwarm::random(float low, float high) {
+    // splitmix64, as WaveDirector uses
+    std::uint64_t z = (randomState += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    return low + (high - low) * static_cast<float>(z >> 40) * (1.0f / 16777216.0f);
+}
+
+std::uint32_t BoidSwarm::release(sf::Vector2f center, std::uint32_t flockSize, float spread,
+                                 sf::Vector2f velocity) {
+    std::uint32_t fitting = static_cast<std::uint32_t>(std::min<std::size_t>(flockSize, maxBoids - count));
+    for (std::uint32_t i = 0; i < fitting; ++i) {
+        xs[count] = center.x + random(-spread, spread);
+        ys[count] = center.y + random(-spread, spread);
+        vxs[count] = velocity.x + random(-30.0f, 30.0f);
+        vys[count] = velocity.y + random(-30.0f, 30.0f);
+        count++;
+    }
+    stats.released += fitting;
+    stats.dropped += flockSize - fitting;
+    return fitting;
+}
+
+void BoidSwarm::update(float deltaTime, sf::Vector2f target, float flowSpeed) {
+    rebuildIndex();
+    steer();
+    integrate(deltaTime, target, flowSpeed);
+    stats.peakBoids = std::max(stats.peakBoids, static_cast<std::uint32_t>(count));
+}
+
+void BoidSwarm::rebuildIndex() {
+    // Counting sort into cell order; boids outside the region are dropped here
+    const float inverseCell = 1.0f / cellSize;
+    std::fill(cellStart.begin(), cellStart.end(), 0);
+    for (std::size_t i = 0; i < count; ++i) {
+        bool inside = xs[i] >= minX && xs[i] < maxX && ys[i] >= minY && ys[i] < maxY;
+        if (!inside) {
+            cells[i] = outside;
+            continue;
+        }
+        int column = std::min(columns - 1, static_cast<int>((xs[i] - minX) * inverseCell));
+        int row = std::min(rows - 1, static_cast<int>((ys[i] - minY) * inverseCell));
+        cells[i] = static_cast<std::uint32_t>(row * columns + column);
+        cellStart[cells[i] + 1]++;
+    }
+    for (std::size_t cell = 1; cell < cellStart.size(); ++cell) {
+        cellStart[cell] += cellStart[cell - 1];
+    }
+    
+    std::copy(cellStart.begin(), cellStart.end() - 1, cursors.begin());
+    for (std::size_t i = 0; i < count; ++i) {
+        if (cells[i] == outside) {
+            continue;
+        }
+        std::uint32_t slot = cursors[cells[i]]++;
+        spareXs[slot] = xs[i];
+        spareYs[slot] = ys[i];
+        spareVxs[slot] = vxs[i];
+        spareVys[slot] = vys[i];
+        spareCells[slot] = cells[i];
+    }
+    count = cellStart.back();
+    std::swap(xs, spareXs);
+    std::swap(ys, spareYs);
+    std::swap(vxs, spareVxs);
+    std::swap(vys, spareVys);
+    std::swap(cells, spareCells);
+}
+
+void BoidSwarm::steer() {
+    const float* x = xs.data();
+    const float* y = ys.data();
+    const float* vx = vxs.data();
+    const float* vy = vys.data();
+    std::uint64_t checks = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        // The three cells of each neighbouring row are one run of the columns
+        int column = static_cast<int>(cells[i] % columns);
+        int row = static_cast<int>(cells[i] / columns);
+        int firstColumn = std::max(0, column - 1);
+        int lastColumn = std::min(columns - 1, column + 1);
+        NeighbourSums sums;
+        for (int r = std::max(0, row - 1); r <= std::min(rows - 1, row + 1); ++r) {
+            std::size_t begin = cellStart[r * columns + firstColumn];
+            std::size_t end = cellStart[r * columns + lastColumn + 1];
+            sums.add(x, y, vx, vy, begin, end, x[i], y[i]);
+            checks += end - begin;
+        }
+        
+        float inverseCount = 1.0f / sums.count;   // At least the boid itself
+        steerX[i] = cohesionWeight * sums.offsetX * inverseCount +
+                    alignmentWeight * (sums.velocityX * inverseCount - vx[i]) + separationWeight * sums.awayX;
+        steerY[i] = cohesionWeight * sums.offsetY * inverseCount +
+                    alignmentWeight * (sums.velocityY * inverseCount - vy[i]) + separationWeight * sums.awayY;
+    }
+    stats.neighbourChecks = checks;
+}
+
+void BoidSwarm::integrate(float deltaTime, sf::Vector2f target, float flowSpeed) {
+    // Straight column loops with no branches; they vectorize like integrateFixed
+    const float maxSpeed = flowSpeed + extraSpeed;
+    const float targetX = target.x;
+    const float targetY = target.y;
+    const std::size_t boids = count;
+    float* x = xs.data();
+    float* y = ys.data();
+    float* vx = vxs.data();
+    float* vy = vys.data();
+    const float* ax = steerX.data();
+    const float* ay = steerY.data();
+    for (std::size_t i = 0; i < boids; ++i) {
+        // Lean towards the target, mostly sideways so flocks still pass by
+        float tx = targetX - x[i];
+        float ty = targetY - y[i];
+        float lean = seekWeight / (std::sqrt(tx * tx + ty * ty) + 1.0f);
+        float newVx = vx[i] + (ax[i] + lean * tx) * deltaTime;
+        float newVy = vy[i] + (ay[i] + 0.25f * lean * ty + flowWeight * (flowSpeed - vy[i])) * deltaTime;
+        float speed = std::sqrt(newVx * newVx + newVy * newVy);
+        float scale = std::min(1.0f, maxSpeed / (speed + 0.001f));
+        vx[i] = newVx * scale;
+        vy[i] = newVy * scale;
+    }
+    // Separate pass: fewer columns per loop keeps the runtime alias checks cheap
+    for (std::size_t i = 0; i < boids; ++i) {
+        x[i] += vx[i] * deltaTime;
+        y[i] += vy[i] * deltaTime;
+    }
+}
+
+int BoidSwarm::findContact(const sf::FloatRect& box) const {
+    // Boids have moved up to one cell since the grid was built, so widen the search by one
+    const float margin = boidRadius + cellSize;
+    int firstColumn = std::max(0, static_cast<int>((box.left - margin - minX) / cellSize));
+    int lastColumn = std::min(columns - 1, static_cast<int>((box.left + box.width + margin - minX) / cellSize));
+    int firstRow = std::max(0, static_cast<int>((box.top - margin - minY) / cellSize));
+    int lastRow = std::min(rows - 1, static_cast<int>((box.top + box.height + margin - minY) / cellSize));
+    if (firstColumn > lastColumn || firstRow > lastRow || count == 0) {
+        return -1;
+    }
+    
+    float left = box.left - boidRadius;
+    float right = box.left + box.width + boidRadius;
+    float top = box.top - boidRadius;
+    float bottom = box.top + box.height + boidRadius;
+    for (int r = firstRow; r <= lastRow; ++r) {
+        std::size_t end = cellStart[r * columns + lastColumn + 1];
+        for (std::size_t j = cellStart[r * columns + firstColumn]; j < end; ++j) {
+            if (xs[j] >= left && xs[j] <= right && ys[j] >= top && ys[j] <= bottom) {
+                return static_cast<int>(j);
+            }
+        }
+    }
+    return -1;
+}
+
+int BoidSwarm::scatter(sf::Vector2f center, float radius) {
+    int scattered = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        float dx = xs[i] - center.x;
+        float dy = ys[i] - center.y;
+        if (dx * dx + dy * dy < radius * radius) {
+            ys[i] = maxY + 1.0f;
+            scattered++;
+        }
+    }
+    return scattered;
+}
+
+void BoidSwarm::draw(Renderer& renderer) {
+    // A small triangle per boid, pointing along its velocity
+    std::size_t used = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (ys[i] < -8.0f || ys[i] > 861.0f) {
+            continue;
+        }
+        float speed = std::sqrt(vxs[i] * vxs[i] + vys[i] * vys[i]) + 0.001f;
+        sf::Vector2f direction(vxs[i] / speed, vys[i] / speed);
+        sf::Vector2f side(-direction.y * 2.5f, direction.x * 2.5f);
+        sf::Vector2f position(xs[i], ys[i]);
+        vertices[used++] = sf::Vertex(position + direction * 5.0f, boidColor);
+        vertices[used++] = sf::Vertex(position - direction * 3.0f + side, boidColor);
+        vertices[used++] = sf::Vertex(position - direction * 3.0f - side, boidColor);
+    }
+    if (used > 0) {
+        renderer.draw(vertices.data(), used, sf::Triangles);
+    }
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "Renderer.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct SwarmStats {
+    std::uint64_t released = 0;
+    std::uint64_t dropped = 0;            // release() past capacity
+    std::uint64_t neighbourChecks = 0;    // Candidate pairs looked at on the latest tick
+    std::uint32_t peakBoids = 0;
+};
+
+// Flocking swarms as an obstacle type: hundreds to thousands of small boids
+// steering by separation, alignment and cohesion, drifting down the field and
+// leaning towards the player.
+// Boids live in column arrays. Each update() counting-sorts them into a
+// uniform grid of neighbour-radius cells, so the 3x3 cells around a boid are
+// three contiguous runs of the arrays. The steering loop walks those runs as
+// branch-free reductions that the compiler turns into SIMD. Building the grid
+// costs O(n), and the neighbour work depends on density rather than on n².
+// Boids leaving the tracked region are dropped while sorting. Nothing
+// allocates after construction.
+class BoidSwarm {
+public:
+    static constexpr float neighbourRadius = 24.0f;
+    static constexpr float separationRadius = 9.0f;
+    static constexpr float boidRadius = 3.0f;
+    static constexpr float cellSize = neighbourRadius;
+
+    // Steering gains, in px/s² per unit of each rule's offset
+    static constexpr float cohesionWeight = 1.5f;      // Towards the neighbours' centre
+    static constexpr float alignmentWeight = 2.5f;     // Towards their mean velocity
+    static constexpr float separationWeight = 2400.0f; // Away from very close boids, ~1/distance
+    static constexpr float seekWeight = 260.0f;        // Towards the target, horizontal
+    static constexpr float flowWeight = 2.0f;          // Back towards the flow speed
+    static constexpr float extraSpeed = 160.0f;        // Speed cap above the flow
+    static constexpr float flowRatio = 0.6f;           // Flow speed as a fraction of the game speed
+
+    // Tracked region; a little wider than the field and tall enough for
+    // flocks released above the screen
+    static constexpr float minX = -48.0f;
+    static constexpr float maxX = 528.0f;
+    static constexpr float minY = -288.0f;
+    static constexpr float maxY = 888.0f;
+    static constexpr int columns = 24;     // (maxX - minX) / cellSize
+    static constexpr int rows = 49;        // (maxY - minY) / cellSize
+    static constexpr std::size_t defaultCapacity = 4096;
+
+private:
+    std::size_t maxBoids;
+    std::size_t count;
+
+    // Columns in grid order after update(); the spare set is the sort target
+    std::vector<float> xs, ys, vxs, vys;
+    std::vector<float> spareXs, spareYs, spareVxs, spareVys;
+    std::vector<std::uint32_t> cells, spareCells;   // Grid cell per boid
+    std::vector<std::uint32_t> cellStart;    // First boid per cell, plus the end
+    std::vector<std::uint32_t> cursors;      // Sort scratch
+    std::vector<float> steerX, steerY;       // Flocking acceleration per boid
+    std::vector<sf::Vertex> vertices;
+
+    std::uint64_t randomState;
+    SwarmStats stats;
+
+    float random(float low, float high);
+    void rebuildIndex();
+    void steer();
+    void integrate(float deltaTime, sf::Vector2f target, float flowSpeed);
+
+public:
+    explicit BoidSwarm(std::size_t capacity = defaultCapacity);
+
+    void clear(std::uint64_t seed);
+
+    // Adds a flock of `count` boids scattered around `center`; they join the
+    // grid on the next update(). Returns how many fit.
+    std::uint32_t release(sf::Vector2f center, std::uint32_t count, float spread, sf::Vector2f velocity);
+
+    // One tick. Flocks drift down at about flowSpeed and lean towards target.
+    void update(float deltaTime, sf::Vector2f target, float flowSpeed);
+
+    // Index of a boid touching the box, or -1. Only valid after update().
+    int findContact(const sf::FloatRect& box) const;
+    // Moves boids within `radius` out of the region; they are dropped next update()
+    int scatter(sf::Vector2f center, float radius);
+
+    // Every boid on screen as one triangle batch
+    void draw(Renderer& renderer);
+
+    std::size_t size() const { return count; }
+    std::size_t capacity() const { return maxBoids; }
+    const SwarmStats& getStats() const { return stats; }
+
+    // Column access for tools and benchmarks (grid order)
+    const float* positionsX() const { return xs.data(); }
+    const float* positionsY() const { return ys.data(); }
+    const float* velocitiesX() const { return vxs.data(); }
+    const float* velocitiesY() const { return vys.data(); }
+    const float* steeringX() const { return steerX.data(); }
+    const float* steeringY() const { return steerY.data(); }
+};
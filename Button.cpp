@@ -1,8 +1,44 @@
 #include "Button.h"
 
-Button::Button(sf::Font& font, const std::string& label, float x, float y, float width, float height)
-    : font(font)
-    , label(label)
+sf::Vector2f textSize(const sf::Text& text) {
+    if (text.getFont()) {
+        sf::FloatRect bounds = text.getLocalBounds();
+        return sf::Vector2f(bounds.width, bounds.height);
+    }
+    float size = static_cast<float>(text.getCharacterSize());
+    return sf::Vector2f(text.getString().getSize() * size * 0.5f, size * 0.7f);
+}
+
+void drawText(Renderer& renderer, const sf::Text& text, sf::RectangleShape& placeholderBrush) {
+    if (text.getFont()) {
+        renderer.draw(text);
+        return;
+    }
+    
+    // Roughly where the glyphs will land: half the size per character, one bar per line
+    const sf::String& string = text.getString();
+    float size = static_cast<float>(text.getCharacterSize());
+    sf::Color color = text.getFillColor();
+    color.a = static_cast<sf::Uint8>(color.a / 4);
+    placeholderBrush.setFillColor(color);
+    std::size_t lineStart = 0;
+    float y = text.getPosition().y + size * 0.3f;
+    for (std::size_t i = 0; i <= string.getSize(); ++i) {
+        if (i < string.getSize() && string[i] != '\n') {
+            continue;
+        }
+        if (i > lineStart) {
+            placeholderBrush.setSize(sf::Vector2f(static_cast<float>(i - lineStart) * size * 0.5f, size * 0.5f));
+            placeholderBrush.setPosition(text.getPosition().x, y);
+            renderer.draw(placeholderBrush);
+        }
+        lineStart = i + 1;
+        y += size * 1.2f;
+    }
+}
+
+Button::Button(const std::string& label, float x, float y, float width, float height)
+    : label(label)
     , isHovered(false)
     , isPressed(false)
     , normalColor(sf::Color(70, 70, 70, 200))
@@ -17,25 +53,32 @@ Button::Button(sf::Font& font, const std::string& label, float x, float y, float
     shape.setOutlineThickness(2.0f);
     
     // Setup text
-    text.setFont(font);
     text.setString(label);
     text.setCharacterSize(20);
     text.setFillColor(sf::Color::White);
-    
-    // Center text on button
-    sf::FloatRect textBounds = text.getLocalBounds();
+    centerText();
+}
+
+void Button::centerText() {
+    sf::Vector2f size = textSize(text);
     text.setPosition(
-        x + (width - textBounds.width) / 2.0f,
-        y + (height - textBounds.height) / 2.0f - 5.0f  // Slight offset for visual centering
+        shape.getPosition().x + (shape.getSize().x - size.x) / 2.0f,
+        shape.getPosition().y + (shape.getSize().y - size.y) / 2.0f - 5.0f  // Slight offset for visual centering
     );
 }
 
+void Button::setFont(const sf::Font& font) {
+    text.setFont(font);
+    centerText();
+}
+
 void Button::setOnClick(std::function<void()> callback) {
     onClick = callback;
 }
 
-void Button::update(const sf::Vector2f& mousePos, bool mousePressed) {
+bool Button::update(const sf::Vector2f& mousePos, bool mousePressed) {
     bool wasHovered = isHovered;
+    bool wasPressed = isPressed;
     isHovered = isMouseOver(mousePos);
     
     // Handle press state
@@ -56,11 +99,13 @@ void Button::update(const sf::Vector2f& mousePos, bool mousePressed) {
     } else {
         shape.setFillColor(normalColor);
     }
+    
+    return isHovered != wasHovered || isPressed != wasPressed;
 }
 
-void Button::draw(sf::RenderWindow& window) {
-    window.draw(shape);
-    window.draw(text);
+void Button::draw(Renderer& renderer) {
+    renderer.draw(shape);
+    drawText(renderer, text, placeholder);
 }
 
 bool Button::isMouseOver(const sf::Vector2f& mousePos) const {
@@ -69,24 +114,12 @@ bool Button::isMouseOver(const sf::Vector2f& mousePos) const {
 
 void Button::setPosition(float x, float y) {
     shape.setPosition(x, y);
-    
-    // Update text position
-    sf::FloatRect textBounds = text.getLocalBounds();
-    text.setPosition(
-        x + (shape.getSize().x - textBounds.width) / 2.0f,
-        y + (shape.getSize().y - textBounds.height) / 2.0f - 5.0f
-    );
+    centerText();
 }
 
 void Button::setSize(float width, float height) {
     shape.setSize(sf::Vector2f(width, height));
-    
-    // Update text position
-    sf::FloatRect textBounds = text.getLocalBounds();
-    text.setPosition(
-        shape.getPosition().x + (width - textBounds.width) / 2.0f,
-        shape.getPosition().y + (height - textBounds.height) / 2.0f - 5.0f
-    );
+    centerText();
 }
 
 void Button::setColors(const sf::Color& normal, const sf::Color& hover, const sf::Color& pressed) {
@@ -106,11 +139,5 @@ void Button::setColors(const sf::Color& normal, const sf::Color& hover, const sf
 
 void Button::setTextSize(unsigned int size) {
     text.setCharacterSize(size);
-    
-    // Re-center text
-    sf::FloatRect textBounds = text.getLocalBounds();
-    text.setPosition(
-        shape.getPosition().x + (shape.getSize().x - textBounds.width) / 2.0f,
-        shape.getPosition().y + (shape.getSize().y - textBounds.height) / 2.0f - 5.0f
-    );
+    centerText();
 } 
\ No newline at end of file
@@ -1,13 +1,21 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include "Renderer.h"
 #include <string>
 #include <functional>
 
+// Size of the text, or of its placeholder while it has no font
+sf::Vector2f textSize(const sf::Text& text);
+
+// Draws the text, or while it has no font yet a dim bar per line where the
+// glyphs will go. The brush is shared scratch, like drawCircles' brush.
+void drawText(Renderer& renderer, const sf::Text& text, sf::RectangleShape& placeholderBrush);
+
 class Button {
 private:
     sf::RectangleShape shape;
     sf::Text text;
-    sf::Font& font;
+    sf::RectangleShape placeholder;
     std::string label;
     std::function<void()> onClick;
     
@@ -18,12 +26,15 @@ private:
     sf::Color hoverColor;
     sf::Color pressedColor;
     
+    void centerText();
+    
 public:
-    Button(sf::Font& font, const std::string& label, float x, float y, float width, float height);
+    // The label shows as a placeholder until setFont()
+    Button(const std::string& label, float x, float y, float width, float height);
     
     void setOnClick(std::function<void()> callback);
-    void update(const sf::Vector2f& mousePos, bool mousePressed);
-    void draw(sf::RenderWindow& window);
+    bool update(const sf::Vector2f& mousePos, bool mousePressed);  // True if the look changed
+    void draw(Renderer& renderer);
     
     // Getters
     sf::FloatRect getBounds() const { return shape.getGlobalBounds(); }
@@ -34,4 +45,5 @@ public:
     void setSize(float width, float height);
     void setColors(const sf::Color& normal, const sf::Color& hover, const sf::Color& pressed);
     void setTextSize(unsigned int size);
+    void setFont(const sf::Font& font);
 }; 
\ No newline at end of file
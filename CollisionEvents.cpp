@@ -0,0 +1,70 @@
+#include "CollisionEvents.h"
+#include <utility>
+
+CollisionEventQueue::CollisionEventQueue(std::size_t capacity, float coalesceWindow)
+    : effectWindow(coalesceWindow) {
+    events.reserve(capacity);
+    for (auto& effect : recentEffects) {
+        effect.expiresAt = -1.0f;
+    }
+}
+
+void CollisionEventQueue::push(CollisionEventType type, EntityId a, EntityId b) {
+    events.push_back(CollisionEvent{type, a, b});
+
+    switch (type) {
+        case CollisionEventType::PairContact:
+            stats.contacts++;
+            break;
+        case CollisionEventType::PlayerHit:
+        case CollisionEventType::SwarmHit:
+            stats.playerHits++;
+            break;
+        case CollisionEventType::Dodge:
+            stats.dodges++;
+            break;
+    }
+}
+
+void CollisionEventQueue::clear() {
+    events.clear();
+    totals.pairsTested += static_cast<std::uint64_t>(stats.pairsTested);
+    totals.contacts += static_cast<std::uint64_t>(stats.contacts);
+    totals.playerHits += static_cast<std::uint64_t>(stats.playerHits);
+    totals.dodges += static_cast<std::uint64_t>(stats.dodges);
+    totals.effectsEmitted += static_cast<std::uint64_t>(stats.effectsEmitted);
+    totals.effectsMerged += static_cast<std::uint64_t>(stats.effectsMerged);
+    stats = CollisionStats{};
+}
+
+void CollisionEventQueue::reset() {
+    clear();
+    for (auto& effect : recentEffects) {
+        effect.expiresAt = -1.0f;
+    }
+}
+
+bool CollisionEventQueue::claimPairEffect(EntityId a, EntityId b, float now) {
+    // Order-independent pair identity
+    if (b.slot < a.slot) {
+        std::swap(a, b);
+    }
+
+    // Expired entries always have the smallest expiry, so the minimum is
+    // either a free entry or the live one closest to expiring
+    RecentEffect* replace = &recentEffects[0];
+    for (auto& effect : recentEffects) {
+        if (effect.expiresAt > now && effect.a == a && effect.b == b) {
+            stats.effectsMerged++;
+            return false;
+        }
+        if (effect.expiresAt < replace->expiresAt) {
+            replace = &effect;
+        }
+    }
+
+    replace->a = a;
+    replace->b = b;
+    replace->expiresAt = now + effectWindow;
+    return true;
+}
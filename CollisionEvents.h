@@ -0,0 +1,80 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "EntityStore.h"
+
+// What the detection passes found this tick
+enum class CollisionEventType {
+    PairContact,  // Two obstacles overlap (a, b)
+    PlayerHit,    // The player touched obstacle a
+    SwarmHit,     // The player touched a boid (no entity)
+    Dodge         // Obstacle a left the bottom of the screen
+};
+
+struct CollisionEvent {
+    CollisionEventType type;
+    EntityId a;
+    EntityId b;
+};
+
+// Counters for the current tick, reset by CollisionEventQueue::clear()
+struct CollisionStats {
+    int pairsTested = 0;
+    int contacts = 0;
+    int playerHits = 0;
+    int dodges = 0;
+    int effectsEmitted = 0;
+    int effectsMerged = 0;  // Pair effects suppressed by the coalescing window
+};
+
+// The same counters summed over every finished tick; 64-bit so long
+// sessions cannot overflow them
+struct CollisionTotals {
+    std::uint64_t pairsTested = 0;
+    std::uint64_t contacts = 0;
+    std::uint64_t playerHits = 0;
+    std::uint64_t dodges = 0;
+    std::uint64_t effectsEmitted = 0;
+    std::uint64_t effectsMerged = 0;
+};
+
+// Collision detection writes events here; Game processes the whole batch
+// after detection has finished, so detection never mutates game state.
+// Also remembers recently emitted pair effects so a pair that stays in
+// contact produces one explosion per window instead of one per frame.
+class CollisionEventQueue {
+private:
+    struct RecentEffect {
+        EntityId a;
+        EntityId b;
+        float expiresAt;
+    };
+
+    static constexpr std::size_t maxRecentEffects = 64;
+
+    std::vector<CollisionEvent> events;
+    RecentEffect recentEffects[maxRecentEffects];
+    float effectWindow;
+    CollisionStats stats;
+    CollisionTotals totals;    // Every finished tick since construction
+
+public:
+    explicit CollisionEventQueue(std::size_t capacity = 512, float coalesceWindow = 0.25f);
+
+    void push(CollisionEventType type, EntityId a, EntityId b = EntityId{});
+    void clear();   // Start a new tick: drops events and resets the counters
+    void reset();   // clear() and forget recent effects (new game)
+
+    // True if a pair effect should be emitted now; false if merged into a recent one
+    bool claimPairEffect(EntityId a, EntityId b, float now);
+    void countEffect() { stats.effectsEmitted++; }
+    void countPairsTested(int count) { stats.pairsTested += count; }
+
+    const std::vector<CollisionEvent>& getEvents() const { return events; }
+    const CollisionStats& getStats() const { return stats; }
+    const CollisionTotals& getTotals() const { return totals; }  // Up to the previous clear()
+    float getCoalesceWindow() const { return effectWindow; }
+    void setCoalesceWindow(float seconds) { effectWindow = seconds; }
+};
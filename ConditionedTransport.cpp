@@ -0,0 +1,49 @@
+#include "ConditionedTransport.h"
+#include <chrono>
+
+ConditionedTransport::ConditionedTransport(std::unique_ptr<VersusTransport> inner, const LinkConditions& conditions)
+    : inner(std::move(inner))
+    , conditions(conditions)
+    , gen(conditions.seed)
+    , heldCount(0)
+    , manualClock(false)
+    , manualNow(0.0)
+    , dropped(0) {
+}
+
+double ConditionedTransport::now() const {
+    if (manualClock) {
+        return manualNow;
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool ConditionedTransport::receive(InputPacket& packet) {
+    double current = now();
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    // Take everything that has arrived and decide its fate now
+    InputPacket incoming;
+    while (inner->receive(incoming)) {
+        if (unit(gen) < conditions.lossRate || heldCount == held.size()) {
+            dropped++;
+            continue;
+        }
+        double delay = (conditions.latencyMs + conditions.jitterMs * unit(gen)) * 0.001;
+        held[heldCount++] = Held{current + delay, incoming};
+    }
+
+    // Deliver the earliest packet that is due
+    std::size_t earliest = heldCount;
+    for (std::size_t i = 0; i < heldCount; ++i) {
+        if (held[i].deliverAt <= current && (earliest == heldCount || held[i].deliverAt < held[earliest].deliverAt)) {
+            earliest = i;
+        }
+    }
+    if (earliest == heldCount) {
+        return false;
+    }
+    packet = held[earliest].packet;
+    held[earliest] = held[--heldCount];
+    return true;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include "VersusTransport.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <random>
+
+struct LinkConditions {
+    float latencyMs = 0.0f;     // One way
+    float jitterMs = 0.0f;      // Uniform extra delay on top; reorders packets
+    float lossRate = 0.0f;      // 0..1
+    std::uint32_t seed = 1;
+};
+
+// Wraps a transport and degrades what it receives: drops packets at the loss
+// rate and holds the rest until latency + jitter has passed. Delays follow
+// the steady clock unless a manual clock is used, so headless checks can run
+// faster than real time.
+class ConditionedTransport : public VersusTransport {
+private:
+    struct Held {
+        double deliverAt;
+        InputPacket packet;
+    };
+
+    std::unique_ptr<VersusTransport> inner;
+    LinkConditions conditions;
+    std::mt19937 gen;
+    std::array<Held, 64> held;
+    std::size_t heldCount;
+    bool manualClock;
+    double manualNow;
+    std::uint64_t dropped;
+
+    double now() const;
+
+public:
+    ConditionedTransport(std::unique_ptr<VersusTransport> inner, const LinkConditions& conditions);
+
+    void useManualClock() { manualClock = true; }
+    void advanceClock(double seconds) { manualNow += seconds; }
+    std::uint64_t getDropped() const { return dropped; }
+
+    bool send(const InputPacket& packet) override { return inner->send(packet); }
+    bool receive(InputPacket& packet) override;
+};
@@ -0,0 +1,165 @@
+#include "EntityStore.h"
+#include <utility>
+
+Archetype::Archetype(EntityKind kind, std::uint32_t mask)
+    : archetypeKind(kind)
+    , componentMask(mask)
+    , maxEntities(0) {
+}
+
+void Archetype::reserve(std::size_t count) {
+    entities.reserve(count);
+    if (has(Component::Transform)) transforms.reserve(count);
+    if (has(Component::Velocity)) velocities.reserve(count);
+    if (has(Component::Lifetime)) lifetimes.reserve(count);
+    if (has(Component::Collider)) colliders.reserve(count);
+    if (has(Component::Render)) styles.reserve(count);
+}
+
+void Archetype::setCapacity(std::size_t count) {
+    maxEntities = count;
+    reserve(count);
+}
+
+std::size_t Archetype::memoryBytes() const {
+    return entities.capacity() * sizeof(EntityId) +
+           transforms.capacity() * sizeof(Transform) +
+           velocities.capacity() * sizeof(Velocity) +
+           lifetimes.capacity() * sizeof(Lifetime) +
+           colliders.capacity() * sizeof(Collider) +
+           styles.capacity() * sizeof(RenderStyle);
+}
+
+std::size_t Archetype::pushRow(EntityId id) {
+    entities.push_back(id);
+    if (has(Component::Transform)) transforms.emplace_back();
+    if (has(Component::Velocity)) velocities.emplace_back();
+    if (has(Component::Lifetime)) lifetimes.emplace_back();
+    if (has(Component::Collider)) colliders.emplace_back();
+    if (has(Component::Render)) styles.emplace_back();
+    return entities.size() - 1;
+}
+
+namespace {
+
+template <typename T>
+void swapRemoveColumn(std::vector<T>& column, std::size_t row) {
+    if (column.empty()) {
+        return;
+    }
+    if (row != column.size() - 1) {
+        column[row] = std::move(column.back());
+    }
+    column.pop_back();
+}
+
+} // namespace
+
+void Archetype::swapRemove(std::size_t row) {
+    swapRemoveColumn(entities, row);
+    swapRemoveColumn(transforms, row);
+    swapRemoveColumn(velocities, row);
+    swapRemoveColumn(lifetimes, row);
+    swapRemoveColumn(colliders, row);
+    swapRemoveColumn(styles, row);
+}
+
+void Archetype::clear() {
+    entities.clear();
+    transforms.clear();
+    velocities.clear();
+    lifetimes.clear();
+    colliders.clear();
+    styles.clear();
+}
+
+EntityStore::EntityStore() {
+    namespace C = Component;
+    archetypes.reserve(static_cast<std::size_t>(EntityKind::Count));
+    archetypes.emplace_back(EntityKind::Obstacle, C::Transform | C::Velocity | C::Collider | C::Render);
+    archetypes.emplace_back(EntityKind::Explosion, C::Transform | C::Velocity | C::Lifetime | C::Render);
+    archetypes.emplace_back(EntityKind::Background, C::Transform | C::Render);
+}
+
+void EntityStore::reserve(EntityKind kind, std::size_t count) {
+    archetype(kind).reserve(count);
+    reserveSlots();
+}
+
+void EntityStore::setCapacity(EntityKind kind, std::size_t count) {
+    archetype(kind).setCapacity(count);
+    reserveSlots();
+}
+
+void EntityStore::reserveSlots() {
+    // Every live entity needs a slot, and every slot can end up on the free list
+    std::size_t total = 0;
+    for (const Archetype& entry : archetypes) {
+        total += entry.entities.capacity();
+    }
+    slots.reserve(total);
+    freeSlots.reserve(total);
+}
+
+EntityId EntityStore::create(EntityKind kind) {
+    Archetype& target = archetype(kind);
+    if (target.full()) {
+        return EntityId{};
+    }
+
+    std::uint32_t slotIndex;
+    if (!freeSlots.empty()) {
+        slotIndex = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        slotIndex = static_cast<std::uint32_t>(slots.size());
+        slots.push_back(Slot{0, 0, kind, false});
+    }
+
+    Slot& slot = slots[slotIndex];
+    EntityId id{slotIndex, slot.generation};
+    slot.kind = kind;
+    slot.alive = true;
+    slot.row = static_cast<std::uint32_t>(target.pushRow(id));
+    return id;
+}
+
+bool EntityStore::destroy(EntityId id) {
+    if (!isAlive(id)) {
+        return false;
+    }
+    destroyAt(slots[id.slot].kind, slots[id.slot].row);
+    return true;
+}
+
+void EntityStore::destroyAt(EntityKind kind, std::size_t row) {
+    Archetype& target = archetype(kind);
+    std::uint32_t removedSlot = target.entities[row].slot;
+
+    target.swapRemove(row);
+    if (row < target.size()) {
+        slots[target.entities[row].slot].row = static_cast<std::uint32_t>(row);
+    }
+
+    Slot& slot = slots[removedSlot];
+    slot.alive = false;
+    slot.generation++;
+    freeSlots.push_back(removedSlot);
+}
+
+void EntityStore::clear(EntityKind kind) {
+    Archetype& target = archetype(kind);
+    for (const EntityId& id : target.entities) {
+        Slot& slot = slots[id.slot];
+        slot.alive = false;
+        slot.generation++;
+        freeSlots.push_back(id.slot);
+    }
+    target.clear();
+}
+
+void EntityStore::clear() {
+    for (std::size_t kind = 0; kind < archetypes.size(); ++kind) {
+        clear(static_cast<EntityKind>(kind));
+    }
+}
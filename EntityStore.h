@@ -0,0 +1,155 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Components. Plain data only; systems read and write these columns and
+// never touch SFML drawables.
+struct Transform {
+    sf::Vector2f position;   // Top-left of the circle's box, as sf::CircleShape uses
+    float rotation = 0.0f;
+};
+
+struct Velocity {
+    sf::Vector2f linear;
+};
+
+struct Lifetime {
+    float expiresAt = 0.0f;  // Simulation time
+    float duration = 0.0f;
+};
+
+struct Collider {
+    float radius = 0.0f;
+};
+
+struct RenderStyle {
+    sf::Color fill;
+    sf::Color outline;
+    float radius = 0.0f;
+    float outlineThickness = 0.0f;
+};
+
+namespace Component {
+    enum : std::uint32_t {
+        Transform = 1u << 0,
+        Velocity = 1u << 1,
+        Lifetime = 1u << 2,
+        Collider = 1u << 3,
+        Render = 1u << 4
+    };
+}
+
+// Each kind has a fixed component set and therefore its own archetype
+enum class EntityKind : std::uint8_t {
+    Obstacle,
+    Explosion,
+    Background,
+    Count
+};
+
+// Stable reference to an entity; the generation changes when its slot is reused
+struct EntityId {
+    std::uint32_t slot = 0xFFFFFFFFu;
+    std::uint32_t generation = 0;
+
+    bool isValid() const { return slot != 0xFFFFFFFFu; }
+    bool operator==(const EntityId& other) const {
+        return slot == other.slot && generation == other.generation;
+    }
+    bool operator!=(const EntityId& other) const { return !(*this == other); }
+};
+
+// Entities sharing a component set, stored as parallel column arrays.
+// Columns the archetype does not have stay empty.
+class Archetype {
+private:
+    EntityKind archetypeKind;
+    std::uint32_t componentMask;
+    std::size_t maxEntities;   // 0 = grow on demand
+
+public:
+    std::vector<EntityId> entities;
+    std::vector<Transform> transforms;
+    std::vector<Velocity> velocities;
+    std::vector<Lifetime> lifetimes;
+    std::vector<Collider> colliders;
+    std::vector<RenderStyle> styles;
+
+    Archetype(EntityKind kind, std::uint32_t mask);
+
+    void reserve(std::size_t count);
+    void setCapacity(std::size_t count);  // Fixed capacity, reserved up front
+    std::size_t pushRow(EntityId id);
+    void swapRemove(std::size_t row);     // Last row moves into `row`
+    void clear();
+
+    EntityKind kind() const { return archetypeKind; }
+    std::uint32_t mask() const { return componentMask; }
+    bool has(std::uint32_t components) const { return (componentMask & components) == components; }
+    std::size_t size() const { return entities.size(); }
+    bool full() const { return maxEntities != 0 && entities.size() >= maxEntities; }
+    std::size_t capacity() const { return maxEntities; }
+    std::size_t memoryBytes() const;      // Bytes reserved by the columns
+};
+
+// Archetype-based entity storage.
+// Entity ids resolve through a slot table to (archetype, row); create and
+// destroy are O(1) and rows stay densely packed for the systems.
+class EntityStore {
+private:
+    struct Slot {
+        std::uint32_t generation;
+        std::uint32_t row;
+        EntityKind kind;
+        bool alive;
+    };
+
+    std::vector<Archetype> archetypes;
+    std::vector<Slot> slots;
+    std::vector<std::uint32_t> freeSlots;
+
+    void reserveSlots();
+
+public:
+    EntityStore();
+
+    // Reserve rows (and slot table entries) up front so steady-state play
+    // never grows a column. setCapacity also caps the kind at `count`.
+    void reserve(EntityKind kind, std::size_t count);
+    void setCapacity(EntityKind kind, std::size_t count);
+
+    // Returns an invalid id when the kind is at capacity
+    EntityId create(EntityKind kind);
+    bool destroy(EntityId id);
+    void destroyAt(EntityKind kind, std::size_t row);
+    void clear(EntityKind kind);
+    void clear();
+
+    // Inline: behaviour batches resolve every member through these each tick
+    bool isAlive(EntityId id) const {
+        return id.slot < slots.size() && slots[id.slot].alive && slots[id.slot].generation == id.generation;
+    }
+    bool locate(EntityId id, std::size_t& row) const {  // Row within the entity's archetype
+        if (!isAlive(id)) {
+            return false;
+        }
+        row = slots[id.slot].row;
+        return true;
+    }
+
+    Archetype& archetype(EntityKind kind) { return archetypes[static_cast<std::size_t>(kind)]; }
+    const Archetype& archetype(EntityKind kind) const { return archetypes[static_cast<std::size_t>(kind)]; }
+    std::size_t count(EntityKind kind) const { return archetype(kind).size(); }
+
+    // Visit every archetype that has all of `components`
+    template <typename Function>
+    void forEach(std::uint32_t components, Function function) {
+        for (auto& entry : archetypes) {
+            if (entry.has(components) && entry.size() > 0) {
+                function(entry);
+            }
+        }
+    }
+};
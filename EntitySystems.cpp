@@ -0,0 +1,43 @@
+#include "EntitySystems.h"
+#include <algorithm>
+
+void integrateVelocities(EntityStore& store, float deltaTime) {
+    store.forEach(Component::Transform | Component::Velocity, [deltaTime](Archetype& archetype) {
+        Transform* transforms = archetype.transforms.data();
+        const Velocity* velocities = archetype.velocities.data();
+        std::size_t count = archetype.size();
+        for (std::size_t i = 0; i < count; ++i) {
+            transforms[i].position += velocities[i].linear * deltaTime;
+        }
+    });
+}
+
+void expireLifetimes(EntityStore& store, float now) {
+    store.forEach(Component::Lifetime | Component::Render, [&store, now](Archetype& archetype) {
+        // Walk backwards so swap-and-pop never skips a row
+        for (std::size_t i = archetype.size(); i > 0; --i) {
+            const Lifetime& lifetime = archetype.lifetimes[i - 1];
+            if (now >= lifetime.expiresAt) {
+                store.destroyAt(archetype.kind(), i - 1);
+                continue;
+            }
+            
+            // Fade out
+            float remaining = (lifetime.expiresAt - now) / lifetime.duration;
+            archetype.styles[i - 1].fill.a = static_cast<sf::Uint8>(std::max(0.0f, remaining) * 255);
+        }
+    });
+}
+
+void drawCircles(const Archetype& archetype, Renderer& renderer, sf::CircleShape& brush) {
+    std::size_t count = archetype.size();
+    for (std::size_t i = 0; i < count; ++i) {
+        const RenderStyle& style = archetype.styles[i];
+        brush.setRadius(style.radius);
+        brush.setPosition(archetype.transforms[i].position);
+        brush.setFillColor(style.fill);
+        brush.setOutlineColor(style.outline);
+        brush.setOutlineThickness(style.outlineThickness);
+        renderer.draw(brush);
+    }
+}
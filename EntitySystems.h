@@ -0,0 +1,15 @@
+#pragma once
+#include "EntityStore.h"
+#include "Renderer.h"
+
+// Systems over EntityStore columns. Simulation systems only read and write
+// component data; drawCircles is the one place rows become SFML drawables.
+
+// position += velocity * dt for every archetype with Transform and Velocity
+void integrateVelocities(EntityStore& store, float deltaTime);
+
+// Fades RenderStyle alpha with remaining life and destroys expired entities
+void expireLifetimes(EntityStore& store, float now);
+
+// Draws every row of one kind as a circle, reusing a single brush shape
+void drawCircles(const Archetype& archetype, Renderer& renderer, sf::CircleShape& brush);
@@ -0,0 +1,208 @@
+#include "FixedPhysics.h"
+#include <algorithm>
+
+namespace {
+
+const Fixed outline = 3 * fixedOne / 2;                 // Obstacle outline, 1.5
+const Fixed restitutionPlusOne = 117965;                 // 1.8
+const Fixed half = fixedOne / 2;
+const Fixed playerStep = 436907;                         // 400 units/s for one 60 Hz tick
+const Fixed playerSize = 16 * fixedOne;
+const Fixed playerExtent = playerSize + outline;         // Size plus the player's 1.5 outline
+const Fixed fieldRight = 480 * fixedOne;
+const Fixed topLimit = 60 * fixedOne;
+const Fixed bottomLimit = 793 * fixedOne;
+const std::int32_t rotationStep = 6;                     // 360 degrees/s for one tick
+
+// |cos| + |sin| of whole degrees 0..89, Q16.16; the box of a rotated square
+// grows by this factor and repeats every 90 degrees
+const Fixed boxGrowth[90] = {
+    65536, 66670, 67783, 68876, 69948, 70998, 72027, 73034, 74019, 74981,
+    75921, 76837, 77730, 78599, 79444, 80265, 81061, 81833, 82580, 83302,
+    83998, 84669, 85314, 85933, 86526, 87092, 87632, 88146, 88632, 89092,
+    89524, 89929, 90306, 90657, 90979, 91274, 91541, 91780, 91991, 92174,
+    92329, 92456, 92555, 92625, 92668, 92682, 92668, 92625, 92555, 92456,
+    92329, 92174, 91991, 91780, 91541, 91274, 90979, 90657, 90306, 89929,
+    89524, 89092, 88632, 88146, 87632, 87092, 86526, 85933, 85314, 84669,
+    83998, 83302, 82580, 81833, 81061, 80265, 79444, 78599, 77730, 76837,
+    75921, 74981, 74019, 73034, 72027, 70998, 69948, 68876, 67783, 66670,
+};
+
+} // namespace
+
+void FixedBodies::reserve(std::size_t count) {
+    for (std::vector<Fixed>* column : {&x, &y, &vx, &vy, &radius, &extent}) {
+        column->reserve(count);
+    }
+}
+
+void FixedBodies::clear() {
+    for (std::vector<Fixed>* column : {&x, &y, &vx, &vy, &radius, &extent}) {
+        column->clear();
+    }
+}
+
+void FixedBodies::push(Fixed px, Fixed py, Fixed velocityY, Fixed r) {
+    x.push_back(px);
+    y.push_back(py);
+    vx.push_back(0);
+    vy.push_back(velocityY);
+    radius.push_back(r);
+    extent.push_back(2 * (r + outline));
+}
+
+void FixedBodies::swapRemove(std::size_t row) {
+    for (std::vector<Fixed>* column : {&x, &y, &vx, &vy, &radius, &extent}) {
+        (*column)[row] = column->back();
+        column->pop_back();
+    }
+}
+
+void FixedPlayer::place(float px, float py) {
+    x = toFixed(px);
+    y = toFixed(py);
+    rotation = 0;
+    targetRotation = 0;
+}
+
+void FixedPlayer::move(const PlayerInput& input) {
+    bool isMoving = input.left || input.right || input.forward || input.backward;
+    if (input.left) {
+        x = std::max(x - playerStep, playerSize);
+        targetRotation = -30;
+    }
+    if (input.right) {
+        x = std::min(x + playerStep, fieldRight - playerSize);
+        targetRotation = 30;
+    }
+    if (input.forward) {
+        y = std::max(y - playerStep, topLimit);
+        targetRotation = -15;
+    }
+    if (input.backward) {
+        y = std::min(y + playerStep, bottomLimit);
+        targetRotation = 15;
+    }
+    if (!isMoving) {
+        targetRotation = 0;
+    }
+
+    // Player::updateRotation: turn towards the target, snapping when close
+    std::int32_t difference = targetRotation - rotation;
+    if (difference > 180) {
+        difference -= 360;
+    } else if (difference < -180) {
+        difference += 360;
+    }
+    if (difference > 1 || difference < -1) {
+        if (std::abs(difference) < rotationStep) {
+            rotation = targetRotation;
+        } else {
+            rotation += difference > 0 ? rotationStep : -rotationStep;
+        }
+    } else {
+        rotation = targetRotation;
+    }
+    rotation = ((rotation % 360) + 360) % 360;
+}
+
+Fixed FixedPlayer::halfExtent() const {
+    return fixedMul(playerExtent, boxGrowth[rotation % 90]);
+}
+
+void FixedPlayer::mirror(Player& player) const {
+    player.setPosition(sf::Vector2f(fromFixed(x), fromFixed(y)));
+    player.setRotation(static_cast<float>(rotation));
+}
+
+void integrateFixed(FixedBodies& bodies) {
+    Fixed* x = bodies.x.data();
+    Fixed* y = bodies.y.data();
+    const Fixed* vx = bodies.vx.data();
+    const Fixed* vy = bodies.vy.data();
+    std::size_t count = bodies.size();
+    for (std::size_t i = 0; i < count; ++i) {
+        x[i] += vx[i];
+        y[i] += vy[i];
+    }
+}
+
+void collideFixed(FixedBodies& bodies, std::vector<std::uint8_t>& scratch) {
+    std::size_t count = bodies.size();
+    scratch.resize(count);   // Reserved by the caller
+    std::uint8_t* overlaps = scratch.data();
+    const Fixed* x = bodies.x.data();
+    const Fixed* y = bodies.y.data();
+    const Fixed* extent = bodies.extent.data();
+
+    for (std::size_t i = 0; i < count; ++i) {
+        // Box overlap against every later row, branch-free (both boxes are
+        // offset by the same outline, so it cancels)
+        Fixed xi = x[i];
+        Fixed yi = y[i];
+        Fixed ei = extent[i];
+        for (std::size_t j = i + 1; j < count; ++j) {
+            overlaps[j] = static_cast<std::uint8_t>((xi < x[j] + extent[j]) & (x[j] < xi + ei) &
+                                                    (yi < y[j] + extent[j]) & (y[j] < yi + ei));
+        }
+        for (std::size_t j = i + 1; j < count; ++j) {
+            if (overlaps[j]) {
+                resolveFixedContact(bodies, i, j);
+            }
+        }
+    }
+}
+
+bool resolveFixedContact(FixedBodies& bodies, std::size_t first, std::size_t second) {
+    // resolveContact() in Q16.16: restitution 0.8, then push apart
+    Fixed dx = bodies.x[second] - bodies.x[first];
+    Fixed dy = bodies.y[second] - bodies.y[first];
+    Fixed distance = fixedLength(dx, dy);
+    Fixed nx = 0;
+    Fixed ny = 0;
+    if (distance > 0) {
+        nx = fixedDiv(dx, distance);
+        ny = fixedDiv(dy, distance);
+    }
+
+    Fixed relativeX = bodies.vx[second] - bodies.vx[first];
+    Fixed relativeY = bodies.vy[second] - bodies.vy[first];
+    Fixed alongNormal = static_cast<Fixed>((static_cast<std::int64_t>(relativeX) * nx +
+                                            static_cast<std::int64_t>(relativeY) * ny) >> fixedShift);
+    if (alongNormal > 0) {
+        return false;
+    }
+
+    Fixed impulse = fixedMul(-alongNormal, restitutionPlusOne);
+    Fixed impulseX = fixedMul(nx, impulse);
+    Fixed impulseY = fixedMul(ny, impulse);
+    bodies.vx[first] -= impulseX;
+    bodies.vy[first] -= impulseY;
+    bodies.vx[second] += impulseX;
+    bodies.vy[second] += impulseY;
+
+    Fixed overlap = distance - (bodies.radius[first] + bodies.radius[second]);
+    if (overlap < 0) {
+        Fixed separation = fixedMul(-overlap, half);
+        Fixed separationX = fixedMul(nx, separation);
+        Fixed separationY = fixedMul(ny, separation);
+        bodies.x[first] -= separationX;
+        bodies.y[first] -= separationY;
+        bodies.x[second] += separationX;
+        bodies.y[second] += separationY;
+    }
+    return true;
+}
+
+std::size_t findFixedOverlap(const FixedBodies& bodies, Fixed left, Fixed top, Fixed right, Fixed bottom) {
+    std::size_t count = bodies.size();
+    for (std::size_t row = 0; row < count; ++row) {
+        Fixed boxLeft = bodies.x[row] - outline;
+        Fixed boxTop = bodies.y[row] - outline;
+        if (left < boxLeft + bodies.extent[row] && boxLeft < right &&
+            top < boxTop + bodies.extent[row] && boxTop < bottom) {
+            return row;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include "FixedPoint.h"
+#include "Player.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Obstacle bodies for the fixed-point mode, as parallel integer columns so
+// the per-tick kernels are straight loops over plain arrays that compilers
+// turn into SIMD. Velocities are per tick, so integration is an add.
+// Rows mirror the obstacle archetype's rows in the same order.
+struct FixedBodies {
+    std::vector<Fixed> x;          // Top-left of the circle's box, as Transform
+    std::vector<Fixed> y;
+    std::vector<Fixed> vx;         // Units per tick
+    std::vector<Fixed> vy;
+    std::vector<Fixed> radius;
+    std::vector<Fixed> extent;     // Box size including the outline
+
+    std::size_t size() const { return x.size(); }
+    void reserve(std::size_t count);
+    void clear();
+    void push(Fixed px, Fixed py, Fixed velocityY, Fixed r);
+    void swapRemove(std::size_t row);   // Same as Archetype::swapRemove
+};
+
+// Player movement and hit box with integer positions and whole degrees.
+// Mirrors Player::move*, update() and getBounds() step for step at 60 Hz.
+struct FixedPlayer {
+    Fixed x = 0;
+    Fixed y = 0;
+    std::int32_t rotation = 0;         // Degrees, 0..359
+    std::int32_t targetRotation = 0;   // Degrees, -30..30
+
+    void place(float px, float py);
+    void move(const PlayerInput& input);
+    Fixed halfExtent() const;          // Half the side of the rotated triangle's box
+    void mirror(Player& player) const; // Copy into the float player for drawing
+};
+
+// Per-tick kernels
+void integrateFixed(FixedBodies& bodies);
+// Elastic contacts between overlapping pairs, resolved in row order. Pairs
+// are found from each row's position at the start of its pass (one
+// vectorized sweep per row), then resolved one by one.
+void collideFixed(FixedBodies& bodies, std::vector<std::uint8_t>& scratch);
+bool resolveFixedContact(FixedBodies& bodies, std::size_t first, std::size_t second);
+// Index of the first body overlapping the box, or size() if none
+std::size_t findFixedOverlap(const FixedBodies& bodies, Fixed left, Fixed top, Fixed right, Fixed bottom);
@@ -0,0 +1,56 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+
+// Q16.16 fixed point for the deterministic simulation mode: integer adds,
+// multiplies and shifts give the same bits on every compiler, flag set and
+// machine, unlike float with FMA contraction or vectorized reassociation.
+// Range is +-32768 units, ample for an 480x853 field.
+typedef std::int32_t Fixed;
+
+constexpr int fixedShift = 16;
+constexpr Fixed fixedOne = 1 << fixedShift;
+
+// Conversions only happen at the edges (spawn data in, drawing out).
+// Scaling by a power of two is exact, so rounding is the only step.
+inline Fixed toFixed(float value) {
+    return static_cast<Fixed>(std::lround(value * static_cast<float>(fixedOne)));
+}
+
+inline float fromFixed(Fixed value) {
+    return static_cast<float>(value) / static_cast<float>(fixedOne);
+}
+
+constexpr Fixed fixedMul(Fixed a, Fixed b) {
+    return static_cast<Fixed>((static_cast<std::int64_t>(a) * b) >> fixedShift);
+}
+
+constexpr Fixed fixedDiv(Fixed a, Fixed b) {
+    return static_cast<Fixed>((static_cast<std::int64_t>(a) * fixedOne) / b);
+}
+
+// Floor of the square root, bit by bit; no floating point involved
+inline std::uint32_t integerSqrt(std::uint64_t value) {
+    std::uint64_t result = 0;
+    std::uint64_t bit = 1ull << 62;
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (value >= result + bit) {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return static_cast<std::uint32_t>(result);
+}
+
+// Length of a Q16.16 vector, in Q16.16 (the sum of squares is Q32.32)
+inline Fixed fixedLength(Fixed x, Fixed y) {
+    std::uint64_t squared = static_cast<std::uint64_t>(static_cast<std::int64_t>(x) * x) +
+                            static_cast<std::uint64_t>(static_cast<std::int64_t>(y) * y);
+    return static_cast<Fixed>(integerSqrt(squared));
+}
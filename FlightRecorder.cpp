@@ -0,0 +1,155 @@
+#include "FlightRecorder.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+std::atomic<std::uint64_t> nextRecorderId{1};
+std::atomic<std::uint32_t> nextThreadId{1};
+
+// Per-thread cache of the ring this thread writes for the most recent recorder
+struct ThreadRing {
+    std::uint64_t recorderId = 0;
+    void* ring = nullptr;
+};
+
+thread_local ThreadRing cachedRing;
+thread_local std::uint32_t threadId = 0;
+
+std::uint32_t currentThreadId() {
+    if (threadId == 0) {
+        threadId = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+    }
+    return threadId;
+}
+
+} // namespace
+
+FlightRecorder::FlightRecorder(std::size_t eventsPerThread)
+    : ringCount(0)
+    , eventsPerThread(std::max<std::size_t>(eventsPerThread, 1))
+    , recorderId(nextRecorderId.fetch_add(1, std::memory_order_relaxed))
+    , origin(std::chrono::steady_clock::now())
+    , enabled(true) {
+}
+
+std::uint64_t FlightRecorder::now() const {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count());
+}
+
+FlightRecorder::Ring* FlightRecorder::ringForThread() {
+    if (cachedRing.recorderId == recorderId) {
+        return static_cast<Ring*>(cachedRing.ring);
+    }
+
+    // Slow path, once per thread (or after switching recorders)
+    std::uint32_t id = currentThreadId();
+    Ring* found = nullptr;
+    std::size_t count = ringCount.load(std::memory_order_acquire);
+    for (std::size_t i = 0; i < count; ++i) {
+        if (rings[i].threadId == id) {
+            found = &rings[i];
+            break;
+        }
+    }
+    if (!found) {
+        std::size_t index = ringCount.fetch_add(1, std::memory_order_acq_rel);
+        if (index >= maxThreads) {
+            ringCount.store(maxThreads, std::memory_order_release);
+            return nullptr;  // Out of rings: this thread is not traced
+        }
+        found = &rings[index];
+        found->events.reset(new TraceEvent[eventsPerThread]);
+        found->threadId = id;
+    }
+
+    cachedRing.recorderId = recorderId;
+    cachedRing.ring = found;
+    return found;
+}
+
+void FlightRecorder::complete(const char* name, std::uint64_t startNs, std::uint64_t endNs) {
+    Ring* ring = ringForThread();
+    if (!ring) {
+        return;
+    }
+    std::uint64_t index = ring->written.load(std::memory_order_relaxed);
+    TraceEvent& event = ring->events[index % eventsPerThread];
+    event.name = name;
+    event.startNs = startNs;
+    event.durationNs = static_cast<std::uint32_t>(std::min<std::uint64_t>(endNs - startNs, 0xFFFFFFFFu));
+    event.phase = 'X';
+    ring->written.store(index + 1, std::memory_order_release);
+}
+
+void FlightRecorder::instant(const char* name) {
+    if (!enabled) {
+        return;
+    }
+    Ring* ring = ringForThread();
+    if (!ring) {
+        return;
+    }
+    std::uint64_t index = ring->written.load(std::memory_order_relaxed);
+    TraceEvent& event = ring->events[index % eventsPerThread];
+    event.name = name;
+    event.startNs = now();
+    event.durationNs = 0;
+    event.phase = 'i';
+    ring->written.store(index + 1, std::memory_order_release);
+}
+
+void FlightRecorder::nameThread(const char* name) {
+    Ring* ring = ringForThread();
+    if (ring) {
+        ring->threadName = name;
+    }
+}
+
+bool FlightRecorder::writeChromeTrace(const std::string& path, double windowSeconds) const {
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        return false;
+    }
+
+    std::uint64_t end = now();
+    std::uint64_t window = static_cast<std::uint64_t>(windowSeconds * 1e9);
+    std::uint64_t cutoff = end > window ? end - window : 0;
+
+    std::fprintf(file, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+    bool first = true;
+    std::size_t count = std::min(ringCount.load(std::memory_order_acquire), maxThreads);
+    for (std::size_t r = 0; r < count; ++r) {
+        const Ring& ring = rings[r];
+        if (ring.threadName) {
+            std::fprintf(file, "%s{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %u, "
+                               "\"args\": {\"name\": \"%s\"}}",
+                         first ? "" : ",\n", ring.threadId, ring.threadName);
+            first = false;
+        }
+
+        std::uint64_t written = ring.written.load(std::memory_order_acquire);
+        std::uint64_t oldest = written > eventsPerThread ? written - eventsPerThread : 0;
+        for (std::uint64_t i = oldest; i < written; ++i) {
+            const TraceEvent& event = ring.events[i % eventsPerThread];
+            if (event.startNs < cutoff) {
+                continue;
+            }
+            // Chrome traces use microseconds
+            if (event.phase == 'X') {
+                std::fprintf(file, "%s{\"name\": \"%s\", \"ph\": \"X\", \"pid\": 1, \"tid\": %u, "
+                                   "\"ts\": %.3f, \"dur\": %.3f}",
+                             first ? "" : ",\n", event.name, ring.threadId,
+                             event.startNs / 1000.0, event.durationNs / 1000.0);
+            } else {
+                std::fprintf(file, "%s{\"name\": \"%s\", \"ph\": \"i\", \"s\": \"t\", \"pid\": 1, \"tid\": %u, "
+                                   "\"ts\": %.3f}",
+                             first ? "" : ",\n", event.name, ring.threadId, event.startNs / 1000.0);
+            }
+            first = false;
+        }
+    }
+    std::fprintf(file, "\n]}\n");
+    return std::fclose(file) == 0;
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// One recorded span or instant. Names must be string literals (or otherwise
+// outlive the recorder); only the pointer is stored.
+struct TraceEvent {
+    const char* name;
+    std::uint64_t startNs;     // Since the recorder was created
+    std::uint32_t durationNs;  // 0 for instants
+    char phase;                // 'X' complete span, 'i' instant
+};
+
+// Always-on flight recorder.
+// Each thread that records gets its own fixed ring of events, so recording
+// is a clock read plus a store with no locks or allocation. Old events are
+// overwritten. writeChromeTrace() dumps the last few seconds as Chrome/Perfetto
+// trace JSON (load it in chrome://tracing or ui.perfetto.dev).
+class FlightRecorder {
+public:
+    static constexpr std::size_t maxThreads = 4;
+
+private:
+    struct Ring {
+        std::unique_ptr<TraceEvent[]> events;
+        std::atomic<std::uint64_t> written{0};   // Total events ever written
+        std::uint32_t threadId = 0;
+        const char* threadName = nullptr;
+    };
+
+    Ring rings[maxThreads];
+    std::atomic<std::size_t> ringCount;
+    std::size_t eventsPerThread;
+    std::uint64_t recorderId;                    // Distinguishes recorders in the per-thread cache
+    std::chrono::steady_clock::time_point origin;
+    bool enabled;
+
+    Ring* ringForThread();
+
+public:
+    explicit FlightRecorder(std::size_t eventsPerThread = 16384);
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+    std::uint64_t now() const;
+    void complete(const char* name, std::uint64_t startNs, std::uint64_t endNs);
+    void instant(const char* name);
+    void nameThread(const char* name);            // Label for the calling thread's track
+
+    void setEnabled(bool on) { enabled = on; }
+    bool isEnabled() const { return enabled; }
+
+    // Write every event that started in the last windowSeconds.
+    // Meant for the recording thread; events other threads write during the
+    // dump may come out torn, which is acceptable for a diagnostic.
+    bool writeChromeTrace(const std::string& path, double windowSeconds) const;
+};
+
+// Records a complete span from construction to destruction
+class TraceSpan {
+private:
+    FlightRecorder& recorder;
+    const char* name;
+    std::uint64_t start;
+
+public:
+    TraceSpan(FlightRecorder& recorder, const char* name)
+        : recorder(recorder), name(name), start(recorder.isEnabled() ? recorder.now() : 0) {}
+    ~TraceSpan() {
+        if (recorder.isEnabled()) {
+            recorder.complete(name, start, recorder.now());
+        }
+    }
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+};
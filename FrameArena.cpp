@@ -0,0 +1,43 @@
+#include "FrameArena.h"
+#include <algorithm>
+#include <new>
+
+FrameArena::FrameArena(std::size_t capacityBytes)
+    : buffer(new unsigned char[capacityBytes])
+    , capacity(capacityBytes)
+    , offset(0)
+    , highWater(0)
+    , overflows(0) {
+}
+
+void* FrameArena::allocate(std::size_t bytes, std::size_t alignment) {
+    std::uintptr_t base = reinterpret_cast<std::uintptr_t>(buffer.get());
+    std::uintptr_t aligned = (base + offset + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+    std::size_t start = static_cast<std::size_t>(aligned - base);
+    if (start + bytes > capacity) {
+        overflows++;
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            return ::operator new(bytes, std::align_val_t(alignment));
+        }
+        return ::operator new(bytes);
+    }
+    offset = start + bytes;
+    highWater = std::max(highWater, offset);
+    return buffer.get() + start;
+}
+
+void FrameArena::deallocate(void* pointer, std::size_t bytes, std::size_t alignment) {
+    (void)bytes;
+    std::uintptr_t address = reinterpret_cast<std::uintptr_t>(pointer);
+    std::uintptr_t base = reinterpret_cast<std::uintptr_t>(buffer.get());
+    // The end of the block is inside it too: that is where a 0-byte request
+    // lands once the block is full
+    if (address >= base && address <= base + capacity) {
+        return;
+    }
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        ::operator delete(pointer, std::align_val_t(alignment));
+    } else {
+        ::operator delete(pointer);
+    }
+}
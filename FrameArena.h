@@ -0,0 +1,87 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Linear allocator for data that only lives within one simulation tick.
+// allocate() bumps an offset into one preallocated block; Game calls reset()
+// at the end of every tick, which frees everything at once in O(1). Scope
+// rewinds to a checkpoint so a pass can drop its scratch early. If the block
+// runs out, requests fall back to the heap (counted as overflows) so a
+// too-small arena costs speed, never correctness. The high-water mark shows
+// how much a real session needed.
+class FrameArena {
+public:
+    using Checkpoint = std::size_t;
+
+    // Rewinds the arena when it goes out of scope. Containers using the arena
+    // must be declared after the Scope so they are destroyed first.
+    class Scope {
+    private:
+        FrameArena& arena;
+        Checkpoint checkpoint;
+
+    public:
+        explicit Scope(FrameArena& arena) : arena(arena), checkpoint(arena.mark()) {}
+        ~Scope() { arena.rewind(checkpoint); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+private:
+    std::unique_ptr<unsigned char[]> buffer;
+    std::size_t capacity;
+    std::size_t offset;
+    std::size_t highWater;
+    std::uint64_t overflows;
+
+public:
+    explicit FrameArena(std::size_t capacityBytes);
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* allocate(std::size_t bytes, std::size_t alignment);
+    // Only heap fallbacks are freed individually; pass the alignment given to allocate()
+    void deallocate(void* pointer, std::size_t bytes, std::size_t alignment);
+
+    Checkpoint mark() const { return offset; }
+    void rewind(Checkpoint checkpoint) { offset = checkpoint < offset ? checkpoint : offset; }
+    void reset() { offset = 0; }
+
+    std::size_t getCapacity() const { return capacity; }
+    std::size_t getUsed() const { return offset; }
+    std::size_t getHighWater() const { return highWater; }
+    std::uint64_t getOverflows() const { return overflows; }
+};
+
+// Standard allocator over a FrameArena, for containers of per-tick scratch
+template <typename T>
+class ArenaAllocator {
+private:
+    FrameArena* arena;
+
+    template <typename U> friend class ArenaAllocator;
+
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(FrameArena& arena) : arena(&arena) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(std::size_t count) {
+        return static_cast<T*>(arena->allocate(count * sizeof(T), alignof(T)));
+    }
+    void deallocate(T* pointer, std::size_t count) {
+        arena->deallocate(pointer, count * sizeof(T), alignof(T));
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const { return arena != other.arena; }
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
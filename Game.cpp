@@ -1,56 +1,29 @@
 #include "Game.h"
+#include "SfmlRenderer.h"
+#include "WaveScripts.h"
+#include <cstdio>
 #include <iostream>
 #include <random>
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
+#include <ctime>
+#include <cmath>
+#include <chrono>
 
-// ExplosionParticle implementation
-ExplosionParticle::ExplosionParticle(float x, float y, float vx, float vy, float lifetime)
-    : velocity(vx, vy), life(lifetime), maxLife(lifetime) {
-    shape.setRadius(2.0f);
-    shape.setPosition(x, y);
-    shape.setFillColor(sf::Color::Yellow);
-}
-
-void ExplosionParticle::update(float deltaTime) {
-    life -= deltaTime;
-    shape.move(velocity * deltaTime);
-    
-    // Fade out
-    float alpha = (life / maxLife) * 255;
-    shape.setFillColor(sf::Color(255, 255, 0, static_cast<sf::Uint8>(alpha)));
-}
-
-bool ExplosionParticle::isDead() const {
-    return life <= 0;
-}
-
-// TrailParticle implementation
-TrailParticle::TrailParticle(float x, float y, float lifetime)
-    : life(lifetime), maxLife(lifetime) {
-    shape.setRadius(3.0f);
-    shape.setPosition(x, y);
-    shape.setFillColor(sf::Color::Cyan);
-}
-
-void TrailParticle::update(float deltaTime) {
-    life -= deltaTime;
-    
-    // Fade out
-    float alpha = (life / maxLife) * 255;
-    shape.setFillColor(sf::Color(0, 255, 255, static_cast<sf::Uint8>(alpha)));
-}
-
-bool TrailParticle::isDead() const {
-    return life <= 0;
-}
-
-Game::Game() 
-    : window(sf::VideoMode(480, 853), "Triangle Game", sf::Style::Close)
-    , currentState(GameState::Menu)
+Game::Game(std::unique_ptr<Renderer> customRenderer, std::size_t obstacleCapacity)
+    : renderer(std::move(customRenderer))
     , lastObstacleSpawn(sf::Time::Zero)
     , obstacleSpawnInterval(sf::seconds(1.0f))
+    , worldSeed(0)
+    , fixedWorldSeed(false)
+    , waves(WaveDirector::defaultCapacity)
+    , announcedRound(1)
+    , spectatorTick(0)
+    , currentState(GameState::Menu)
     , isRunning(true)
+    , behaviours(obstacleCapacity)
+    , fontsApplied(false)
     , mousePressed(false)
     , gameSpeed(300.0f)  // Decreased from 400
     , speedIncrement(40.0f)  // Decreased from 80 for slower progression
@@ -58,88 +31,98 @@ Game::Game()
     , speedIncrementInterval(sf::seconds(2.0f))  // Increased interval for slower progression
     , score(0)
     , lives(5)  // Increased to 5 lives
-    , screenShakeTime(0.0f)
+    , isShaking(false)
     , screenShakeIntensity(0.0f)
     , screenShakeOffset(0.0f, 0.0f)
-    , invulnerabilityTime(0.0f)
     , invulnerabilityDuration(1.5f)  // 1.5 seconds of invulnerability
-    , isInvulnerable(false) {
-    
-    window.setFramerateLimit(60);
-    window.setVerticalSyncEnabled(true);
-    
-    // Load font with multiple fallback options
-    bool fontLoaded = false;
+    , isInvulnerable(false)
+    , simulationTime(0.0f)
+    , frameArena(frameArenaBytes)
+    , timeScale(1.0f)
+    , tickAccumulator(0.0f)
+    , frameCounter(0)
+    , recordedPairsTested(0)
+    , displayedScore(-1)
+    , displayedSpeed(-1)
+    , displayedLives(-1)
+    , frameBudgetMs(40.0f)
+    , traceDirectory(".")
+    , hitchDumps(0)
+    , lastHitchDump(0)
+    , needsRedraw(true)
+    , renderedThisFrame(false)
+    , idleTime(0.0f)
+    , ambientElapsed(0.0f)
+    , displayedFinalScore(-1)
+    , idleMinuteElapsed(0.0f)
+    , idleMinuteFrames(0)
+    , idleMinuteCpuStart(0)
+    , startupBegin(std::chrono::steady_clock::now()) {
     
-    // Try multiple font options
-    const std::vector<std::string> fontPaths = {
+    // Fonts decode on the loader thread while the window opens; until they
+    // arrive every text draws as a placeholder (see applyFonts)
+    fontAsset = assets.loadFont({
         "/System/Library/Fonts/HelveticaNeue.ttc",
         "/System/Library/Fonts/Geneva.ttf",
         "/System/Library/Fonts/SFNSMono.ttf",
         "/System/Library/Fonts/Arial.ttf"
-    };
+    });
     
-    for (const auto& fontPath : fontPaths) {
-        if (font.loadFromFile(fontPath)) {
-            fontLoaded = true;
-            std::cout << "Font loaded successfully: " << fontPath << std::endl;
-            break;
-        }
+    // No renderer given: open the real window and draw through SFML
+    if (!renderer) {
+        window.create(sf::VideoMode(static_cast<unsigned int>(worldWidth), static_cast<unsigned int>(worldHeight)),
+                      "Triangle Game", sf::Style::Close);
+        window.setFramerateLimit(60);
+        window.setVerticalSyncEnabled(true);
+        renderer = std::make_unique<SfmlRenderer>(window);
+        startup.windowMs = startupMs();
     }
+    world.setWaitForLateChunks(!window.isOpen());
+    world.start();
     
-    if (!fontLoaded) {
-        std::cout << "Warning: Could not load any system fonts, text may not display properly" << std::endl;
-    }
+    // Claims the constructing thread's trace ring now rather than mid-frame
+    tracer.nameThread("game");
     
     // Setup UI text
-    scoreText.setFont(font);
     scoreText.setCharacterSize(18);  // Smaller text for smaller window
     scoreText.setFillColor(sf::Color::White);
     scoreText.setPosition(10, 10);
     
-    speedText.setFont(font);
     speedText.setCharacterSize(16);  // Smaller text for smaller window
     speedText.setFillColor(sf::Color::Yellow);
     speedText.setPosition(10, 35);
     
-    livesText.setFont(font);
     livesText.setCharacterSize(18);  // Smaller text for smaller window
     livesText.setFillColor(sf::Color::Red);
     livesText.setPosition(10, 60);
     
     // Setup title text
-    titleText.setFont(font);
     titleText.setString("TRIANGLE DODGER");
     titleText.setCharacterSize(36);
     titleText.setFillColor(sf::Color::Cyan);
     titleText.setStyle(sf::Text::Bold);
     
-    // Center title text
-    sf::FloatRect titleBounds = titleText.getLocalBounds();
-    titleText.setPosition(
-        (480.0f - titleBounds.width) / 2.0f,
-        150.0f
-    );
-    
     // Setup game over text
-    gameOverText.setFont(font);
     gameOverText.setString("GAME OVER");
     gameOverText.setCharacterSize(32);
     gameOverText.setFillColor(sf::Color::Red);
     gameOverText.setStyle(sf::Text::Bold);
-    
-    // Center game over text
-    sf::FloatRect gameOverBounds = gameOverText.getLocalBounds();
-    gameOverText.setPosition(
-        (480.0f - gameOverBounds.width) / 2.0f,
-        150.0f
-    );
+    centerHeadings();
     
     // Setup final score text
-    finalScoreText.setFont(font);
     finalScoreText.setCharacterSize(24);
     finalScoreText.setFillColor(sf::Color::White);
     
+    leaderboardText.setCharacterSize(16);
+    leaderboardText.setFillColor(sf::Color(200, 200, 200));
+    
+    // Obstacles keep a fixed capacity; spawns beyond it are dropped. Particle
+    // kinds are reserved for their usual peak so play does not grow them.
+    entities.setCapacity(EntityKind::Obstacle, obstacleCapacity);
+    entities.reserve(EntityKind::Explosion, 512);
+    entities.reserve(EntityKind::Background, 40);
+    firedTimers.reserve(16);
+    
     // Initialize background particles
     for (int i = 0; i < 40; ++i) {  // Fewer particles for smaller screen
         spawnBackgroundParticle();
@@ -148,217 +131,813 @@ Game::Game()
     // Setup menu and game over screens
     setupMenu();
     setupGameOverScreen();
+    restartTimers();
+    worldSeed = (static_cast<std::uint64_t>(std::random_device{}()) << 32) | std::random_device{}();
+    world.restart(worldSeed, 0.0f);
+    
+    // Present the menu now, placeholders and all, rather than after the assets
+    if (window.isOpen()) {
+        renderFrame();
+    }
+}
+
+float Game::startupMs() const {
+    return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startupBegin).count();
+}
+
+void Game::centerHeadings() {
+    sf::Vector2f titleSize = textSize(titleText);
+    titleText.setPosition((480.0f - titleSize.x) / 2.0f, 150.0f);
+    sf::Vector2f gameOverSize = textSize(gameOverText);
+    gameOverText.setPosition((480.0f - gameOverSize.x) / 2.0f, 150.0f);
+}
+
+void Game::applyFonts() {
+    // Runs once, on the first frame after the loader finished
+    uiFont = fontAsset.get();
+    const sf::Font& loaded = uiFont ? uiFont->font : missingFont;
+    if (uiFont) {
+        std::cout << "Font loaded successfully: " << uiFont->path << " (" << uiFont->loadMs
+                  << " ms on the loader thread)" << std::endl;
+    } else {
+        std::cout << "Warning: Could not load any system fonts, text may not display properly" << std::endl;
+    }
+    
+    for (sf::Text* text : {&scoreText, &speedText, &livesText, &titleText, &gameOverText,
+                           &finalScoreText, &leaderboardText}) {
+        text->setFont(loaded);
+    }
+    for (auto& button : menuButtons) {
+        button->setFont(loaded);
+    }
+    for (auto& button : gameOverButtons) {
+        button->setFont(loaded);
+    }
+    
+    // Re-lay out what was centered on placeholder sizes
+    centerHeadings();
+    displayedFinalScore = -1;
+    sf::FloatRect bounds = leaderboardText.getLocalBounds();
+    leaderboardText.setPosition((480.0f - bounds.width) / 2.0f, 620.0f);
+    fontsApplied = true;
+    needsRedraw = true;
+}
+
+void Game::noteStartupFrame() {
+    if (startup.firstFrameMs < 0.0f) {
+        startup.firstFrameMs = startupMs();
+    }
+    if (!fontsApplied) {
+        return;
+    }
+    startup.interactiveMs = startupMs();
+    char opened[32] = "no window";
+    if (startup.windowMs >= 0.0f) {
+        std::snprintf(opened, sizeof(opened), "window %.1f ms", startup.windowMs);
+    }
+    char line[128];
+    std::snprintf(line, sizeof(line), "Startup: %s, first frame %.1f ms, interactive %.1f ms", opened,
+                  startup.firstFrameMs, startup.interactiveMs);
+    std::cout << line << std::endl;
+}
+
+bool Game::updateAmbient(float deltaTime) {
+    // Background particles only advance when an ambient frame is due
+    idleTime += deltaTime;
+    ambientElapsed += deltaTime;
+    if (ambientElapsed < ambientFrameInterval()) {
+        return false;
+    }
+    
+    updateBackgroundParticles(std::min(ambientElapsed, 0.25f));  // Clamp after long waits
+    ambientElapsed = 0.0f;
+    return true;
 }
 
-void Game::updateMenu() {
-    // Update background particles for visual effect
-    updateBackgroundParticles(0.016f); // Fixed delta time for smooth animation
+float Game::ambientFrameInterval() const {
+    return idleTime > deepIdleDelay ? deepIdleFrameInterval : idleFrameInterval;
+}
+
+void Game::updateMenu(float deltaTime) {
+    if (autopilot && idleTime > attractDelay) {
+        startGame();
+        return;
+    }
+    
+    if (updateAmbient(deltaTime)) {
+        needsRedraw = true;
+    }
     
     // Update buttons
     for (auto& button : menuButtons) {
-        button->update(mousePos, mousePressed);
+        if (button->update(mousePos, mousePressed)) {
+            needsRedraw = true;
+        }
     }
 }
 
-void Game::updateGameOver() {
-    // Update background particles for visual effect
-    updateBackgroundParticles(0.016f); // Fixed delta time for smooth animation
+void Game::updateGameOver(float deltaTime) {
+    if (autopilot && idleTime > attractDelay) {
+        startGame();
+        return;
+    }
     
-    // Update final score text
-    finalScoreText.setString("Final Score: " + std::to_string(score));
-    sf::FloatRect finalScoreBounds = finalScoreText.getLocalBounds();
-    finalScoreText.setPosition(
-        (480.0f - finalScoreBounds.width) / 2.0f,
-        220.0f
-    );
+    if (updateAmbient(deltaTime)) {
+        needsRedraw = true;
+    }
+    
+    // Update final score text only when the score shown is stale
+    if (displayedFinalScore != score) {
+        displayedFinalScore = score;
+        finalScoreText.setString("Final Score: " + std::to_string(score));
+        sf::Vector2f finalScoreSize = textSize(finalScoreText);
+        finalScoreText.setPosition(
+            (480.0f - finalScoreSize.x) / 2.0f,
+            220.0f
+        );
+        needsRedraw = true;
+    }
     
     // Update buttons
     for (auto& button : gameOverButtons) {
-        button->update(mousePos, mousePressed);
+        if (button->update(mousePos, mousePressed)) {
+            needsRedraw = true;
+        }
     }
 }
 
 void Game::renderMenu() {
-    window.clear(sf::Color::Black);
+    renderer->clear(sf::Color::Black);
     
     // Draw background particles
-    for (const auto& particle : backgroundParticles) {
-        window.draw(particle);
-    }
+    drawCircles(entities.archetype(EntityKind::Background), *renderer, circleBrush);
     
     // Draw title
-    window.draw(titleText);
+    drawText(*renderer, titleText, textPlaceholder);
     
     // Draw buttons
     for (auto& button : menuButtons) {
-        button->draw(window);
+        button->draw(*renderer);
     }
     
-    window.display();
+    {
+        TraceSpan span(tracer, "display");
+        renderer->display();
+    }
 }
 
 void Game::renderGameOver() {
-    window.clear(sf::Color::Black);
+    renderer->clear(sf::Color::Black);
     
     // Draw background particles
-    for (const auto& particle : backgroundParticles) {
-        window.draw(particle);
-    }
+    drawCircles(entities.archetype(EntityKind::Background), *renderer, circleBrush);
     
     // Draw game over text
-    window.draw(gameOverText);
-    window.draw(finalScoreText);
+    drawText(*renderer, gameOverText, textPlaceholder);
+    drawText(*renderer, finalScoreText, textPlaceholder);
+    if (history) {
+        drawText(*renderer, leaderboardText, textPlaceholder);
+    }
     
     // Draw buttons
     for (auto& button : gameOverButtons) {
-        button->draw(window);
+        button->draw(*renderer);
     }
     
-    window.display();
+    {
+        TraceSpan span(tracer, "display");
+        renderer->display();
+    }
+}
+
+TimerScheduler::Tick Game::ticksFor(float seconds) const {
+    long ticks = std::lround(seconds / tickSeconds);
+    return static_cast<TimerScheduler::Tick>(std::max(1L, ticks));
+}
+
+void Game::scheduleTimer(TimerHandle& handle, float seconds, GameTimer timer) {
+    timers.cancel(handle);
+    handle = timers.schedule(ticksFor(seconds), static_cast<std::uint32_t>(timer));
 }
 
-void Game::updateInvulnerability(float deltaTime) {
-    if (isInvulnerable) {
-        invulnerabilityTime -= deltaTime;
-        player.setFlashing(true);
-        if (invulnerabilityTime <= 0) {
+void Game::restartTimers() {
+    // Empty the wheel and start the periodic speed step
+    timers.clear();
+    shakeTimer = TimerHandle{};
+    invulnerabilityTimer = TimerHandle{};
+    flashTimer = TimerHandle{};
+    powerTimer = TimerHandle{};
+    tickAccumulator = 0.0f;
+    timers.schedule(ticksFor(speedIncrementInterval.asSeconds()),
+                    static_cast<std::uint32_t>(GameTimer::SpeedStep));
+    timers.schedule(ticksFor(firstWaveSeconds), static_cast<std::uint32_t>(GameTimer::WaveEvent));
+}
+
+void Game::handleTimer(GameTimer timer) {
+    switch (timer) {
+        case GameTimer::SpeedStep:
+            stepSpeed();
+            timers.schedule(ticksFor(speedIncrementInterval.asSeconds()),
+                            static_cast<std::uint32_t>(GameTimer::SpeedStep));
+            break;
+            
+        case GameTimer::WaveEvent:
+            startRandomWave(waves, (gameSpeed - 300.0f) / (maxSpeed - 300.0f));
+            timers.schedule(ticksFor(waveIntervalSeconds), static_cast<std::uint32_t>(GameTimer::WaveEvent));
+            break;
+            
+        case GameTimer::PowerExpired:
+            powerTimer = TimerHandle{};
+            player.setPowerState(Player::PowerState::Normal);
+            break;
+            
+        case GameTimer::InvulnerabilityEnd:
+            invulnerabilityTimer = TimerHandle{};
             isInvulnerable = false;
             player.setFlashing(false);
-        }
+            timers.cancel(flashTimer);
+            break;
+            
+        case GameTimer::FlashToggle:
+            player.toggleFlash();
+            scheduleTimer(flashTimer, 1.0f / 16.0f, GameTimer::FlashToggle);  // 8 flashes per second
+            break;
+            
+        case GameTimer::ShakeEnd:
+            shakeTimer = TimerHandle{};
+            isShaking = false;
+            screenShakeOffset = sf::Vector2f(0, 0);
+            break;
+    }
+}
+
+void Game::setPlayerPower(Player::PowerState state, float duration) {
+    player.setPowerState(state);
+    if (duration > 0.0f) {
+        scheduleTimer(powerTimer, duration, GameTimer::PowerExpired);
     } else {
-        player.setFlashing(false);
+        timers.cancel(powerTimer);
     }
 }
 
+void Game::startScreenShake(float duration, float intensity) {
+    isShaking = true;
+    screenShakeIntensity = intensity;
+    scheduleTimer(shakeTimer, duration, GameTimer::ShakeEnd);
+}
 
+void Game::startInvulnerability() {
+    isInvulnerable = true;
+    player.setFlashing(true);
+    scheduleTimer(invulnerabilityTimer, invulnerabilityDuration, GameTimer::InvulnerabilityEnd);
+    scheduleTimer(flashTimer, 1.0f / 16.0f, GameTimer::FlashToggle);
+    setPlayerPower(Player::PowerState::Invulnerable, invulnerabilityDuration);
+}
 
-void Game::checkObstacleCollisions() {
-    for (size_t i = 0; i < obstacles.size(); ++i) {
-        for (size_t j = i + 1; j < obstacles.size(); ++j) {
-            if (obstacles[i]->getBounds().intersects(obstacles[j]->getBounds())) {
-                // Calculate collision response (elastic collision)
-                sf::Vector2f pos1 = obstacles[i]->getPosition();
-                sf::Vector2f pos2 = obstacles[j]->getPosition();
-                sf::Vector2f vel1 = obstacles[i]->getVelocity();
-                sf::Vector2f vel2 = obstacles[j]->getVelocity();
-                
-                // Calculate collision normal
-                sf::Vector2f normal = pos2 - pos1;
-                float distance = std::sqrt(normal.x * normal.x + normal.y * normal.y);
-                if (distance > 0) {
-                    normal /= distance;
-                }
-                
-                // Calculate relative velocity
-                sf::Vector2f relativeVel = vel2 - vel1;
-                float velocityAlongNormal = relativeVel.x * normal.x + relativeVel.y * normal.y;
-                
-                // Don't resolve if objects are moving apart
-                if (velocityAlongNormal > 0) {
-                    continue;
-                }
-                
-                // Calculate impulse
-                float restitution = 0.8f;  // Bounciness factor
-                float impulse = -(1.0f + restitution) * velocityAlongNormal;
-                
-                // Apply impulse
-                sf::Vector2f impulseVector = normal * impulse;
-                obstacles[i]->addVelocity(-impulseVector);
-                obstacles[j]->addVelocity(impulseVector);
-                
-                // Separate the obstacles to prevent sticking
-                float overlap = distance - (obstacles[i]->getSize() + obstacles[j]->getSize());
-                if (overlap < 0) {
-                    sf::Vector2f separation = normal * (-overlap * 0.5f);
-                    obstacles[i]->setPosition(pos1 - separation);
-                    obstacles[j]->setPosition(pos2 + separation);
-                }
-                
-                // Create small explosion effect at collision point
-                sf::Vector2f collisionPoint = (pos1 + pos2) * 0.5f;
-                createExplosion(collisionPoint.x, collisionPoint.y);
+void Game::detectObstacleCollisions() {
+    // Detection only reads obstacle state; resolution happens in processCollisionEvents.
+    // Sort-and-sweep on x with scratch in the frame arena, then report contacts
+    // in row order so they resolve in the same order as an all-pairs test.
+    const Archetype& obstacles = entities.archetype(EntityKind::Obstacle);
+    std::size_t count = obstacles.size();
+    FrameArena::Scope scratch(frameArena);
+    ArenaVector<sf::FloatRect> bounds{ArenaAllocator<sf::FloatRect>(frameArena)};
+    ArenaVector<std::uint32_t> order{ArenaAllocator<std::uint32_t>(frameArena)};
+    ArenaVector<std::uint64_t> contacts{ArenaAllocator<std::uint64_t>(frameArena)};
+    bounds.reserve(count);
+    order.reserve(count);
+    contacts.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        bounds.push_back(obstacleBounds(obstacles, i));
+        order.push_back(static_cast<std::uint32_t>(i));
+    }
+    std::sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b) {
+        return bounds[a].left < bounds[b].left;
+    });
+    
+    int pairsTested = 0;
+    for (std::size_t a = 0; a < count; ++a) {
+        std::uint32_t i = order[a];
+        float right = bounds[i].left + bounds[i].width;
+        for (std::size_t b = a + 1; b < count && bounds[order[b]].left < right; ++b) {
+            std::uint32_t j = order[b];
+            pairsTested++;
+            if (bounds[i].intersects(bounds[j])) {
+                std::uint64_t first = std::min(i, j);
+                std::uint64_t second = std::max(i, j);
+                contacts.push_back((first << 32) | second);
             }
         }
     }
+    std::sort(contacts.begin(), contacts.end());
+    for (std::uint64_t pair : contacts) {
+        collisionEvents.push(CollisionEventType::PairContact,
+                             obstacles.entities[pair >> 32], obstacles.entities[pair & 0xFFFFFFFFu]);
+    }
+    collisionEvents.countPairsTested(pairsTested);
+}
+
+void Game::resolveObstacleContact(const CollisionEvent& event) {
+    std::size_t first;
+    std::size_t second;
+    if (!entities.locate(event.a, first) || !entities.locate(event.b, second)) {
+        return; // One of them was removed earlier in this batch
+    }
+    tracer.instant("collision.pair");
+    Archetype& obstacles = entities.archetype(EntityKind::Obstacle);
+    
+    // Elastic collision response; nothing to do if they are already separating
+    sf::Vector2f pos1 = obstacles.transforms[first].position;
+    sf::Vector2f pos2 = obstacles.transforms[second].position;
+    if (!resolveContact(obstacles.transforms[first].position, obstacles.velocities[first].linear,
+                        obstacles.colliders[first].radius,
+                        obstacles.transforms[second].position, obstacles.velocities[second].linear,
+                        obstacles.colliders[second].radius)) {
+        return;
+    }
+    
+    // Small explosion at the collision point, merged for pairs that stay in contact
+    if (collisionEvents.claimPairEffect(event.a, event.b, simulationTime)) {
+        sf::Vector2f collisionPoint = (pos1 + pos2) * 0.5f;
+        createExplosion(collisionPoint.x, collisionPoint.y);
+        collisionEvents.countEffect();
+    }
+    
+    // Later events for a split obstacle find it gone and are skipped
+    if (behaviours.takeSplitting(event.a)) {
+        splitObstacle(entities, event.a);
+    }
+    if (behaviours.takeSplitting(event.b)) {
+        splitObstacle(entities, event.b);
+    }
 }
 
 void Game::run() {
+    sf::Clock phaseClock;
     while (window.isOpen() && isRunning) {
+        phaseClock.restart();
+        std::uint64_t frameStart = tracer.now();
+        
+        {
+            TraceSpan span(tracer, "events");
+            switch (currentState) {
+                case GameState::Menu:
+                case GameState::GameOver:
+                    waitForScreenEvents();
+                    break;
+                    
+                case GameState::Playing:
+                    processEvents();
+                    readKeyboardInput();
+                    break;
+            }
+        }
+        sf::Time eventTime = phaseClock.restart();
+        
         float deltaTime = clock.restart().asSeconds();
         
         // Update mouse position
         mousePos = window.mapPixelToCoords(sf::Mouse::getPosition(window));
         
-        switch (currentState) {
-            case GameState::Menu:
-                processMenuEvents();
-                updateMenu();
-                renderMenu();
-                break;
-                
-            case GameState::Playing:
-                processEvents();
-                update(deltaTime);
-                render();
-                break;
-                
-            case GameState::GameOver:
-                processGameOverEvents();
-                updateGameOver();
-                renderGameOver();
-                break;
+        tick(deltaTime);
+        sf::Time updateTime = phaseClock.restart();
+        
+        renderFrame();
+        sf::Time renderTime = phaseClock.restart();
+        
+        if (telemetry) {
+            recordTelemetry(deltaTime, eventTime, updateTime, renderTime);
+        }
+        if (metrics) {
+            publishMetrics(deltaTime);
         }
+        if (currentState != GameState::Playing) {
+            trackIdleCpu(deltaTime);
+        }
+        
+        std::uint64_t frameEnd = tracer.now();
+        tracer.complete("frame", frameStart, frameEnd);
+        checkFrameBudget(frameEnd - frameStart);
+        if (currentState == GameState::Playing &&
+            renderScale.addFrame(static_cast<float>(frameEnd - frameStart) * 1e-9f)) {
+            std::cout << "Render scale " << renderScale.getScale() << " (auto)" << std::endl;
+        }
+        frameCounter++;
+    }
+    
+    if (telemetry) {
+        telemetry->close();
+    }
+    std::cout << "Frame arena: peak " << frameArena.getHighWater() << " of " << frameArena.getCapacity()
+              << " bytes per tick, " << frameArena.getOverflows() << " heap overflows" << std::endl;
+    if (versus) {
+        const RollbackStats& stats = versus->getStats();
+        std::cout << "Versus: " << stats.ticks << " ticks, " << stats.rollbacks << " rollbacks (max depth "
+                  << stats.maxDepth << ", " << stats.resimulatedTicks << " ticks re-simulated, worst "
+                  << stats.maxResimMicros << " us), " << stats.stalls << " stalls, "
+                  << stats.desyncs << " desyncs" << std::endl;
+    }
+    if (spectatorEncoder) {
+        const SpectatorStats& stats = spectatorEncoder->getStats();
+        float seconds = std::max(0.001f, spectatorClock.getElapsedTime().asSeconds());
+        std::cout << "Spectator: " << stats.frames << " frames (" << stats.keyframes << " keyframes), "
+                  << static_cast<std::uint64_t>(stats.bytes / seconds) << " bytes/s, "
+                  << (stats.frames ? stats.bytes / stats.frames : 0) << " bytes/frame avg, largest "
+                  << stats.largestFrame << ", " << spectatorOutput->getDropped() << " dropped" << std::endl;
+    }
+    WorldStats worldStats = world.getStats();
+    std::cout << "World: seed " << world.getSeed() << ", " << worldStats.chunksGenerated << " chunks generated ("
+              << worldStats.worstGenerateMicros << " us worst), " << worldStats.chunksMissed << " missed, "
+              << worldStats.placementsDropped << " placements dropped by validation" << std::endl;
+    const WaveStats& waveStats = waves.getStats();
+    std::cout << "Waves: " << waveStats.started << " started, " << waveStats.finished << " finished, peak "
+              << waveStats.peakRunning << "/" << waves.capacity() << " running, " << waveStats.spawned
+              << " obstacles spawned, " << waveStats.dropped << " dropped" << std::endl;
+    const SwarmStats& swarmStats = swarm.getStats();
+    std::cout << "Swarm: " << swarmStats.released << " boids released, peak " << swarmStats.peakBoids << "/"
+              << swarm.capacity() << ", " << swarmStats.dropped << " dropped" << std::endl;
+    const BehaviourStats& kindStats = behaviours.getStats();
+    auto spawnedKind = [&kindStats](ObstacleKind kind) { return kindStats.spawned[static_cast<std::size_t>(kind)]; };
+    std::cout << "Obstacle kinds: " << spawnedKind(ObstacleKind::Weaving) << " weaving, "
+              << spawnedKind(ObstacleKind::Homing) << " homing, " << spawnedKind(ObstacleKind::Accelerating)
+              << " accelerating, " << spawnedKind(ObstacleKind::Splitting) << " splitting (" << kindStats.splits
+              << " split), " << kindStats.dropped << " dropped" << std::endl;
+    if (audio) {
+        audio->stop();
+        AudioStats stats = audio->getStats();
+        std::cout << "Audio: peak " << stats.peakVoices << "/" << AudioMixer::maxVoices << " voices, "
+                  << stats.voicesStolen << " stolen, " << stats.commandsDropped << " commands dropped, "
+                  << stats.underruns << " underruns" << std::endl;
     }
 }
 
-void Game::processMenuEvents() {
-    sf::Event event;
-    while (window.pollEvent(event)) {
-        if (event.type == sf::Event::Closed) {
-            window.close();
-        }
-        else if (event.type == sf::Event::MouseButtonPressed) {
-            if (event.mouseButton.button == sf::Mouse::Left) {
-                mousePressed = true;
+void Game::checkFrameBudget(std::uint64_t frameNs) {
+    // Menu screens sleep between frames on purpose; only gameplay frames count
+    if (!tracer.isEnabled() || currentState != GameState::Playing ||
+        frameNs <= static_cast<std::uint64_t>(frameBudgetMs * 1e6f)) {
+        return;
+    }
+    tracer.instant("budget overrun");
+    
+    // Rate-limited so a machine that is always slow does not flood the disk
+    std::uint64_t now = tracer.now();
+    bool coolingDown = hitchDumps > 0 && now - lastHitchDump < static_cast<std::uint64_t>(hitchDumpCooldown * 1e9f);
+    if (hitchDumps >= maxHitchDumps || coolingDown) {
+        return;
+    }
+    
+    std::string path = traceDirectory + "/hitch-" + std::to_string(frameCounter) + ".json";
+    if (tracer.writeChromeTrace(path, traceWindowSeconds)) {
+        std::cout << "Frame " << frameCounter << " took " << frameNs / 1000000 << " ms (budget "
+                  << frameBudgetMs << " ms), trace written to " << path << std::endl;
+        hitchDumps++;
+        lastHitchDump = now;
+    }
+}
+
+void Game::setFrameBudget(float milliseconds) {
+    frameBudgetMs = milliseconds;
+}
+
+void Game::setTraceDirectory(const std::string& directory) {
+    traceDirectory = directory.empty() ? "." : directory;
+}
+
+void Game::waitForScreenEvents() {
+    // SFML 2's waitEvent has no timeout, so poll and sleep in short slices
+    // until input arrives or the next ambient frame is due. Deep idle polls
+    // less often; the first input still wakes it within one slice.
+    const sf::Time slice = sf::milliseconds(idleTime > deepIdleDelay ? 50 : 10);
+    while (window.isOpen()) {
+        bool gotEvent = false;
+        sf::Event event;
+        while (window.pollEvent(event)) {
+            if (currentState == GameState::Menu) {
+                handleMenuEvent(event);
+            } else {
+                handleGameOverEvent(event);
             }
+            gotEvent = true;
         }
-        else if (event.type == sf::Event::MouseButtonReleased) {
-            if (event.mouseButton.button == sf::Mouse::Left) {
-                mousePressed = false;
-            }
+        // A finished asset load also wakes the screen so it can swap in
+        if (gotEvent || currentState == GameState::Playing || (!fontsApplied && fontAsset.ready())) {
+            return;
         }
-        else if (event.type == sf::Event::KeyPressed) {
-            if (event.key.code == sf::Keyboard::Escape) {
-                window.close();
+        
+        sf::Time remaining = sf::seconds(ambientFrameInterval() - ambientElapsed) - clock.getElapsedTime();
+        if (remaining <= sf::Time::Zero) {
+            return;
+        }
+        sf::sleep(remaining < slice ? remaining : slice);
+    }
+}
+
+void Game::trackIdleCpu(float deltaTime) {
+    // Once per minute on the menu/game-over screens, report frames drawn and CPU used
+    if (idleMinuteElapsed == 0.0f) {
+        idleMinuteCpuStart = std::clock();
+        idleMinuteFrames = 0;
+    }
+    idleMinuteElapsed += deltaTime;
+    if (renderedThisFrame) {
+        idleMinuteFrames++;
+    }
+    
+    if (idleMinuteElapsed >= 60.0f) {
+        double cpuMs = 1000.0 * static_cast<double>(std::clock() - idleMinuteCpuStart) / CLOCKS_PER_SEC;
+        std::cout << "Idle minute: " << idleMinuteFrames << " frames drawn, "
+                  << static_cast<int>(cpuMs) << " ms CPU"
+                  << (idleTime > deepIdleDelay ? " (deep idle)" : "") << std::endl;
+        idleMinuteElapsed = 0.0f;
+    }
+}
+
+bool Game::enableTelemetry(const std::string& path) {
+    auto recorder = std::make_unique<TelemetryRecorder>();
+    if (!recorder->open(path)) {
+        std::cout << "Warning: Could not open telemetry file " << path << std::endl;
+        return false;
+    }
+    telemetry = std::move(recorder);
+    return true;
+}
+
+bool Game::enableHistory(const std::string& path) {
+    auto runs = std::make_unique<RunHistory>();
+    if (!runs->open(path)) {
+        std::cout << "Warning: Could not open run history " << path << std::endl;
+        return false;
+    }
+    history = std::move(runs);
+    std::cout << "Run history: " << history->size() << " runs in " << path << std::endl;
+    updateLeaderboard(-1);
+    return true;
+}
+
+void Game::recordRun() {
+    if (!history) {
+        return;
+    }
+    // Speed only rises during a run, so the current speed is the peak
+    std::int64_t runRecord = history->append(static_cast<std::uint64_t>(std::time(nullptr)), worldSeed,
+                                             simulationTime, gameSpeed, score);
+    if (runRecord < 0) {
+        std::cout << "Warning: Could not record the run" << std::endl;
+    }
+    updateLeaderboard(runRecord);
+}
+
+void Game::updateLeaderboard(std::int64_t runRecord) {
+    // Best five, this run marked, then today's tally
+    std::uint32_t best[5];
+    std::uint32_t count = history->top(best, 5);
+    std::ostringstream text;
+    text << "BEST RUNS\n";
+    for (std::uint32_t i = 0; i < count; ++i) {
+        const RunRecord& run = history->record(best[i]);
+        std::time_t when = static_cast<std::time_t>(run.timestamp);
+        std::tm local;
+        localtime_r(&when, &local);
+        int seconds = static_cast<int>(run.survivalSeconds);
+        text << (best[i] == runRecord ? "> " : "   ") << (i + 1) << ".  " << std::setw(5) << run.score
+             << "   " << seconds / 60 << ":" << std::setw(2) << std::setfill('0') << seconds % 60
+             << std::setfill(' ') << "   " << std::put_time(&local, "%Y-%m-%d") << "\n";
+    }
+    RunDay today;
+    if (history->findDay(RunHistory::dayOf(static_cast<std::uint64_t>(std::time(nullptr))), today)) {
+        text << "\nToday: " << today.runs << (today.runs == 1 ? " run" : " runs") << ", best "
+             << history->record(today.bestRecord).score;
+    }
+    leaderboardText.setString(text.str());
+    sf::FloatRect bounds = leaderboardText.getLocalBounds();
+    leaderboardText.setPosition((480.0f - bounds.width) / 2.0f, 620.0f);
+    needsRedraw = true;
+}
+
+void Game::setAutopilot(bool enabled, float budgetMicros) {
+    if (!enabled) {
+        autopilot.reset();
+        return;
+    }
+    if (!autopilot) {
+        autopilot = std::make_unique<Autopilot>(entities.archetype(EntityKind::Obstacle).capacity());
+    }
+    autopilot->setBudget(budgetMicros);
+}
+
+bool Game::enableAudio(std::unique_ptr<AudioSink> sink) {
+    auto mixer = std::make_unique<AudioMixer>(std::move(sink));
+    if (!mixer->start()) {
+        std::cout << "Warning: Could not start audio output" << std::endl;
+        return false;
+    }
+    audio = std::move(mixer);
+    return true;
+}
+
+void Game::playSound(SoundId sound, float x, float volume) {
+    if (!audio) {
+        return;
+    }
+    // Pan with horizontal position in the world
+    float pan = (x / worldWidth) * 2.0f - 1.0f;
+    audio->play(sound, volume, pan);
+}
+
+bool Game::enableMetrics(const std::string& name) {
+    auto publisher = std::make_unique<MetricsPublisher>();
+    if (!publisher->open(name)) {
+        std::cout << "Warning: Could not publish metrics at " << name << std::endl;
+        return false;
+    }
+    metrics = std::move(publisher);
+    return true;
+}
+
+void Game::publishMetrics(float frameSeconds) {
+    const CollisionTotals& collisions = collisionEvents.getTotals();
+    LiveMetricsSample sample;
+    sample.frame = frameCounter;
+    sample.timestampNs = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+    sample.state = static_cast<std::uint32_t>(currentState);
+    sample.score = score;
+    sample.lives = lives;
+    sample.gameSpeed = gameSpeed;
+    sample.frameMs = frameSeconds * 1000.0f;
+    sample.obstacles = static_cast<std::uint32_t>(entities.count(EntityKind::Obstacle));
+    sample.explosionParticles = static_cast<std::uint32_t>(entities.count(EntityKind::Explosion));
+    sample.backgroundParticles = static_cast<std::uint32_t>(entities.count(EntityKind::Background));
+    sample.trailSamples = static_cast<std::uint32_t>(trail.size());
+    sample.pairContacts = collisions.contacts;
+    sample.playerHits = collisions.playerHits;
+    sample.dodges = collisions.dodges;
+    metrics->publish(sample);
+}
+
+void Game::recordTelemetry(float deltaTime, sf::Time eventTime, sf::Time updateTime, sf::Time renderTime) {
+    TelemetryRecord entry{};
+    entry.frame = frameCounter;
+    entry.state = static_cast<std::uint8_t>(currentState);
+    entry.frameTime = deltaTime * 1000000.0f;
+    entry.eventTime = static_cast<float>(eventTime.asMicroseconds());
+    entry.updateTime = static_cast<float>(updateTime.asMicroseconds());
+    entry.renderTime = static_cast<float>(renderTime.asMicroseconds());
+    entry.obstacles = static_cast<std::uint16_t>(entities.count(EntityKind::Obstacle));
+    entry.explosionParticles = static_cast<std::uint16_t>(entities.count(EntityKind::Explosion));
+    entry.trailParticles = static_cast<std::uint16_t>(trail.size());
+    entry.backgroundParticles = static_cast<std::uint16_t>(entities.count(EntityKind::Background));
+    // Every tick this frame ran: the finished ones are in the totals, the last one is still current
+    std::uint64_t pairsTested = collisionEvents.getTotals().pairsTested +
+                                static_cast<std::uint64_t>(collisionEvents.getStats().pairsTested);
+    entry.pairsTested = static_cast<std::uint32_t>(pairsTested - recordedPairsTested);
+    recordedPairsTested = pairsTested;
+    entry.gameSpeed = gameSpeed;
+    entry.spawnInterval = obstacleSpawnInterval.asSeconds();
+    entry.score = score;
+    entry.lives = lives;
+    telemetry->record(entry);
+}
+
+void Game::tick(float deltaTime) {
+    if (!fontsApplied && fontAsset.ready()) {
+        applyFonts();
+    }
+    
+    switch (currentState) {
+        case GameState::Menu:
+            updateMenu(deltaTime);
+            break;
+            
+        case GameState::Playing: {
+            // Fixed simulation ticks; the time scale fast-forwards or slows them
+            tickAccumulator += deltaTime * timeScale;
+            int maxTicks = static_cast<int>(maxTicksPerFrame * std::max(1.0f, timeScale));
+            int ticks = 0;
+            while (tickAccumulator >= tickSeconds && ticks < maxTicks &&
+                   currentState == GameState::Playing) {
+                update(tickSeconds);
+                tickAccumulator -= tickSeconds;
+                ticks++;
+                
+                // One spectator frame per simulation tick, including the one that ends the game
+                if (spectatorOutput) {
+                    publishSpectatorFrame();
+                }
+            }
+            if (ticks == maxTicks) {
+                tickAccumulator = 0.0f;  // Too far behind: drop the backlog instead of spiralling
             }
+            break;
         }
+            
+        case GameState::GameOver:
+            updateGameOver(deltaTime);
+            break;
     }
 }
 
-void Game::processGameOverEvents() {
-    sf::Event event;
-    while (window.pollEvent(event)) {
-        if (event.type == sf::Event::Closed) {
+void Game::renderFrame() {
+    // Menu screens are only redrawn when something visible changed
+    renderedThisFrame = currentState == GameState::Playing || needsRedraw;
+    if (!renderedThisFrame) {
+        return;
+    }
+    needsRedraw = false;
+    ScopedAllocTag tag(AllocTag::Render);
+    TraceSpan span(tracer, "render");
+    
+    switch (currentState) {
+        case GameState::Menu:
+            renderMenu();
+            break;
+            
+        case GameState::Playing:
+            render();
+            break;
+            
+        case GameState::GameOver:
+            renderGameOver();
+            break;
+    }
+    
+    if (startup.interactiveMs < 0.0f) {
+        noteStartupFrame();
+    }
+}
+
+void Game::readKeyboardInput() {
+    input.left = sf::Keyboard::isKeyPressed(sf::Keyboard::Left) || sf::Keyboard::isKeyPressed(sf::Keyboard::A);
+    input.right = sf::Keyboard::isKeyPressed(sf::Keyboard::Right) || sf::Keyboard::isKeyPressed(sf::Keyboard::D);
+    input.forward = sf::Keyboard::isKeyPressed(sf::Keyboard::Up) || sf::Keyboard::isKeyPressed(sf::Keyboard::W);
+    input.backward = sf::Keyboard::isKeyPressed(sf::Keyboard::Down) || sf::Keyboard::isKeyPressed(sf::Keyboard::S);
+}
+
+void Game::noteScreenInput(const sf::Event& event) {
+    // Any input wakes the screen from deep idle
+    switch (event.type) {
+        case sf::Event::MouseMoved:
+        case sf::Event::MouseButtonPressed:
+        case sf::Event::MouseButtonReleased:
+        case sf::Event::KeyPressed:
+            idleTime = 0.0f;
+            break;
+            
+        case sf::Event::Resized:
+        case sf::Event::GainedFocus:
+            needsRedraw = true;  // Window contents may have been lost
+            break;
+            
+        default:
+            break;
+    }
+}
+
+void Game::handleMenuEvent(const sf::Event& event) {
+    noteScreenInput(event);
+    
+    if (event.type == sf::Event::Closed) {
+        window.close();
+    }
+    else if (event.type == sf::Event::MouseButtonPressed) {
+        if (event.mouseButton.button == sf::Mouse::Left) {
+            mousePressed = true;
+        }
+    }
+    else if (event.type == sf::Event::MouseButtonReleased) {
+        if (event.mouseButton.button == sf::Mouse::Left) {
+            mousePressed = false;
+        }
+    }
+    else if (event.type == sf::Event::KeyPressed) {
+        if (event.key.code == sf::Keyboard::Escape) {
             window.close();
         }
-        else if (event.type == sf::Event::MouseButtonPressed) {
-            if (event.mouseButton.button == sf::Mouse::Left) {
-                mousePressed = true;
-            }
+    }
+}
+
+void Game::handleGameOverEvent(const sf::Event& event) {
+    noteScreenInput(event);
+    
+    if (event.type == sf::Event::Closed) {
+        window.close();
+    }
+    else if (event.type == sf::Event::MouseButtonPressed) {
+        if (event.mouseButton.button == sf::Mouse::Left) {
+            mousePressed = true;
         }
-        else if (event.type == sf::Event::MouseButtonReleased) {
-            if (event.mouseButton.button == sf::Mouse::Left) {
-                mousePressed = false;
-            }
+    }
+    else if (event.type == sf::Event::MouseButtonReleased) {
+        if (event.mouseButton.button == sf::Mouse::Left) {
+            mousePressed = false;
         }
-        else if (event.type == sf::Event::KeyPressed) {
-            if (event.key.code == sf::Keyboard::Escape) {
-                window.close();
-            }
-            else if (event.key.code == sf::Keyboard::R) {
-                startGame();
-            }
+    }
+    else if (event.type == sf::Event::KeyPressed) {
+        if (event.key.code == sf::Keyboard::Escape) {
+            window.close();
+        }
+        else if (event.key.code == sf::Keyboard::R) {
+            startGame();
         }
     }
 }
@@ -381,45 +960,260 @@ void Game::processEvents() {
 }
 
 void Game::update(float deltaTime) {
-    // Update speed
-    updateSpeed();
+    TraceSpan span(tracer, "update");
+    simulationTime += deltaTime;
+    if (versus) {
+        updateVersus(deltaTime);
+        return;
+    }
+    if (spectatorInput) {
+        updateViewer(deltaTime);
+        return;
+    }
+    
+    // Fire due timers (speed steps, power/invulnerability/shake expiry)
+    {
+        ScopedAllocTag tag(AllocTag::Timers);
+        TraceSpan phase(tracer, "update.timers");
+        firedTimers.clear();
+        timers.advance(firedTimers);
+        for (std::uint32_t timer : firedTimers) {
+            handleTimer(static_cast<GameTimer>(timer));
+        }
+    }
+    
+    {
+        ScopedAllocTag tag(AllocTag::Entities);
+        TraceSpan phase(tracer, "update.spawn");
+        streamWorld();
+        waves.update(entities, gameSpeed, player.getPosition(), &swarm);
+    }
     
     // Update visual effects
-    updateScreenShake(deltaTime);
-    updateExplosionParticles(deltaTime);
-    updateTrailParticles(deltaTime);
+    {
+        TraceSpan phase(tracer, "update.effects");
+        updateScreenShake();
+        expireLifetimes(entities, simulationTime);  // Explosion particles
+        updateBackgroundParticles(deltaTime);
+    }
+    
+    {
+        TraceSpan phase(tracer, "update.player");
+        updatePlayer(deltaTime);
+    }
+    
+    // Kinds steer first, then everything moves in one pass
+    {
+        TraceSpan phase(tracer, "update.behaviours");
+        BehaviourContext context;
+        context.time = simulationTime;
+        context.deltaTime = deltaTime;
+        context.target = player.getPosition();
+        behaviours.update(entities, context);
+    }
+    
+    // Move obstacles and explosion particles
+    {
+        TraceSpan phase(tracer, "update.integrate");
+        integrateVelocities(entities, deltaTime);
+    }
+    {
+        TraceSpan phase(tracer, "update.swarm");
+        swarm.update(deltaTime, player.getPosition(), gameSpeed * BoidSwarm::flowRatio);
+    }
+    
+    // Detect first, then apply every effect in one batch
+    {
+        ScopedAllocTag tag(AllocTag::Collision);
+        TraceSpan phase(tracer, "update.collision");
+        collisionEvents.clear();
+        detectDodges();
+        detectObstacleCollisions();  // Check obstacle-to-obstacle collisions
+        detectPlayerCollision();
+        processCollisionEvents();
+    }
+    {
+        TraceSpan phase(tracer, "update.ui");
+        updateUI();
+    }
+    trackEntityMemory();
+    
+    // Everything allocated from the arena this tick is dead now
+    frameArena.reset();
+    
+    // Score is now based on dodged obstacles (handled in applyDodges)
+}
+
+void Game::enableVersus(std::unique_ptr<RollbackSession> session) {
+    versus = std::move(session);
+    announcedRound = 1;
+}
+
+void Game::updateVersus(float deltaTime) {
     updateBackgroundParticles(deltaTime);
-    updateInvulnerability(deltaTime);
+    {
+        TraceSpan phase(tracer, "update.versus");
+        versus->advance(input);  // Returns false while waiting for the rival to catch up
+    }
+    
+    // The HUD shows the local side; rounds restart on their own
+    const VersusState& state = versus->getSimulation().getState();
+    const VersusPlayer& local = state.players[versus->getLocalSide()];
+    score = local.dodges;
+    lives = local.lives;
+    gameSpeed = versus->getSimulation().speedAt(static_cast<float>(state.tick - state.roundStartTick) *
+                                                VersusSimulation::tickSeconds);
+    if (state.round != announcedRound) {
+        announcedRound = state.round;
+        std::cout << "Round " << state.round << " - wins: you " << state.wins[versus->getLocalSide()]
+                  << ", rival " << state.wins[1 - versus->getLocalSide()] << std::endl;
+    }
+    updateUI();
+}
+
+bool Game::enableSpectatorOutput(const std::string& target) {
+    auto output = std::make_unique<SpectatorOutput>();
+    if (!output->open(target)) {
+        std::cout << "Could not open spectator output " << target << std::endl;
+        return false;
+    }
+    spectatorOutput = std::move(output);
+    spectatorEncoder = std::make_unique<SpectatorEncoder>();
+    spectatorFrame = std::make_unique<SpectatorFrame>();
+    spectatorClock.restart();
+    return true;
+}
+
+bool Game::enableViewer(const std::string& source) {
+    auto input = std::make_unique<SpectatorInput>();
+    if (!input->open(source)) {
+        std::cout << "Could not open spectator stream " << source << std::endl;
+        return false;
+    }
+    spectatorInput = std::move(input);
+    spectatorFrame = std::make_unique<SpectatorFrame>();
+    setState(GameState::Playing);  // No menu: the viewer only ever shows the stream
+    return true;
+}
+
+void Game::publishSpectatorFrame() {
+    TraceSpan span(tracer, "spectator");
+    
+    // In versus the field and the local player live in the session
+    const EntityStore* store = &entities;
+    const Player* shown = &player;
+    if (versus) {
+        const VersusState& state = versus->getSimulation().getState();
+        store = &state.obstacles;
+        shown = &state.players[versus->getLocalSide()].player;
+    }
+    
+    SpectatorFrame& frame = *spectatorFrame;
+    frame.tick = spectatorTick++;
+    frame.gameState = static_cast<std::uint8_t>(currentState);
+    frame.playerX = shown->getPosition().x;
+    frame.playerY = shown->getPosition().y;
+    frame.playerRotation = shown->getRotation();
+    frame.powerState = static_cast<std::uint8_t>(shown->getPowerState());
+    frame.playerVisible = shown->isVisible();
+    frame.score = score;
+    frame.lives = lives;
+    frame.speed = static_cast<std::int32_t>(gameSpeed);
+    
+    const Archetype& obstacles = store->archetype(EntityKind::Obstacle);
+    frame.obstacleCount = static_cast<std::uint32_t>(std::min(obstacles.size(), SpectatorFrame::maxObstacles));
+    for (std::uint32_t row = 0; row < frame.obstacleCount; ++row) {
+        SpectatorObstacle& out = frame.obstacles[row];
+        out.slot = obstacles.entities[row].slot;
+        out.generation = obstacles.entities[row].generation;
+        out.x = obstacles.transforms[row].position.x;
+        out.y = obstacles.transforms[row].position.y;
+        out.radius = obstacles.colliders[row].radius;
+        out.fill = obstacles.styles[row].fill;
+    }
+    
+    spectatorEncoder->encode(frame);
+    spectatorOutput->write(spectatorEncoder->data(), spectatorEncoder->size());
+}
+
+void Game::updateViewer(float deltaTime) {
+    updateBackgroundParticles(deltaTime);
+    
+    // A live socket is drained (keyframes must not be skipped); a recording
+    // plays back one message per tick
+    SpectatorFrame& frame = *spectatorFrame;
+    const std::uint8_t* data = nullptr;
+    std::size_t size = 0;
+    bool updated = false;
+    while (spectatorInput->read(data, size)) {
+        updated = spectatorDecoder.decode(data, size, frame) || updated;
+        if (!spectatorInput->isLive()) {
+            break;
+        }
+    }
+    if (!updated) {
+        return;
+    }
+    
+    player.setPosition(sf::Vector2f(frame.playerX, frame.playerY));
+    player.setRotation(frame.playerRotation);
+    player.setPowerState(static_cast<Player::PowerState>(frame.powerState));
+    player.setFlashing(!frame.playerVisible);
+    if (!frame.playerVisible) {
+        player.toggleFlash();
+    }
+    player.updateColors();
+    
+    entities.clear(EntityKind::Obstacle);
+    for (std::uint32_t i = 0; i < frame.obstacleCount; ++i) {
+        const SpectatorObstacle& obstacle = frame.obstacles[i];
+        EntityId id = createObstacle(entities, obstacle.x, obstacle.y, 0.0f, obstacle.radius, 1.0f);
+        std::size_t row = 0;
+        if (entities.locate(id, row)) {
+            entities.archetype(EntityKind::Obstacle).styles[row].fill = obstacle.fill;
+        }
+    }
+    
+    score = frame.score;
+    lives = frame.lives;
+    gameSpeed = static_cast<float>(frame.speed);
+    updateUI();
+}
+
+void Game::updatePlayer(float deltaTime) {
+    if (autopilot) {
+        TraceSpan phase(tracer, "update.autopilot");
+        sf::FloatRect bounds = player.getBounds();
+        Autopilot::PlayerModel model{player.getPosition(), player.getSpeed(), player.getSize(),
+                                     0.5f * std::max(bounds.width, bounds.height)};
+        input = autopilot->plan(entities.archetype(EntityKind::Obstacle), model, deltaTime);
+    }
     
     // Handle keyboard input for rocket movement
     bool isMoving = false;
     bool isSpeedBoosting = false;
     
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left) || sf::Keyboard::isKeyPressed(sf::Keyboard::A)) {
+    if (input.left) {
         player.moveLeft(deltaTime);
-        addTrailParticle(player.getPosition().x, player.getPosition().y);
         isMoving = true;
     }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right) || sf::Keyboard::isKeyPressed(sf::Keyboard::D)) {
+    if (input.right) {
         player.moveRight(deltaTime);
-        addTrailParticle(player.getPosition().x, player.getPosition().y);
         isMoving = true;
     }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up) || sf::Keyboard::isKeyPressed(sf::Keyboard::W)) {
+    if (input.forward) {
         player.moveForward(deltaTime);
-        addTrailParticle(player.getPosition().x, player.getPosition().y);
         isMoving = true;
         isSpeedBoosting = true;
     }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Down) || sf::Keyboard::isKeyPressed(sf::Keyboard::S)) {
+    if (input.backward) {
         player.moveBackward(deltaTime);
-        addTrailParticle(player.getPosition().x, player.getPosition().y);
         isMoving = true;
     }
     
     // Set power states based on movement
     if (isSpeedBoosting && !isInvulnerable) {
-        player.setPowerState(Player::PowerState::SpeedBoost, 0.1f); // Short duration for movement
+        setPlayerPower(Player::PowerState::SpeedBoost, 0.1f); // Short duration for movement
     }
     
     // Return to center rotation when not moving
@@ -428,96 +1222,138 @@ void Game::update(float deltaTime) {
     }
     
     player.update(deltaTime);
-    
-    // Spawn obstacles
-    if (spawnClock.getElapsedTime() > obstacleSpawnInterval) {
-        spawnObstacle();
-        spawnClock.restart();
-    }
-    
-    // Update obstacles
-    for (auto& obstacle : obstacles) {
-        obstacle->update(deltaTime);
-    }
-    
-    removeOffscreenObstacles();
-    checkObstacleCollisions();  // Check obstacle-to-obstacle collisions
-    checkCollisions();
-    updateUI();
-    
-    // Score is now based on dodged obstacles (handled in removeOffscreenObstacles)
+    trail.update(player.getPosition(), simulationTime);
 }
 
 void Game::render() {
-    window.clear(sf::Color::Black);
+    renderer->clear(sf::Color::Black);
+    
+    // Gameplay layers go through the (possibly reduced-resolution) scaled layer
+    renderer->beginScaledLayer(renderScale.getScale());
     
     // Apply screen shake
-    sf::View view = window.getView();
-    view.setCenter(240 + screenShakeOffset.x, 426.5f + screenShakeOffset.y);  // Center for 480x853
-    window.setView(view);
+    sf::View view = renderer->getView();
+    view.setCenter(worldWidth / 2.0f + screenShakeOffset.x, worldHeight / 2.0f + screenShakeOffset.y);
+    renderer->setView(view);
     
     // Draw background particles
-    for (const auto& particle : backgroundParticles) {
-        window.draw(particle);
-    }
-    
-    // Draw trail particles
-    for (const auto& particle : trailParticles) {
-        window.draw(particle.shape);
-    }
+    drawCircles(entities.archetype(EntityKind::Background), *renderer, circleBrush);
     
-    // Draw explosion particles
-    for (const auto& particle : explosionParticles) {
-        window.draw(particle.shape);
-    }
-    
-    player.draw(window);
-    for (auto& obstacle : obstacles) {
-        obstacle->draw(window);
+    if (versus) {
+        versus->getSimulation().draw(*renderer, versus->getLocalSide());
+    } else {
+        // Draw the trail ribbon (one strip, under the player)
+        trail.draw(*renderer, player.getPosition(), simulationTime);
+        
+        // Draw explosion particles
+        drawCircles(entities.archetype(EntityKind::Explosion), *renderer, circleBrush);
+        
+        player.draw(*renderer);
+        drawCircles(entities.archetype(EntityKind::Obstacle), *renderer, circleBrush);
+        swarm.draw(*renderer);
     }
+    renderer->endScaledLayer();
     
-    // Reset view for UI
-    view.setCenter(240, 426.5f);  // Center for 480x853
-    window.setView(view);
+    // Reset view for UI, drawn at native resolution
+    view.setCenter(worldWidth / 2.0f, worldHeight / 2.0f);
+    renderer->setView(view);
     
     // Draw UI
-    window.draw(scoreText);
-    window.draw(speedText);
-    window.draw(livesText);
+    drawText(*renderer, scoreText, textPlaceholder);
+    drawText(*renderer, speedText, textPlaceholder);
+    drawText(*renderer, livesText, textPlaceholder);
+    
+    // A viewer mirrors the kiosk's title and game-over screens as overlays
+    if (spectatorInput && spectatorFrame->gameState == static_cast<std::uint8_t>(GameState::Menu)) {
+        drawText(*renderer, titleText, textPlaceholder);
+    } else if (spectatorInput && spectatorFrame->gameState == static_cast<std::uint8_t>(GameState::GameOver)) {
+        drawText(*renderer, gameOverText, textPlaceholder);
+    }
     
-    window.display();
+    {
+        TraceSpan span(tracer, "display");
+        renderer->display();
+    }
 }
 
-void Game::spawnObstacle() {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_real_distribution<float> xDis(60.0f, 420.0f);  // Adjusted for 480 width
-    static std::uniform_real_distribution<float> speedDis(0.5f, 2.0f);  // Random speed multiplier
+void Game::requestChunks() {
+    // Keep the worker a few chunks ahead; the game thread only fills in the
+    // difficulty forecast and pushes the request
+    ChunkRequest request;
+    while (world.wantsChunk(simulationTime, request)) {
+        request.spawnInterval = forecastSpawnInterval(request.startTime - simulationTime);
+        if (!world.submit(request)) {
+            break;
+        }
+    }
+}
+
+void Game::streamWorld() {
+    requestChunks();
     
-    float x = xDis(gen);
-    float y = -50.0f;
-    float speedMultiplier = speedDis(gen);
-    float speed = gameSpeed * speedMultiplier;  // Truly random speed!
-    obstacles.push_back(std::make_unique<Obstacle>(x, y, speed));
+    // Drop whatever the current chunk has due; anything due earlier in the
+    // tick starts as far down as it would have travelled since
+    ObstaclePlacement placement;
+    while (world.nextDue(simulationTime, placement)) {
+        tracer.instant("spawn");
+        float speed = gameSpeed * placement.speedMultiplier;
+        float y = -50.0f + speed * (simulationTime - placement.time);
+        EntityId id = createObstacle(entities, placement.x, y, speed, placement.radius,
+                                     placement.speedMultiplier);  // Dropped silently at capacity
+        if (id.isValid() && placement.kind != ObstacleKind::Straight) {
+            behaviours.attach(entities, id, placement.kind, placement.time);
+        }
+    }
+}
+
+float Game::forecastSpawnInterval(float secondsAhead) const {
+    // Replays stepSpeed()'s interval schedule
+    float interval = obstacleSpawnInterval.asSeconds();
+    int steps = static_cast<int>(std::max(0.0f, secondsAhead) / speedIncrementInterval.asSeconds());
+    for (int i = 0; i < steps && interval - 0.15f > 0.2f; ++i) {
+        interval -= 0.15f;
+    }
+    return interval;
+}
+
+void Game::setDifficulty(float speed, float spawnIntervalSeconds) {
+    gameSpeed = std::min(speed, maxSpeed);
+    obstacleSpawnInterval = sf::seconds(spawnIntervalSeconds);
+    // Chunks queued so far were generated for the old density
+    world.restart(worldSeed, simulationTime);
+    requestChunks();
+}
+
+void Game::setWorldSeed(std::uint64_t seed) {
+    worldSeed = seed;
+    fixedWorldSeed = true;
+}
+
+bool Game::spawnObstacleAt(float x, float y, float speed, float radius) {
+    ScopedAllocTag tag(AllocTag::Entities);
+    return createObstacle(entities, x, y, speed, radius, 1.0f).isValid();
 }
 
 void Game::spawnBackgroundParticle() {
+    ScopedAllocTag tag(AllocTag::Entities);
     static std::random_device rd;
     static std::mt19937 gen(rd());
     static std::uniform_real_distribution<float> xDis(0.0f, 480.0f);  // Full 480 width
     static std::uniform_real_distribution<float> yDis(0.0f, 853.0f);  // Full 853 height
     static std::uniform_real_distribution<float> sizeDis(1.0f, 2.5f);   // Smaller particles
     
-    sf::CircleShape particle;
-    particle.setRadius(sizeDis(gen));
-    particle.setPosition(xDis(gen), yDis(gen));
-    particle.setFillColor(sf::Color(200, 200, 200, 100));
-    backgroundParticles.push_back(particle);
+    entities.create(EntityKind::Background);
+    Archetype& background = entities.archetype(EntityKind::Background);
+    std::size_t row = background.size() - 1;
+    background.transforms[row].position = sf::Vector2f(xDis(gen), yDis(gen));
+    background.styles[row].radius = sizeDis(gen);
+    background.styles[row].fill = sf::Color(200, 200, 200, 100);
 }
 
 void Game::updateBackgroundParticles(float deltaTime) {
-    for (auto& particle : backgroundParticles) {
-        sf::Vector2f pos = particle.getPosition();
+    // Background dots scroll with the game speed, so they carry no Velocity
+    for (Transform& transform : entities.archetype(EntityKind::Background).transforms) {
+        sf::Vector2f& pos = transform.position;
         pos.y += gameSpeed * 0.3f * deltaTime;
         
         if (pos.y > 853.0f) {  // Adjusted for 853 height
@@ -527,34 +1363,12 @@ void Game::updateBackgroundParticles(float deltaTime) {
             pos.x = xDis(gen);
             pos.y = -20.0f;
         }
-        
-        particle.setPosition(pos);
-    }
-}
-
-void Game::updateExplosionParticles(float deltaTime) {
-    for (auto it = explosionParticles.begin(); it != explosionParticles.end();) {
-        it->update(deltaTime);
-        if (it->isDead()) {
-            it = explosionParticles.erase(it);
-        } else {
-            ++it;
-        }
-    }
-}
-
-void Game::updateTrailParticles(float deltaTime) {
-    for (auto it = trailParticles.begin(); it != trailParticles.end();) {
-        it->update(deltaTime);
-        if (it->isDead()) {
-            it = trailParticles.erase(it);
-        } else {
-            ++it;
-        }
     }
 }
 
 void Game::createExplosion(float x, float y) {
+    playSound(SoundId::Explosion, x, 0.7f);
+    ScopedAllocTag tag(AllocTag::Entities);
     static std::random_device rd;
     static std::mt19937 gen(rd());
     static std::uniform_real_distribution<float> velDis(-200.0f, 200.0f);
@@ -564,143 +1378,236 @@ void Game::createExplosion(float x, float y) {
         float vx = velDis(gen);
         float vy = velDis(gen);
         float life = lifeDis(gen);
-        explosionParticles.emplace_back(x, y, vx, vy, life);
+        if (!entities.create(EntityKind::Explosion).isValid()) {
+            return;
+        }
+        Archetype& explosions = entities.archetype(EntityKind::Explosion);
+        std::size_t row = explosions.size() - 1;
+        explosions.transforms[row].position = sf::Vector2f(x, y);
+        explosions.velocities[row].linear = sf::Vector2f(vx, vy);
+        explosions.lifetimes[row] = Lifetime{simulationTime + life, life};
+        explosions.styles[row].radius = 2.0f;
+        explosions.styles[row].fill = sf::Color::Yellow;
     }
 }
 
-void Game::addTrailParticle(float x, float y) {
-    trailParticles.emplace_back(x, y, 0.3f);
-}
-
-void Game::updateScreenShake(float deltaTime) {
-    if (screenShakeTime > 0) {
-        screenShakeTime -= deltaTime;
-        
+void Game::updateScreenShake() {
+    // Shake ends on the ShakeEnd timer; only the offset is refreshed per tick
+    if (isShaking) {
         static std::random_device rd;
         static std::mt19937 gen(rd());
         static std::uniform_real_distribution<float> shakeDis(-1.0f, 1.0f);
         
         screenShakeOffset.x = shakeDis(gen) * screenShakeIntensity;
         screenShakeOffset.y = shakeDis(gen) * screenShakeIntensity;
-        
-        if (screenShakeTime <= 0) {
-            screenShakeOffset = sf::Vector2f(0, 0);
-        }
     }
 }
 
 void Game::updateUI() {
-    scoreText.setString("Score: " + std::to_string(score));
-    speedText.setString("Speed: " + std::to_string(static_cast<int>(gameSpeed)));
-    livesText.setString("Lives: " + std::to_string(lives));
+    // Strings (and SFML's text geometry) are only rebuilt when a value changes
+    ScopedAllocTag tag(AllocTag::UI);
+    char buffer[32];
+    if (displayedScore != score) {
+        displayedScore = score;
+        std::snprintf(buffer, sizeof(buffer), "Score: %d", score);
+        scoreText.setString(buffer);
+    }
+    int speed = static_cast<int>(gameSpeed);
+    if (displayedSpeed != speed) {
+        displayedSpeed = speed;
+        std::snprintf(buffer, sizeof(buffer), "Speed: %d", speed);
+        speedText.setString(buffer);
+    }
+    if (displayedLives != lives) {
+        displayedLives = lives;
+        std::snprintf(buffer, sizeof(buffer), "Lives: %d", lives);
+        livesText.setString(buffer);
+    }
 }
 
-void Game::updateSpeed() {
-    if (speedClock.getElapsedTime() > speedIncrementInterval) {
-        gameSpeed += speedIncrement;
-        if (gameSpeed > maxSpeed) {
-            gameSpeed = maxSpeed;
-        }
-        
-        float newInterval = obstacleSpawnInterval.asSeconds() - 0.15f;
-        if (newInterval > 0.2f) {
-            obstacleSpawnInterval = sf::seconds(newInterval);
-        }
-        
-        // Power state for high speed
-        if (gameSpeed > 800.0f && !isInvulnerable) {
-            player.setPowerState(Player::PowerState::Overcharged, 0.5f);
-        }
-        
-        speedClock.restart();
+void Game::trackEntityMemory() {
+    for (std::size_t kind = 0; kind < entityMemoryHighWater.size(); ++kind) {
+        std::size_t bytes = entities.archetype(static_cast<EntityKind>(kind)).memoryBytes();
+        entityMemoryHighWater[kind] = std::max(entityMemoryHighWater[kind], bytes);
     }
 }
 
-void Game::checkCollisions() {
+void Game::logAllocationReport() const {
+    if (!AllocationTracker::enabled()) {
+        return;
+    }
+    
+    static const char* kindNames[] = {"obstacles", "explosion particles", "background particles"};
+    std::cout << "Entity column high-water:" << std::endl;
+    for (std::size_t kind = 0; kind < entityMemoryHighWater.size(); ++kind) {
+        std::cout << "  " << kindNames[kind] << ": " << entityMemoryHighWater[kind] << " bytes" << std::endl;
+    }
+    
+    AllocationSnapshot totals = AllocationTracker::snapshot();
+    std::cout << "Heap by subsystem (allocations, peak live bytes):" << std::endl;
+    for (std::size_t i = 0; i < static_cast<std::size_t>(AllocTag::Count); ++i) {
+        AllocTag tag = static_cast<AllocTag>(i);
+        std::cout << "  " << AllocationTracker::tagName(tag) << ": " << totals[tag].allocations
+                  << ", " << totals.peakLiveBytes[i] << std::endl;
+    }
+}
+
+void Game::stepSpeed() {
+    gameSpeed += speedIncrement;
+    if (gameSpeed > maxSpeed) {
+        gameSpeed = maxSpeed;
+    }
+    
+    float newInterval = obstacleSpawnInterval.asSeconds() - 0.15f;
+    if (newInterval > 0.2f) {
+        obstacleSpawnInterval = sf::seconds(newInterval);
+    }
+    
+    // Power state for high speed
+    if (gameSpeed > 800.0f && !isInvulnerable) {
+        setPlayerPower(Player::PowerState::Overcharged, 0.5f);
+    }
+}
+
+void Game::detectPlayerCollision() {
     if (isInvulnerable) return; // Skip collision check if invulnerable
     
-    for (auto it = obstacles.begin(); it != obstacles.end();) {
-        if (player.getBounds().intersects((*it)->getBounds())) {
-            // Create explosion at collision point
-            createExplosion(player.getPosition().x, player.getPosition().y);
-            
-            // Screen shake
-            screenShakeTime = 0.3f;
-            screenShakeIntensity = 10.0f;
-            
-            lives--;
-            if (lives <= 0) {
-                std::cout << "Game Over! Final Score: " << score << std::endl;
-                setState(GameState::GameOver);
-            } else {
-                std::cout << "Lives remaining: " << lives << std::endl;
-                // Reset player position
-                player.reset();
-                
-                // Activate invulnerability
-                isInvulnerable = true;
-                invulnerabilityTime = invulnerabilityDuration;
-                player.setPowerState(Player::PowerState::Invulnerable, invulnerabilityDuration);
-            }
-            
-            // Remove the obstacle that caused the collision
-            it = obstacles.erase(it);
-            return; // Exit after first collision to prevent multiple life losses
-        } else {
-            ++it;
+    const Archetype& obstacles = entities.archetype(EntityKind::Obstacle);
+    sf::FloatRect playerBounds = player.getBounds();
+    for (std::size_t i = 0; i < obstacles.size(); ++i) {
+        if (playerBounds.intersects(obstacleBounds(obstacles, i))) {
+            collisionEvents.push(CollisionEventType::PlayerHit, obstacles.entities[i]);
+            return; // Only the first hit counts to prevent multiple life losses
         }
     }
+    if (swarm.findContact(playerBounds) >= 0) {
+        collisionEvents.push(CollisionEventType::SwarmHit, EntityId{});
+    }
 }
 
-void Game::removeOffscreenObstacles() {
-    // Count obstacles that go offscreen (dodged) and add to score
-    int dodgedCount = 0;
-    obstacles.erase(
-        std::remove_if(obstacles.begin(), obstacles.end(),
-            [&dodgedCount](const std::unique_ptr<Obstacle>& obstacle) {
-                if (obstacle->isOffscreen()) {
-                    dodgedCount++;
-                    return true;
-                }
-                return false;
-            }),
-        obstacles.end()
-    );
+void Game::applyPlayerHit(const CollisionEvent& event) {
+    tracer.instant("collision.player");
+    if (event.type == CollisionEventType::SwarmHit) {
+        swarm.scatter(player.getPosition(), swarmScatterRadius);  // Instead of removing an obstacle
+    }
+    playSound(SoundId::PlayerHit, player.getPosition().x);
+    
+    // Create explosion at collision point
+    createExplosion(player.getPosition().x, player.getPosition().y);
+    collisionEvents.countEffect();
+    
+    // Screen shake
+    startScreenShake(0.3f, 10.0f);
+    
+    lives--;
+    if (lives <= 0) {
+        std::cout << "Game Over! Final Score: " << score << std::endl;
+        recordRun();
+        setState(GameState::GameOver);
+    } else {
+        std::cout << "Lives remaining: " << lives << std::endl;
+        // Reset player position
+        player.reset();
+        trail.clear();
+        if (autopilot) {
+            autopilot->reset();
+        }
+        
+        // Activate invulnerability
+        startInvulnerability();
+    }
     
+    // Remove the obstacle that caused the collision
+    entities.destroy(event.a);
+}
+
+void Game::detectDodges() {
+    const Archetype& obstacles = entities.archetype(EntityKind::Obstacle);
+    for (std::size_t i = 0; i < obstacles.size(); ++i) {
+        if (isObstacleOffscreen(obstacles.transforms[i])) {
+            collisionEvents.push(CollisionEventType::Dodge, obstacles.entities[i]);
+        }
+    }
+}
+
+void Game::applyDodges(int dodgedCount) {
     // Add score for dodged obstacles
     if (dodgedCount > 0) {
         score += dodgedCount;
+        playSound(SoundId::Dodge, worldWidth * 0.5f, 0.5f);
         std::cout << "Dodged " << dodgedCount << " obstacles! Score: " << score << std::endl;
         
         // Power states based on score milestones
         if (score % 10 == 0 && score > 0) {
             // Every 10 points - charging state
-            player.setPowerState(Player::PowerState::Charging, 1.0f);
+            setPlayerPower(Player::PowerState::Charging, 1.0f);
         }
         if (score % 25 == 0 && score > 0) {
             // Every 25 points - overcharged state
-            player.setPowerState(Player::PowerState::Overcharged, 2.0f);
+            setPlayerPower(Player::PowerState::Overcharged, 2.0f);
         }
     }
 }
 
+void Game::processCollisionEvents() {
+    // Events are handled in detection order: dodges, obstacle pairs, player hit
+    int dodgedCount = 0;
+    for (const auto& event : collisionEvents.getEvents()) {
+        switch (event.type) {
+            case CollisionEventType::Dodge:
+                if (entities.destroy(event.a)) {
+                    dodgedCount++;
+                }
+                break;
+                
+            case CollisionEventType::PairContact:
+                resolveObstacleContact(event);
+                break;
+                
+            case CollisionEventType::PlayerHit:
+                if (entities.isAlive(event.a)) {
+                    applyPlayerHit(event);
+                }
+                break;
+                
+            case CollisionEventType::SwarmHit:
+                applyPlayerHit(event);
+                break;
+        }
+    }
+    applyDodges(dodgedCount);
+}
+
 void Game::reset() {
-    obstacles.clear();
-    backgroundParticles.clear();
-    explosionParticles.clear();
-    trailParticles.clear();
+    entities.clear();
+    behaviours.clear();
+    collisionEvents.reset();
+    simulationTime = 0.0f;
     player.reset();
+    trail.clear();
+    if (autopilot) {
+        autopilot->reset();
+    }
     isRunning = true;
-    spawnClock.restart();
-    speedClock.restart();
     gameSpeed = 300.0f;  // Reset to initial speed
     obstacleSpawnInterval = sf::seconds(1.0f);
     speedIncrement = 40.0f;  // Reset speed increment
     speedIncrementInterval = sf::seconds(2.0f);  // Reset interval
     score = 0;
     lives = 5;  // Reset to 5 lives
-    screenShakeTime = 0.0f;
+    isShaking = false;
     screenShakeOffset = sf::Vector2f(0, 0);
+    isInvulnerable = false;
+    player.setFlashing(false);
+    
+    restartTimers();
+    if (!fixedWorldSeed) {
+        worldSeed = (static_cast<std::uint64_t>(std::random_device{}()) << 32) | std::random_device{}();
+    }
+    world.restart(worldSeed, 0.0f);
+    requestChunks();  // A tick's head start for the first chunk
+    waves.clear(worldSeed ^ 0x5741564553ull);
+    swarm.clear(worldSeed ^ 0x424F494453ull);
     
     for (int i = 0; i < 40; ++i) {  // Fewer particles for smaller screen
         spawnBackgroundParticle();
@@ -712,8 +1619,8 @@ void Game::setupMenu() {
     menuButtons.clear();
     
     // Play button
-    auto playButton = std::make_unique<Button>(font, "PLAY", 140, 300, 200, 50);
-    playButton->setOnClick([this]() { startGame(); });
+    auto playButton = std::make_unique<Button>("PLAY", 140, 300, 200, 50);
+    playButton->setOnClick([this]() { playSound(SoundId::Click); startGame(); });
     playButton->setColors(
         sf::Color(0, 150, 0, 200),    // Normal - Green
         sf::Color(0, 200, 0, 200),    // Hover - Bright Green
@@ -722,8 +1629,8 @@ void Game::setupMenu() {
     menuButtons.push_back(std::move(playButton));
     
     // Quit button
-    auto quitButton = std::make_unique<Button>(font, "QUIT", 140, 370, 200, 50);
-    quitButton->setOnClick([this]() { quitGame(); });
+    auto quitButton = std::make_unique<Button>("QUIT", 140, 370, 200, 50);
+    quitButton->setOnClick([this]() { playSound(SoundId::Click); quitGame(); });
     quitButton->setColors(
         sf::Color(150, 0, 0, 200),    // Normal - Red
         sf::Color(200, 0, 0, 200),    // Hover - Bright Red
@@ -737,8 +1644,8 @@ void Game::setupGameOverScreen() {
     gameOverButtons.clear();
     
     // Play Again button
-    auto playAgainButton = std::make_unique<Button>(font, "PLAY AGAIN", 140, 400, 200, 50);
-    playAgainButton->setOnClick([this]() { startGame(); });
+    auto playAgainButton = std::make_unique<Button>("PLAY AGAIN", 140, 400, 200, 50);
+    playAgainButton->setOnClick([this]() { playSound(SoundId::Click); startGame(); });
     playAgainButton->setColors(
         sf::Color(0, 150, 0, 200),    // Normal - Green
         sf::Color(0, 200, 0, 200),    // Hover - Bright Green
@@ -747,8 +1654,8 @@ void Game::setupGameOverScreen() {
     gameOverButtons.push_back(std::move(playAgainButton));
     
     // Main Menu button
-    auto menuButton = std::make_unique<Button>(font, "MAIN MENU", 140, 470, 200, 50);
-    menuButton->setOnClick([this]() { returnToMenu(); });
+    auto menuButton = std::make_unique<Button>("MAIN MENU", 140, 470, 200, 50);
+    menuButton->setOnClick([this]() { playSound(SoundId::Click); returnToMenu(); });
     menuButton->setColors(
         sf::Color(0, 100, 150, 200),  // Normal - Blue
         sf::Color(0, 150, 200, 200),  // Hover - Bright Blue
@@ -757,8 +1664,8 @@ void Game::setupGameOverScreen() {
     gameOverButtons.push_back(std::move(menuButton));
     
     // Quit button
-    auto quitButton = std::make_unique<Button>(font, "QUIT", 140, 540, 200, 50);
-    quitButton->setOnClick([this]() { quitGame(); });
+    auto quitButton = std::make_unique<Button>("QUIT", 140, 540, 200, 50);
+    quitButton->setOnClick([this]() { playSound(SoundId::Click); quitGame(); });
     quitButton->setColors(
         sf::Color(150, 0, 0, 200),    // Normal - Red
         sf::Color(200, 0, 0, 200),    // Hover - Bright Red
@@ -768,12 +1675,12 @@ void Game::setupGameOverScreen() {
 }
 
 void Game::startGame() {
-    currentState = GameState::Playing;
+    setState(GameState::Playing);
     reset();
 }
 
 void Game::returnToMenu() {
-    currentState = GameState::Menu;
+    setState(GameState::Menu);
     reset();
 }
 
@@ -784,4 +1691,10 @@ void Game::quitGame() {
 
 void Game::setState(GameState state) {
     currentState = state;
+    
+    // Entering a menu screen: draw it immediately and restart the idle timers
+    needsRedraw = true;
+    idleTime = 0.0f;
+    ambientElapsed = 0.0f;
+    idleMinuteElapsed = 0.0f;
 } 
\ No newline at end of file
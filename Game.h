@@ -4,7 +4,43 @@
 #include <memory>
 #include "Player.h"
 #include "Obstacle.h"
+#include "EntityStore.h"
+#include "EntitySystems.h"
+#include "PlayerTrail.h"
+#include "CollisionEvents.h"
+#include "FrameArena.h"
 #include "Button.h"
+#include "Renderer.h"
+#include "TelemetryRecorder.h"
+#include "MetricsPublisher.h"
+#include "TimerScheduler.h"
+#include "AllocationTracker.h"
+#include "FlightRecorder.h"
+#include "RenderScaleController.h"
+#include "AudioMixer.h"
+#include "Autopilot.h"
+#include "WorldStreamer.h"
+#include "WaveDirector.h"
+#include "BoidSwarm.h"
+#include "ObstacleBehaviours.h"
+#include "RollbackSession.h"
+#include "SpectatorCodec.h"
+#include "SpectatorChannel.h"
+#include "RunHistory.h"
+#include "AssetLoader.h"
+#include <array>
+#include <chrono>
+#include <string>
+#include <ctime>
+
+const char* const defaultHistoryPath = "triangle-runs.tgh";
+
+// Milliseconds from the start of Game's constructor; negative until reached
+struct StartupTimeline {
+    float windowMs = -1.0f;        // Window open (never, headless)
+    float firstFrameMs = -1.0f;    // First frame presented, placeholders and all
+    float interactiveMs = -1.0f;   // First frame with every startup asset swapped in
+};
 
 // Game states
 enum class GameState {
@@ -13,64 +49,87 @@ enum class GameState {
     GameOver
 };
 
-// Particle effect for explosions
-struct ExplosionParticle {
-    sf::CircleShape shape;
-    sf::Vector2f velocity;
-    float life;
-    float maxLife;
-    
-    ExplosionParticle(float x, float y, float vx, float vy, float lifetime);
-    void update(float deltaTime);
-    bool isDead() const;
-};
-
-// Trail particle for player
-struct TrailParticle {
-    sf::CircleShape shape;
-    float life;
-    float maxLife;
-    
-    TrailParticle(float x, float y, float lifetime);
-    void update(float deltaTime);
-    bool isDead() const;
+// Timers owned by Game's scheduler
+enum class GameTimer : std::uint32_t {
+    SpeedStep,
+    PowerExpired,
+    InvulnerabilityEnd,
+    FlashToggle,
+    ShakeEnd,
+    WaveEvent
 };
 
 class Game {
+public:
+    // World size in view units; the window matches it at render scale 1
+    static constexpr float worldWidth = 480.0f;
+    static constexpr float worldHeight = 853.0f;
+
 private:
-    sf::RenderWindow window;
+    sf::RenderWindow window;               // Only opened when no renderer is supplied
+    std::unique_ptr<Renderer> renderer;
     sf::Clock clock;
-    sf::Clock spawnClock;  // Separate clock for obstacle spawning
-    sf::Clock speedClock;  // Clock for speed increments
     sf::Time lastObstacleSpawn;
-    sf::Time obstacleSpawnInterval;
+    sf::Time obstacleSpawnInterval;    // Density of the chunks generated from now on
+    
+    // Obstacles come from chunks generated ahead on the world streamer's thread
+    WorldStreamer world;
+    std::uint64_t worldSeed;
+    bool fixedWorldSeed;
+    
+    // Scripted set pieces on top of the track, started by the WaveEvent timer
+    static constexpr float firstWaveSeconds = 12.0f;
+    static constexpr float waveIntervalSeconds = 9.0f;
+    WaveDirector waves;
+    BoidSwarm swarm;           // Flocks released by swarm waves
+    static constexpr float swarmScatterRadius = 70.0f;   // Boids cleared around the player on a hit
+    
+    // Versus mode: the shared field and both players live in the rollback session
+    std::unique_ptr<RollbackSession> versus;
+    std::uint32_t announcedRound;
+    
+    // Spectator stream: the visible state, written every tick or replayed in viewer mode
+    std::unique_ptr<SpectatorFrame> spectatorFrame;
+    std::unique_ptr<SpectatorEncoder> spectatorEncoder;
+    std::unique_ptr<SpectatorOutput> spectatorOutput;
+    std::unique_ptr<SpectatorInput> spectatorInput;
+    SpectatorDecoder spectatorDecoder;
+    std::uint32_t spectatorTick;
+    sf::Clock spectatorClock;
     
     // Game state
     GameState currentState;
     bool isRunning;
     
     Player player;
-    std::vector<std::unique_ptr<Obstacle>> obstacles;
-    std::vector<sf::CircleShape> backgroundParticles;  // Background moving particles
-    std::vector<ExplosionParticle> explosionParticles; // Explosion effects
-    std::vector<TrailParticle> trailParticles;         // Player trail
+    PlayerTrail trail;
+    EntityStore entities;      // Obstacles, explosion particles and background dots
+    ObstacleBehaviours behaviours;  // Per-kind batches for obstacles that are not straight
+    sf::CircleShape circleBrush;  // Shared drawable for every circle entity
     
-    // UI elements
-    sf::Font font;
+    // UI elements. Texts draw as placeholders until the loader delivers the font.
+    AssetLoader assets;
+    AssetHandle<FontAsset> fontAsset;
+    std::shared_ptr<FontAsset> uiFont;
+    sf::Font missingFont;      // Never loaded; texts get it when no candidate font loads
+    bool fontsApplied;
+    sf::RectangleShape textPlaceholder;
     sf::Text scoreText;
     sf::Text speedText;
     sf::Text livesText;
     sf::Text titleText;
     sf::Text gameOverText;
     sf::Text finalScoreText;
+    sf::Text leaderboardText;
     
     // Menu buttons
     std::vector<std::unique_ptr<Button>> menuButtons;
     std::vector<std::unique_ptr<Button>> gameOverButtons;
     
-    // Mouse input
+    // Mouse and keyboard input
     sf::Vector2f mousePos;
     bool mousePressed;
+    PlayerInput input;
     
     // Game state variables
     float gameSpeed;
@@ -81,50 +140,216 @@ private:
     // Visual effects
     int score;
     int lives;
-    float screenShakeTime;
+    bool isShaking;
     float screenShakeIntensity;
     sf::Vector2f screenShakeOffset;
     
     // Collision polish
-    float invulnerabilityTime;
     float invulnerabilityDuration;
     bool isInvulnerable;
     
+    // Collision events for the current tick
+    CollisionEventQueue collisionEvents;
+    float simulationTime;      // Seconds of gameplay since reset, drives effect coalescing
+    
+    // Scratch memory for the current tick, reset at the end of update()
+    static constexpr std::size_t frameArenaBytes = 64 * 1024;
+    FrameArena frameArena;
+    
+    // Fixed-step simulation and its timers
+    static constexpr float tickSeconds = 1.0f / 60.0f;
+    static constexpr int maxTicksPerFrame = 5;   // At 1x; scaled up when fast-forwarding
+    TimerScheduler timers;
+    std::vector<std::uint32_t> firedTimers;
+    TimerHandle shakeTimer;
+    TimerHandle invulnerabilityTimer;
+    TimerHandle flashTimer;
+    TimerHandle powerTimer;
+    float timeScale;
+    float tickAccumulator;
+    
+    // Optional per-frame session recording
+    std::unique_ptr<TelemetryRecorder> telemetry;
+    std::unique_ptr<MetricsPublisher> metrics;   // Live metrics in shared memory
+    std::uint32_t frameCounter;
+    std::uint64_t recordedPairsTested;   // Collision pairs tested up to the last telemetry record
+    
+    // Allocation accounting (see AllocationTracker.h)
+    std::array<std::size_t, static_cast<std::size_t>(EntityKind::Count)> entityMemoryHighWater{};
+    int displayedScore;        // Values the HUD strings were last built from
+    int displayedSpeed;
+    int displayedLives;
+    
+    // Flight recorder: always recording, dumped around frames over budget
+    static constexpr float traceWindowSeconds = 3.0f;
+    static constexpr float hitchDumpCooldown = 10.0f;   // Seconds between dumps
+    static constexpr int maxHitchDumps = 5;             // Per session
+    FlightRecorder tracer;
+    float frameBudgetMs;
+    std::string traceDirectory;
+    int hitchDumps;
+    std::uint64_t lastHitchDump;
+    
+    // Internal resolution of the gameplay layers (HUD stays native)
+    RenderScaleController renderScale;
+    
+    // Computer player; null unless setAutopilot(true). Also starts games from idle menus (attract mode).
+    static constexpr float attractDelay = 5.0f;   // Seconds of no input on a menu screen
+    std::unique_ptr<Autopilot> autopilot;
+    
+    // Every finished run, and the game-over leaderboard built from it; null unless enableHistory()
+    std::unique_ptr<RunHistory> history;
+    
+    // Sound effects; null until enableAudio(), in which case playSound is a no-op
+    std::unique_ptr<AudioMixer> audio;
+    
+    // Idle-aware menu/game-over screens
+    static constexpr float idleFrameInterval = 1.0f / 20.0f;      // Ambient animation rate
+    static constexpr float deepIdleFrameInterval = 1.0f / 4.0f;   // After deepIdleDelay without input
+    static constexpr float deepIdleDelay = 30.0f;
+    bool needsRedraw;
+    bool renderedThisFrame;
+    float idleTime;            // Seconds since the last input on a menu screen
+    float ambientElapsed;      // Seconds since the last ambient frame
+    int displayedFinalScore;
+    float idleMinuteElapsed;
+    int idleMinuteFrames;
+    std::clock_t idleMinuteCpuStart;
+    
+    std::chrono::steady_clock::time_point startupBegin;
+    StartupTimeline startup;
+    
     // Menu and UI methods
+    float startupMs() const;
+    void centerHeadings();
+    void applyFonts();
+    void noteStartupFrame();
     void setupMenu();
     void setupGameOverScreen();
-    void processMenuEvents();
-    void processGameOverEvents();
-    void updateMenu();
-    void updateGameOver();
+    void waitForScreenEvents();
+    void noteScreenInput(const sf::Event& event);
+    void handleMenuEvent(const sf::Event& event);
+    void handleGameOverEvent(const sf::Event& event);
+    bool updateAmbient(float deltaTime);
+    float ambientFrameInterval() const;
+    void trackIdleCpu(float deltaTime);
+    void updateMenu(float deltaTime);
+    void updateGameOver(float deltaTime);
     void renderMenu();
     void renderGameOver();
+    void recordRun();
+    void updateLeaderboard(std::int64_t runRecord);
     void startGame();
     void returnToMenu();
     void quitGame();
     
     // Game methods
     void processEvents();
+    void readKeyboardInput();
     void update(float deltaTime);
+    void updatePlayer(float deltaTime);
     void render();
-    void spawnObstacle();
-    void checkCollisions();
-    void removeOffscreenObstacles();
-    void updateSpeed();
+    void streamWorld();
+    void updateVersus(float deltaTime);
+    void publishSpectatorFrame();
+    void updateViewer(float deltaTime);
+    void requestChunks();
+    float forecastSpawnInterval(float secondsAhead) const;
+    void detectDodges();
+    void detectObstacleCollisions();
+    void detectPlayerCollision();
+    void processCollisionEvents();
+    void resolveObstacleContact(const CollisionEvent& event);
+    void applyPlayerHit(const CollisionEvent& event);
+    void applyDodges(int dodgedCount);
+    void stepSpeed();
+    TimerScheduler::Tick ticksFor(float seconds) const;
+    void scheduleTimer(TimerHandle& handle, float seconds, GameTimer timer);
+    void restartTimers();
+    void handleTimer(GameTimer timer);
+    void setPlayerPower(Player::PowerState state, float duration);
+    void startScreenShake(float duration, float intensity);
+    void startInvulnerability();
     void updateBackgroundParticles(float deltaTime);
     void spawnBackgroundParticle();
-    void updateExplosionParticles(float deltaTime);
-    void updateTrailParticles(float deltaTime);
     void createExplosion(float x, float y);
-    void addTrailParticle(float x, float y);
-    void updateScreenShake(float deltaTime);
+    void updateScreenShake();
     void updateUI();
-    void checkObstacleCollisions();
-    void updateInvulnerability(float deltaTime);
+    void trackEntityMemory();
+    void playSound(SoundId sound, float x = worldWidth * 0.5f, float volume = 1.0f);
+    void checkFrameBudget(std::uint64_t frameNs);
+    void publishMetrics(float frameSeconds);
+    void recordTelemetry(float deltaTime, sf::Time eventTime, sf::Time updateTime, sf::Time renderTime);
     
 public:
-    Game();
+    static constexpr std::size_t defaultObstacleCapacity = 256;
+
+    // Pass a renderer (e.g. RecordingRenderer) to run headless without a window
+    explicit Game(std::unique_ptr<Renderer> renderer = nullptr,
+                  std::size_t obstacleCapacity = defaultObstacleCapacity);
     void run();
+    bool enableTelemetry(const std::string& path);  // Call before run()
+    bool enableMetrics(const std::string& name);    // Publish live metrics, see LiveMetrics.h
+    void logAllocationReport() const;               // No-op unless built with allocation tracking
+    bool enableAudio(std::unique_ptr<AudioSink> sink);  // Call before run(); starts the mixer thread
+    const AudioMixer* getAudio() const { return audio.get(); }
+    bool enableHistory(const std::string& path);    // Record runs and show the best on game over
+    const RunHistory* getHistory() const { return history.get(); }
+    const StartupTimeline& getStartupTimeline() const { return startup; }
+    // Headless runs: block until the loader thread has finished the startup
+    // assets; the next tick() swaps them in
+    bool waitForStartupAssets(std::chrono::milliseconds timeout) const { return fontAsset.waitFor(timeout); }
+    
+    // Hitch capture: gameplay frames slower than the budget dump the last few
+    // seconds of trace events as Chrome trace JSON into the trace directory
+    void setFrameBudget(float milliseconds);
+    void setTraceDirectory(const std::string& directory);
+    FlightRecorder& getTracer() { return tracer; }
+    
+    // Render the gameplay layers at a fraction of the window resolution and
+    // upscale them; auto mode adjusts the fraction from frame-time headroom
+    void setRenderScale(float scale) { renderScale.setFixedScale(scale); }
+    void setAutoRenderScale(bool enabled) { renderScale.setAuto(enabled); }
+    float getRenderScale() const { return renderScale.getScale(); }
+    
+    // Headless driving: one update and one frame of the current state
+    void tick(float deltaTime);
+    void renderFrame();
+    void setInput(const PlayerInput& newInput) { input = newInput; }
+    GameState getState() const { return currentState; }
+    Renderer& getRenderer() { return *renderer; }
+    
+    // Simulation speed multiplier, e.g. 100 to fast-forward headless runs
+    void setTimeScale(float scale) { timeScale = scale; }
+    float getTimeScale() const { return timeScale; }
     void reset();
     void setState(GameState state);
+    
+    // Scenario setup for benchmarks: jump to a difficulty or drop obstacles directly
+    void setDifficulty(float speed, float spawnIntervalSeconds);
+    bool spawnObstacleAt(float x, float y, float speed, float radius);
+    void setWorldSeed(std::uint64_t seed);          // Same seed, same track; applies from the next reset
+    void setLives(int count) { lives = count; }     // Until the next reset
+    const WorldStreamer& getWorld() const { return world; }
+    const WaveDirector& getWaves() const { return waves; }
+    const ObstacleBehaviours& getBehaviours() const { return behaviours; }
+    float getMaxSpeed() const { return maxSpeed; }
+    float getGameSpeed() const { return gameSpeed; }
+    int getScore() const { return score; }
+    int getLives() const { return lives; }
+    
+    // Let the autopilot drive the player; it gets budgetMicros of planning per tick
+    void setAutopilot(bool enabled, float budgetMicros = Autopilot::defaultBudgetMicros);
+    const Autopilot* getAutopilot() const { return autopilot.get(); }
+    const FrameArena& getFrameArena() const { return frameArena; }
+    
+    // Play against a peer instead of alone; call before run()
+    void enableVersus(std::unique_ptr<RollbackSession> session);
+    const RollbackSession* getVersus() const { return versus.get(); }
+    
+    // Mirror the game to a file or "unix:<path>" socket, or show such a stream
+    // instead of playing (viewer mode); call before run()
+    bool enableSpectatorOutput(const std::string& target);
+    bool enableViewer(const std::string& source);
+    const SpectatorEncoder* getSpectatorEncoder() const { return spectatorEncoder.get(); }
 }; 
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// Layout of the live metrics block the game publishes in POSIX shared memory
+// (MetricsPublisher) and tools/MetricsReader reads. Fixed size, native byte
+// order, shared by both sides.
+//
+// Seqlock: the writer makes `sequence` odd, stores the fields, then makes it
+// even again. A reader copies the fields between two reads of `sequence` and
+// retries if it was odd or changed. Fields are relaxed atomics, so the
+// writer's stores are plain stores and torn reads are detected, not undefined.
+
+const std::uint32_t liveMetricsMagic = 0x4D4C4754;  // "TGLM"
+const std::uint32_t liveMetricsVersion = 1;
+const char* const defaultLiveMetricsName = "/triangle-game";
+
+// Frame-time histogram: bucket i counts frames up to liveMetricsBucketMs[i];
+// the last bucket counts everything slower
+const int liveMetricsBucketCount = 11;
+const float liveMetricsBucketMs[liveMetricsBucketCount - 1] = {
+    4.0f, 8.0f, 12.0f, 16.7f, 20.0f, 25.0f, 33.3f, 50.0f, 100.0f, 250.0f
+};
+
+struct LiveMetricsBlock {
+    // Written once when the block is created
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t blockSize;
+    std::uint32_t pid;
+
+    std::atomic<std::uint64_t> sequence;
+
+    std::atomic<std::uint64_t> frame;
+    std::atomic<std::uint64_t> heartbeatNs;       // steady_clock (CLOCK_MONOTONIC) at publish
+    std::atomic<std::uint32_t> state;             // GameState
+    std::atomic<std::int32_t> score;
+    std::atomic<std::int32_t> lives;
+    std::atomic<float> gameSpeed;
+    std::atomic<float> lastFrameMs;
+
+    // Entity counts
+    std::atomic<std::uint32_t> obstacles;
+    std::atomic<std::uint32_t> explosionParticles;
+    std::atomic<std::uint32_t> backgroundParticles;
+    std::atomic<std::uint32_t> trailSamples;
+
+    // Since the game started
+    std::atomic<std::uint64_t> pairContacts;
+    std::atomic<std::uint64_t> playerHits;
+    std::atomic<std::uint64_t> dodges;
+    std::atomic<std::uint64_t> frameBuckets[liveMetricsBucketCount];
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "live metrics need lock-free 64-bit atomics");
+static_assert(std::atomic<float>::is_always_lock_free, "live metrics need lock-free float atomics");
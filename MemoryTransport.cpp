@@ -0,0 +1,9 @@
+#include "MemoryTransport.h"
+
+std::pair<std::unique_ptr<MemoryTransport>, std::unique_ptr<MemoryTransport>> MemoryTransport::createPair() {
+    auto forward = std::make_shared<Channel>();
+    auto backward = std::make_shared<Channel>();
+    std::unique_ptr<MemoryTransport> first(new MemoryTransport(forward, backward));
+    std::unique_ptr<MemoryTransport> second(new MemoryTransport(backward, forward));
+    return std::make_pair(std::move(first), std::move(second));
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include "SpscQueue.h"
+#include "VersusTransport.h"
+#include <memory>
+#include <utility>
+
+// In-process link between two sessions; each direction is an SPSC ring, so
+// the two ends may also live on different threads.
+class MemoryTransport : public VersusTransport {
+private:
+    using Channel = SpscQueue<InputPacket, 256>;
+
+    std::shared_ptr<Channel> outgoing;
+    std::shared_ptr<Channel> incoming;
+
+    MemoryTransport(std::shared_ptr<Channel> outgoing, std::shared_ptr<Channel> incoming)
+        : outgoing(std::move(outgoing)), incoming(std::move(incoming)) {}
+
+public:
+    static std::pair<std::unique_ptr<MemoryTransport>, std::unique_ptr<MemoryTransport>> createPair();
+
+    bool send(const InputPacket& packet) override { return outgoing->push(packet); }
+    bool receive(InputPacket& packet) override { return incoming->pop(packet); }
+};
@@ -0,0 +1,137 @@
+#include "MetricsPublisher.h"
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <iostream>
+#include <new>
+
+MetricsPublisher::MetricsPublisher()
+    : block(nullptr)
+    , frameBuckets{} {
+}
+
+MetricsPublisher::~MetricsPublisher() {
+    close();
+}
+
+namespace {
+
+// Pid of the live game publishing under `name`, or 0 if the object is left
+// over from one that died without unlinking it
+std::uint32_t livePublisher(const std::string& name) {
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        return 0;
+    }
+    struct stat info;
+    void* mapping = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size >= static_cast<off_t>(sizeof(LiveMetricsBlock))) {
+        mapping = mmap(nullptr, sizeof(LiveMetricsBlock), PROT_READ, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return 0;
+    }
+    const LiveMetricsBlock& existing = *static_cast<const LiveMetricsBlock*>(mapping);
+    std::uint32_t pid = existing.magic == liveMetricsMagic ? existing.pid : 0;
+    munmap(mapping, sizeof(LiveMetricsBlock));
+    if (pid != 0 && kill(static_cast<pid_t>(pid), 0) != 0 && errno == ESRCH) {
+        pid = 0;
+    }
+    return pid;
+}
+
+} // namespace
+
+bool MetricsPublisher::open(const std::string& sharedMemoryName) {
+    close();
+
+    // Exclusive, so a second game cannot take over (and later unlink) the
+    // block of one already running; a stale one from a crash is replaced
+    int fd = shm_open(sharedMemoryName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0 && errno == EEXIST) {
+        if (std::uint32_t pid = livePublisher(sharedMemoryName)) {
+            std::cerr << "Shared memory " << sharedMemoryName << " is in use by game " << pid << std::endl;
+            return false;
+        }
+        shm_unlink(sharedMemoryName.c_str());
+        fd = shm_open(sharedMemoryName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    }
+    if (fd < 0) {
+        std::cerr << "Failed to create shared memory " << sharedMemoryName << std::endl;
+        return false;
+    }
+    if (ftruncate(fd, sizeof(LiveMetricsBlock)) != 0) {
+        ::close(fd);
+        shm_unlink(sharedMemoryName.c_str());
+        std::cerr << "Failed to size shared memory " << sharedMemoryName << std::endl;
+        return false;
+    }
+    void* mapping = mmap(nullptr, sizeof(LiveMetricsBlock), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);  // The mapping keeps the object alive
+    if (mapping == MAP_FAILED) {
+        shm_unlink(sharedMemoryName.c_str());
+        std::cerr << "Failed to map shared memory " << sharedMemoryName << std::endl;
+        return false;
+    }
+
+    // Fresh block; readers check the magic and version before trusting the rest
+    block = new (mapping) LiveMetricsBlock{};
+    block->version = liveMetricsVersion;
+    block->blockSize = sizeof(LiveMetricsBlock);
+    block->pid = static_cast<std::uint32_t>(getpid());
+    std::atomic_thread_fence(std::memory_order_release);
+    block->magic = liveMetricsMagic;
+    name = sharedMemoryName;
+    for (std::uint64_t& count : frameBuckets) {
+        count = 0;
+    }
+    return true;
+}
+
+void MetricsPublisher::close() {
+    if (!block) {
+        return;
+    }
+    munmap(block, sizeof(LiveMetricsBlock));
+    shm_unlink(name.c_str());
+    block = nullptr;
+}
+
+void MetricsPublisher::publish(const LiveMetricsSample& sample) {
+    if (!block) {
+        return;
+    }
+
+    int bucket = 0;
+    while (bucket < liveMetricsBucketCount - 1 && sample.frameMs > liveMetricsBucketMs[bucket]) {
+        bucket++;
+    }
+    frameBuckets[bucket]++;
+
+    const auto relaxed = std::memory_order_relaxed;
+    std::uint64_t sequence = block->sequence.load(relaxed);
+    block->sequence.store(sequence + 1, relaxed);   // Odd: write in progress
+    std::atomic_thread_fence(std::memory_order_release);
+
+    block->frame.store(sample.frame, relaxed);
+    block->heartbeatNs.store(sample.timestampNs, relaxed);
+    block->state.store(sample.state, relaxed);
+    block->score.store(sample.score, relaxed);
+    block->lives.store(sample.lives, relaxed);
+    block->gameSpeed.store(sample.gameSpeed, relaxed);
+    block->lastFrameMs.store(sample.frameMs, relaxed);
+    block->obstacles.store(sample.obstacles, relaxed);
+    block->explosionParticles.store(sample.explosionParticles, relaxed);
+    block->backgroundParticles.store(sample.backgroundParticles, relaxed);
+    block->trailSamples.store(sample.trailSamples, relaxed);
+    block->pairContacts.store(sample.pairContacts, relaxed);
+    block->playerHits.store(sample.playerHits, relaxed);
+    block->dodges.store(sample.dodges, relaxed);
+    block->frameBuckets[bucket].store(frameBuckets[bucket], relaxed);
+
+    block->sequence.store(sequence + 2, std::memory_order_release);  // Even: consistent
+}
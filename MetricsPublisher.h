@@ -0,0 +1,44 @@
+#pragma once
+#include "LiveMetrics.h"
+#include <string>
+
+// Values for one frame; copied into the shared block by publish()
+struct LiveMetricsSample {
+    std::uint64_t frame;
+    std::uint64_t timestampNs;
+    std::uint32_t state;
+    std::int32_t score;
+    std::int32_t lives;
+    float gameSpeed;
+    float frameMs;
+    std::uint32_t obstacles;
+    std::uint32_t explosionParticles;
+    std::uint32_t backgroundParticles;
+    std::uint32_t trailSamples;
+    std::uint64_t pairContacts;
+    std::uint64_t playerHits;
+    std::uint64_t dodges;
+};
+
+// Publishes live metrics for external readers (tools/MetricsReader).
+// open() creates and maps the shared memory object once; publish() is then
+// a handful of plain stores into the mapping - no syscalls, no allocation.
+// The object is unlinked again when the publisher is destroyed.
+class MetricsPublisher {
+private:
+    std::string name;
+    LiveMetricsBlock* block;
+    std::uint64_t frameBuckets[liveMetricsBucketCount];  // Writer's copy of the histogram
+
+public:
+    MetricsPublisher();
+    ~MetricsPublisher();
+    MetricsPublisher(const MetricsPublisher&) = delete;
+    MetricsPublisher& operator=(const MetricsPublisher&) = delete;
+
+    bool open(const std::string& sharedMemoryName);
+    void close();
+    bool isOpen() const { return block != nullptr; }
+
+    void publish(const LiveMetricsSample& sample);
+};
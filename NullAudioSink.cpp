@@ -0,0 +1,97 @@
+#include "NullAudioSink.h"
+#include <iostream>
+#include <thread>
+
+namespace {
+
+void putLittleEndian(std::FILE* file, std::uint32_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        std::fputc(static_cast<int>((value >> (8 * i)) & 0xFF), file);
+    }
+}
+
+} // namespace
+
+NullAudioSink::NullAudioSink(const std::string& wavPath, bool realTime)
+    : wavPath(wavPath)
+    , realTime(realTime)
+    , file(nullptr)
+    , sampleRate(0)
+    , channels(0)
+    , framesWritten(0)
+    , underruns(0) {
+}
+
+NullAudioSink::~NullAudioSink() {
+    stop();
+}
+
+bool NullAudioSink::start(unsigned int rate, unsigned int channelCount) {
+    sampleRate = rate;
+    channels = channelCount;
+    framesWritten = 0;
+    underruns = 0;
+
+    if (!wavPath.empty()) {
+        file = std::fopen(wavPath.c_str(), "wb");
+        if (!file) {
+            std::cerr << "Failed to open audio capture file: " << wavPath << std::endl;
+            return false;
+        }
+        // Sizes are patched in stop()
+        writeWavHeader(0);
+    }
+    clockStart = std::chrono::steady_clock::now();
+    return true;
+}
+
+void NullAudioSink::write(const std::int16_t* samples, std::size_t frameCount) {
+    if (file) {
+        std::fwrite(samples, sizeof(std::int16_t), frameCount * channels, file);
+    }
+    framesWritten += frameCount;
+    if (!realTime) {
+        return;
+    }
+
+    // The block just written "plays" until this point
+    auto played = std::chrono::duration<double>(static_cast<double>(framesWritten) / sampleRate);
+    auto deadline = clockStart + std::chrono::duration_cast<std::chrono::steady_clock::duration>(played);
+    auto now = std::chrono::steady_clock::now();
+    auto blockDuration = std::chrono::duration<double>(static_cast<double>(frameCount) / sampleRate);
+
+    if (now > deadline + blockDuration) {
+        // A device would have run dry; resync so one stall counts once
+        underruns.fetch_add(1, std::memory_order_relaxed);
+        clockStart = now - std::chrono::duration_cast<std::chrono::steady_clock::duration>(played);
+        return;
+    }
+    std::this_thread::sleep_until(deadline);
+}
+
+void NullAudioSink::stop() {
+    if (!file) {
+        return;
+    }
+    std::uint64_t dataBytes = framesWritten * channels * sizeof(std::int16_t);
+    std::fseek(file, 0, SEEK_SET);
+    writeWavHeader(static_cast<std::uint32_t>(dataBytes));
+    std::fclose(file);
+    file = nullptr;
+}
+
+void NullAudioSink::writeWavHeader(std::uint32_t dataBytes) {
+    std::uint32_t bytesPerFrame = channels * sizeof(std::int16_t);
+    std::fwrite("RIFF", 1, 4, file);
+    putLittleEndian(file, 36 + dataBytes, 4);
+    std::fwrite("WAVEfmt ", 1, 8, file);
+    putLittleEndian(file, 16, 4);               // fmt chunk size
+    putLittleEndian(file, 1, 2);                // PCM
+    putLittleEndian(file, channels, 2);
+    putLittleEndian(file, sampleRate, 4);
+    putLittleEndian(file, sampleRate * bytesPerFrame, 4);
+    putLittleEndian(file, bytesPerFrame, 2);
+    putLittleEndian(file, 16, 2);               // Bits per sample
+    std::fwrite("data", 1, 4, file);
+    putLittleEndian(file, dataBytes, 4);
+}
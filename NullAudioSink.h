@@ -0,0 +1,34 @@
+#pragma once
+#include "AudioSink.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+// Sink without a device. Paces the mixer against the wall clock like a sound
+// card would (unless realTime is false, for offline renders) and optionally
+// writes everything it receives to a 16-bit PCM WAV file.
+class NullAudioSink : public AudioSink {
+private:
+    std::string wavPath;
+    bool realTime;
+    std::FILE* file;
+    unsigned int sampleRate;
+    unsigned int channels;
+    std::uint64_t framesWritten;
+    std::chrono::steady_clock::time_point clockStart;
+    std::atomic<std::uint64_t> underruns;
+
+    void writeWavHeader(std::uint32_t dataBytes);
+
+public:
+    explicit NullAudioSink(const std::string& wavPath = "", bool realTime = true);
+    ~NullAudioSink() override;
+
+    bool start(unsigned int sampleRate, unsigned int channels) override;
+    void write(const std::int16_t* samples, std::size_t frameCount) override;
+    void stop() override;
+    std::uint64_t getUnderruns() const override { return underruns.load(std::memory_order_relaxed); }
+
+    std::uint64_t getFramesWritten() const { return framesWritten; }
+};
@@ -1,74 +1,95 @@
 #include "Obstacle.h"
+#include <algorithm>
+#include <cmath>
 #include <random>
 
-Obstacle::Obstacle(float x, float y, float baseSpeed)
-    : position(x, y)
-    , speed(baseSpeed) {
-    
+EntityId createObstacle(EntityStore& store, float x, float y, float baseSpeed) {
     // Random size between 15 and 35
     static std::random_device rd;
     static std::mt19937 gen(rd());
     static std::uniform_real_distribution<float> sizeDis(15.0f, 35.0f);
-    size = sizeDis(gen);
+    float size = sizeDis(gen);
     
     // Speed variation based on current game speed - faster game = faster obstacles
     // At low speeds: ±10% variation, at high speeds: ±5% variation
     float speedVariation = std::max(0.05f, 0.10f - (baseSpeed - 300.0f) / 900.0f * 0.05f);
     static std::uniform_real_distribution<float> speedVarDis(1.0f - speedVariation, 1.0f + speedVariation);
-    float speedMultiplier = speedVarDis(gen);
-    speed *= speedMultiplier;
+    float speed = baseSpeed * speedVarDis(gen);
     
-    // Set velocity based on speed
-    velocity = sf::Vector2f(0, speed);
+    return createObstacle(store, x, y, speed, size, speed / baseSpeed);
+}
+
+EntityId createObstacle(EntityStore& store, float x, float y, float speed, float radius, float speedRatio) {
+    EntityId id = store.create(EntityKind::Obstacle);
+    if (!id.isValid()) {
+        return id;
+    }
     
-    // Create circle shape
-    shape.setRadius(size);
-    shape.setPosition(position);
+    Archetype& obstacles = store.archetype(EntityKind::Obstacle);
+    std::size_t row = obstacles.size() - 1;  // create() appends
+    obstacles.transforms[row].position = sf::Vector2f(x, y);
+    obstacles.velocities[row].linear = sf::Vector2f(0, speed);
+    obstacles.colliders[row].radius = radius;
     
     // Set color based on speed relative to current game speed
-    float speedRatio = speed / baseSpeed;
+    RenderStyle& style = obstacles.styles[row];
     if (speedRatio < 0.9f) {
-        shape.setFillColor(sf::Color::Green);  // Slower than average - Green
+        style.fill = sf::Color::Green;    // Slower than average - Green
     } else if (speedRatio < 1.1f) {
-        shape.setFillColor(sf::Color::Yellow);  // Average speed - Yellow
+        style.fill = sf::Color::Yellow;   // Average speed - Yellow
     } else if (speedRatio < 1.3f) {
-        shape.setFillColor(sf::Color::Red);     // Faster than average - Red
+        style.fill = sf::Color::Red;      // Faster than average - Red
     } else {
-        shape.setFillColor(sf::Color::Magenta); // Much faster - Magenta
+        style.fill = sf::Color::Magenta;  // Much faster - Magenta
     }
+    style.outline = sf::Color::White;
+    style.radius = radius;
+    style.outlineThickness = 1.5f;
     
-    shape.setOutlineColor(sf::Color::White);
-    shape.setOutlineThickness(1.5f);
+    return id;
 }
 
-void Obstacle::update(float deltaTime) {
-    position += velocity * deltaTime;
-    shape.setPosition(position);
+sf::FloatRect obstacleBounds(const Archetype& obstacles, std::size_t row) {
+    const sf::Vector2f& position = obstacles.transforms[row].position;
+    float radius = obstacles.colliders[row].radius;
+    float outline = obstacles.styles[row].outlineThickness;
+    return sf::FloatRect(position.x - outline, position.y - outline,
+                         2.0f * (radius + outline), 2.0f * (radius + outline));
 }
 
-void Obstacle::setVelocity(const sf::Vector2f& newVelocity) {
-    velocity = newVelocity;
-    speed = std::sqrt(velocity.x * velocity.x + velocity.y * velocity.y);
+bool isObstacleOffscreen(const Transform& transform) {
+    return transform.position.y > 880.0f; // Below the 853p screen
 }
 
-void Obstacle::addVelocity(const sf::Vector2f& deltaVelocity) {
-    velocity += deltaVelocity;
-    speed = std::sqrt(velocity.x * velocity.x + velocity.y * velocity.y);
-}
-
-void Obstacle::setPosition(const sf::Vector2f& newPosition) {
-    position = newPosition;
-    shape.setPosition(position);
-}
-
-void Obstacle::draw(sf::RenderWindow& window) {
-    window.draw(shape);
-}
-
-void Obstacle::setColor(const sf::Color& color) {
-    shape.setFillColor(color);
+bool resolveContact(sf::Vector2f& position1, sf::Vector2f& velocity1, float radius1,
+                    sf::Vector2f& position2, sf::Vector2f& velocity2, float radius2) {
+    // Calculate collision normal
+    sf::Vector2f normal = position2 - position1;
+    float distance = std::sqrt(normal.x * normal.x + normal.y * normal.y);
+    if (distance > 0) {
+        normal /= distance;
+    }
+    
+    // Don't resolve if objects are moving apart
+    sf::Vector2f relativeVel = velocity2 - velocity1;
+    float velocityAlongNormal = relativeVel.x * normal.x + relativeVel.y * normal.y;
+    if (velocityAlongNormal > 0) {
+        return false;
+    }
+    
+    // Apply impulse
+    float restitution = 0.8f;  // Bounciness factor
+    float impulse = -(1.0f + restitution) * velocityAlongNormal;
+    sf::Vector2f impulseVector = normal * impulse;
+    velocity1 -= impulseVector;
+    velocity2 += impulseVector;
+    
+    // Separate the obstacles to prevent sticking
+    float overlap = distance - (radius1 + radius2);
+    if (overlap < 0) {
+        sf::Vector2f separation = normal * (-overlap * 0.5f);
+        position1 -= separation;
+        position2 += separation;
+    }
+    return true;
 }
-
-bool Obstacle::isOffscreen() const {
-    return position.y > 880.0f; // Below the 853p screen
-} 
\ No newline at end of file
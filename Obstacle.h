@@ -1,30 +1,25 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include "EntityStore.h"
 
-class Obstacle {
-private:
-    sf::CircleShape shape;
-    sf::Vector2f position;
-    sf::Vector2f velocity;
-    float size;
-    float speed;
-    
-public:
-    Obstacle(float x, float y, float baseSpeed);
-    void update(float deltaTime);
-    void draw(sf::RenderWindow& window);
-    void setColor(const sf::Color& color);
-    
-    // Getters
-    sf::Vector2f getPosition() const { return position; }
-    sf::FloatRect getBounds() const { return shape.getGlobalBounds(); }
-    float getSpeed() const { return speed; }
-    sf::Vector2f getVelocity() const { return velocity; }
-    bool isOffscreen() const;
-    
-    // Physics
-    void setVelocity(const sf::Vector2f& newVelocity);
-    void addVelocity(const sf::Vector2f& deltaVelocity);
-    void setPosition(const sf::Vector2f& newPosition);
-    float getSize() const { return size; }
-}; 
\ No newline at end of file
+// Obstacles are EntityKind::Obstacle rows in the EntityStore:
+// Transform, Velocity, Collider and RenderStyle.
+
+// Creates an obstacle with a random size and a speed/colour derived from baseSpeed.
+// Returns an invalid id when the obstacle archetype is full.
+EntityId createObstacle(EntityStore& store, float x, float y, float baseSpeed);
+
+// Creates an obstacle with an exact size and speed. speedRatio is the speed
+// relative to the game speed and picks the colour (green slow .. magenta fast).
+EntityId createObstacle(EntityStore& store, float x, float y, float speed, float radius, float speedRatio);
+
+// Axis-aligned box including the outline, matching sf::CircleShape::getGlobalBounds
+sf::FloatRect obstacleBounds(const Archetype& obstacles, std::size_t row);
+
+bool isObstacleOffscreen(const Transform& transform);
+
+// Elastic response (restitution 0.8) for two obstacles in contact, then
+// pushes them apart. Leaves both untouched and returns false when they are
+// already separating. Shared by Game and the autopilot's lookahead.
+bool resolveContact(sf::Vector2f& position1, sf::Vector2f& velocity1, float radius1,
+                    sf::Vector2f& position2, sf::Vector2f& velocity2, float radius2);
@@ -0,0 +1,160 @@
+#include "ObstacleBehaviours.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Outline per kind, so the player can tell them apart; the fill still shows speed
+sf::Color outlineFor(ObstacleKind kind) {
+    switch (kind) {
+        case ObstacleKind::Weaving:      return sf::Color::Cyan;
+        case ObstacleKind::Homing:       return sf::Color(255, 150, 0);
+        case ObstacleKind::Accelerating: return sf::Color(120, 160, 255);
+        case ObstacleKind::Splitting:    return sf::Color(255, 80, 200);
+        default:                         return sf::Color::White;
+    }
+}
+
+template <typename Behaviour>
+bool attachTo(BehaviourBatch<Behaviour>& batch, EntityStore& store, EntityId id, std::size_t row, float now) {
+    Archetype& obstacles = store.archetype(EntityKind::Obstacle);
+    return batch.add(store, id, Behaviour::start(now, obstacles.colliders[row], obstacles.velocities[row]));
+}
+
+} // namespace
+
+WeaveBehaviour::State WeaveBehaviour::start(float, const Collider& collider, Velocity& velocity) {
+    State state{30.0f + collider.radius, 2.4f, 0.0f, 1.0f};
+    velocity.linear.x += state.amplitude * state.angularSpeed;  // x = spawn + A sin(wt)
+    return state;
+}
+
+void WeaveBehaviour::step(State& state, const Transform&, Velocity& velocity, const Collider&,
+                          const BehaviourContext& context) {
+    // Rotate the phase by one tick's angle. It is a few hundredths of a
+    // radian, so short series are exact to float precision and no obstacle
+    // pays for a libm call.
+    float angle = state.angularSpeed * context.deltaTime;
+    float angle2 = angle * angle;
+    float cosStep = 1.0f - angle2 * (0.5f - angle2 * (1.0f / 24.0f));
+    float sinStep = angle * (1.0f - angle2 * (1.0f / 6.0f));
+    float cosPhase = state.cosPhase * cosStep - state.sinPhase * sinStep;
+    float sinPhase = state.sinPhase * cosStep + state.cosPhase * sinStep;
+    
+    // Velocity follows d/dt of A sin(phase) across the tick
+    velocity.linear.x += state.amplitude * state.angularSpeed * (cosPhase - state.cosPhase);
+    state.cosPhase = cosPhase;
+    state.sinPhase = sinPhase;
+}
+
+HomingBehaviour::State HomingBehaviour::start(float, const Collider&, Velocity&) {
+    return State{220.0f, 140.0f};
+}
+
+void HomingBehaviour::step(State& state, const Transform& transform, Velocity& velocity, const Collider& collider,
+                           const BehaviourContext& context) {
+    // Gives up once level with the player, so it can still be outrun
+    float centreX = transform.position.x + collider.radius;
+    float centreY = transform.position.y + collider.radius;
+    if (centreY > context.target.y - 100.0f) {
+        return;
+    }
+    float desired = std::min(state.maxLateral, std::max(-state.maxLateral, 1.5f * (context.target.x - centreX)));
+    float turn = state.turnRate * context.deltaTime;
+    velocity.linear.x += std::min(turn, std::max(-turn, desired - velocity.linear.x));
+}
+
+AccelerateBehaviour::State AccelerateBehaviour::start(float, const Collider&, Velocity& velocity) {
+    float speed = velocity.linear.y;
+    return State{0.6f * speed, std::min(2.0f * speed, speed + 600.0f)};
+}
+
+void AccelerateBehaviour::step(State& state, const Transform&, Velocity& velocity, const Collider&,
+                               const BehaviourContext& context) {
+    velocity.linear.y = std::min(state.maxSpeed, velocity.linear.y + state.acceleration * context.deltaTime);
+}
+
+ObstacleBehaviours::ObstacleBehaviours(std::size_t obstacleCapacity) {
+    forEachBatch([obstacleCapacity](auto& batch) { batch.reserve(obstacleCapacity); });
+}
+
+void ObstacleBehaviours::clear() {
+    forEachBatch([](auto& batch) { batch.clear(); });
+}
+
+bool ObstacleBehaviours::attach(EntityStore& store, EntityId id, ObstacleKind kind, float now) {
+    std::size_t row;
+    if (kind == ObstacleKind::Straight || kind >= ObstacleKind::Count || !store.locate(id, row)) {
+        return false;
+    }
+    store.archetype(EntityKind::Obstacle).styles[row].outline = outlineFor(kind);
+
+    // The one switch over kinds, paid per spawn rather than per tick
+    bool added = false;
+    switch (kind) {
+        case ObstacleKind::Weaving:      added = attachTo(batch<WeaveBehaviour>(), store, id, row, now); break;
+        case ObstacleKind::Homing:       added = attachTo(batch<HomingBehaviour>(), store, id, row, now); break;
+        case ObstacleKind::Accelerating: added = attachTo(batch<AccelerateBehaviour>(), store, id, row, now); break;
+        case ObstacleKind::Splitting:    added = attachTo(batch<SplitBehaviour>(), store, id, row, now); break;
+        default: break;
+    }
+    if (added) {
+        stats.spawned[static_cast<std::size_t>(kind)]++;
+    } else {
+        stats.dropped++;
+    }
+    return added;
+}
+
+void ObstacleBehaviours::update(EntityStore& store, const BehaviourContext& context) {
+    forEachBatch([&store, &context](auto& batch) { batch.update(store, context); });
+}
+
+bool ObstacleBehaviours::takeSplitting(EntityId id) {
+    if (!batch<SplitBehaviour>().remove(id)) {
+        return false;
+    }
+    stats.splits++;
+    return true;
+}
+
+std::size_t ObstacleBehaviours::size() const {
+    return std::apply([](const auto&... batch) { return (batch.size() + ...); }, batches);
+}
+
+int splitObstacle(EntityStore& store, EntityId id) {
+    std::size_t row;
+    if (!store.locate(id, row)) {
+        return 0;
+    }
+    Archetype& obstacles = store.archetype(EntityKind::Obstacle);
+    float radius = obstacles.colliders[row].radius;
+    sf::Vector2f centre = obstacles.transforms[row].position + sf::Vector2f(radius, radius);
+    sf::Vector2f velocity = obstacles.velocities[row].linear;
+    RenderStyle style = obstacles.styles[row];
+    store.destroy(id);
+
+    float childRadius = radius * SplitBehaviour::childScale;
+    if (childRadius < SplitBehaviour::minChildRadius) {
+        return 0;
+    }
+    style.radius = childRadius;
+    style.outline = sf::Color::White;
+
+    // Side by side where the parent was, just clear of each other
+    int created = 0;
+    for (float side : {-1.0f, 1.0f}) {
+        EntityId child = store.create(EntityKind::Obstacle);
+        if (!child.isValid()) {
+            break;
+        }
+        std::size_t childRow = obstacles.size() - 1;  // create() appends
+        obstacles.transforms[childRow].position =
+            centre + sf::Vector2f(side * (childRadius + 2.0f) - childRadius, -childRadius);
+        obstacles.velocities[childRow].linear = velocity + sf::Vector2f(side * SplitBehaviour::childSpread, 0.0f);
+        obstacles.colliders[childRow].radius = childRadius;
+        obstacles.styles[childRow] = style;
+        created++;
+    }
+    return created;
+}
@@ -0,0 +1,206 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "EntityStore.h"
+#include "WorldChunk.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// What every behaviour step may read besides its own obstacle
+struct BehaviourContext {
+    float time = 0.0f;          // Simulation seconds
+    float deltaTime = 0.0f;
+    sf::Vector2f target;        // Player position
+};
+
+// Behaviour policies. Each one names its kind, the state it keeps per
+// obstacle, how that state starts, and a step() run every tick for each
+// obstacle of its kind before velocities are integrated. Steps change the
+// velocity only, so impulses from collisions carry on as for straight ones.
+
+struct WeaveBehaviour {
+    static constexpr ObstacleKind kind = ObstacleKind::Weaving;
+    static constexpr bool stepsEachTick = true;
+    struct State {
+        float amplitude;        // px either side of the spawn column
+        float angularSpeed;     // rad/s
+        float sinPhase;         // Sway phase, advanced by rotation rather than sin()
+        float cosPhase;
+    };
+    static State start(float now, const Collider& collider, Velocity& velocity);
+    static void step(State& state, const Transform& transform, Velocity& velocity,
+                     const Collider& collider, const BehaviourContext& context);
+};
+
+struct HomingBehaviour {
+    static constexpr ObstacleKind kind = ObstacleKind::Homing;
+    static constexpr bool stepsEachTick = true;
+    struct State {
+        float turnRate;         // px/s² of sideways correction
+        float maxLateral;       // px/s
+    };
+    static State start(float now, const Collider& collider, Velocity& velocity);
+    static void step(State& state, const Transform& transform, Velocity& velocity,
+                     const Collider& collider, const BehaviourContext& context);
+};
+
+struct AccelerateBehaviour {
+    static constexpr ObstacleKind kind = ObstacleKind::Accelerating;
+    static constexpr bool stepsEachTick = true;
+    struct State {
+        float acceleration;     // px/s²
+        float maxSpeed;
+    };
+    static State start(float now, const Collider& collider, Velocity& velocity);
+    static void step(State& state, const Transform& transform, Velocity& velocity,
+                     const Collider& collider, const BehaviourContext& context);
+};
+
+// Only reacts to contacts (see ObstacleBehaviours::takeSplitting); no tick work
+struct SplitBehaviour {
+    static constexpr ObstacleKind kind = ObstacleKind::Splitting;
+    static constexpr bool stepsEachTick = false;
+    static constexpr float childScale = 0.7f;       // Radius of each half
+    static constexpr float childSpread = 110.0f;    // px/s sideways, away from each other
+    static constexpr float minChildRadius = 10.0f;  // Smaller halves are not spawned
+    struct State {};
+    static State start(float, const Collider&, Velocity&) { return State{}; }
+    static void step(State&, const Transform&, Velocity&, const Collider&, const BehaviourContext&) {}
+};
+
+// Every obstacle of one kind: its id and its policy state, side by side.
+// Transform and velocity stay in the obstacle archetype, so collisions,
+// dodges, drawing and the autopilot still see one kind of row. Entries for
+// destroyed obstacles are dropped when found.
+template <typename Behaviour>
+class BehaviourBatch {
+public:
+    using State = typename Behaviour::State;
+
+private:
+    std::vector<EntityId> ids;
+    std::vector<State> states;
+
+    void removeAt(std::size_t index) {
+        ids[index] = ids.back();
+        states[index] = states.back();
+        ids.pop_back();
+        states.pop_back();
+    }
+
+public:
+    void reserve(std::size_t count) {
+        ids.reserve(count);
+        states.reserve(count);
+    }
+
+    void clear() {
+        ids.clear();
+        states.clear();
+    }
+
+    std::size_t size() const { return ids.size(); }
+
+    // Never grows past the reserved size; returns false when still full
+    // after dropping dead entries
+    bool add(const EntityStore& store, EntityId id, const State& state) {
+        if (ids.size() == ids.capacity()) {
+            prune(store);
+            if (ids.size() == ids.capacity()) {
+                return false;
+            }
+        }
+        ids.push_back(id);
+        states.push_back(state);
+        return true;
+    }
+
+    bool remove(EntityId id) {
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            if (ids[i] == id) {
+                removeAt(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void prune(const EntityStore& store) {
+        for (std::size_t i = ids.size(); i > 0; --i) {
+            if (!store.isAlive(ids[i - 1])) {
+                removeAt(i - 1);
+            }
+        }
+    }
+
+    // One tight loop over the kind; the policy's step is inlined
+    void update(EntityStore& store, const BehaviourContext& context) {
+        if constexpr (Behaviour::stepsEachTick) {
+            Archetype& obstacles = store.archetype(EntityKind::Obstacle);
+            for (std::size_t i = 0; i < ids.size();) {
+                std::size_t row;
+                if (!store.locate(ids[i], row)) {
+                    removeAt(i);
+                    continue;
+                }
+                Behaviour::step(states[i], obstacles.transforms[row], obstacles.velocities[row],
+                                obstacles.colliders[row], context);
+                ++i;
+            }
+        }
+    }
+};
+
+struct BehaviourStats {
+    std::array<std::uint64_t, static_cast<std::size_t>(ObstacleKind::Count)> spawned{};
+    std::uint64_t splits = 0;
+    std::uint64_t dropped = 0;     // attach() with the kind's batch full
+};
+
+// The batches of every non-straight kind. Dispatch is static: update()
+// expands to one loop per policy and straight obstacles are in no batch, so
+// they cost nothing here. A new kind is a policy, an ObstacleKind value and
+// an entry in Batches.
+class ObstacleBehaviours {
+private:
+    using Batches = std::tuple<BehaviourBatch<WeaveBehaviour>,
+                               BehaviourBatch<HomingBehaviour>,
+                               BehaviourBatch<AccelerateBehaviour>,
+                               BehaviourBatch<SplitBehaviour>>;
+    Batches batches;
+    BehaviourStats stats;
+
+    template <typename Function>
+    void forEachBatch(Function function) {
+        std::apply([&function](auto&... batch) { (function(batch), ...); }, batches);
+    }
+
+public:
+    // Each batch can hold every obstacle at once
+    explicit ObstacleBehaviours(std::size_t obstacleCapacity);
+
+    void clear();
+
+    // Gives a freshly created obstacle its kind's behaviour and outline colour
+    bool attach(EntityStore& store, EntityId id, ObstacleKind kind, float now);
+
+    void update(EntityStore& store, const BehaviourContext& context);
+
+    // True (once) if `id` is a splitting obstacle; the caller does the split
+    bool takeSplitting(EntityId id);
+
+    template <typename Behaviour>
+    BehaviourBatch<Behaviour>& batch() { return std::get<BehaviourBatch<Behaviour>>(batches); }
+    template <typename Behaviour>
+    const BehaviourBatch<Behaviour>& batch() const { return std::get<BehaviourBatch<Behaviour>>(batches); }
+
+    std::size_t size() const;
+    const BehaviourStats& getStats() const { return stats; }
+};
+
+// Replaces a splitting obstacle with two smaller straight ones moving apart.
+// Returns how many halves were created.
+int splitObstacle(EntityStore& store, EntityId id);
@@ -1,4 +1,5 @@
 #include "Player.h"
+#include <cmath>
 
 Player::Player() 
     : position(240.0f, 650.0f)  // Moved up from 750 to 650
@@ -8,10 +9,12 @@ Player::Player()
     , targetRotation(0.0f)
     , rotationSpeed(360.0f)  // Degrees per second
     , isFlashing(false)
-    , flashTime(0.0f)
-    , currentPowerState(PowerState::Normal)
-    , powerTime(0.0f)
-    , powerDuration(0.0f) {
+    , flashVisible(true)
+    , outlineThickness(1.5f)  // Thinner outline for smaller triangle
+    , fillColor(sf::Color::White)
+    , outlineColor(sf::Color::Cyan)
+    , opacity(255)
+    , currentPowerState(PowerState::Normal) {
     
     // Create triangle shape pointing upward
     shape.setPointCount(3);
@@ -19,18 +22,12 @@ Player::Player()
     shape.setPoint(1, sf::Vector2f(-size, size));   // Bottom left
     shape.setPoint(2, sf::Vector2f(size, size));    // Bottom right
     
-    shape.setFillColor(sf::Color::White);
-    shape.setOutlineColor(sf::Color::Cyan);
-    shape.setOutlineThickness(1.5f);  // Thinner outline for smaller triangle
-    shape.setPosition(position);
-    shape.setRotation(currentRotation);
+    shape.setOutlineThickness(outlineThickness);
 }
 
 void Player::update(float deltaTime) {
     // Update rotation smoothly
     updateRotation(deltaTime);
-    updateFlashing(deltaTime);
-    updatePowerState(deltaTime);
     updateColors();
     
     // Triangle stays stationary - no automatic movement
@@ -43,23 +40,37 @@ void Player::update(float deltaTime) {
     if (position.y > 793.0f) {  // Adjusted for 853p height
         position.y = 793.0f;
     }
-    
+}
+
+void Player::draw(Renderer& renderer) {
     shape.setPosition(position);
+    shape.setRotation(currentRotation);
+    sf::Color fill = fillColor;
+    sf::Color outline = outlineColor;
+    fill.a = static_cast<sf::Uint8>(fill.a * opacity / 255);
+    outline.a = static_cast<sf::Uint8>(outline.a * opacity / 255);
+    shape.setFillColor(fill);
+    shape.setOutlineColor(outline);
+    renderer.draw(shape);
 }
 
-void Player::draw(sf::RenderWindow& window) {
-    window.draw(shape);
+sf::FloatRect Player::getBounds() const {
+    // Same box SFML reports for the rotated triangle: local bounds grown by
+    // the outline, rotated about the position, then re-boxed
+    float extent = size + outlineThickness;
+    float radians = currentRotation * 3.14159265f / 180.0f;
+    float c = std::cos(radians);
+    float s = std::sin(radians);
+    float halfWidth = extent * (std::abs(c) + std::abs(s));
+    float halfHeight = extent * (std::abs(s) + std::abs(c));
+    return sf::FloatRect(position.x - halfWidth, position.y - halfHeight, 2.0f * halfWidth, 2.0f * halfHeight);
 }
 
 void Player::reset() {
     position = sf::Vector2f(240.0f, 650.0f);  // Moved up from 750 to 650
     currentRotation = 0.0f;
     targetRotation = 0.0f;
-    shape.setPosition(position);
-    shape.setRotation(currentRotation);
     currentPowerState = PowerState::Normal;
-    powerTime = 0.0f;
-    powerDuration = 0.0f;
 }
 
 void Player::moveLeft(float deltaTime) {
@@ -67,7 +78,6 @@ void Player::moveLeft(float deltaTime) {
     if (position.x < size) {  // Adjusted for smaller triangle
         position.x = size;
     }
-    shape.setPosition(position);
     
     // Tilt left when moving left
     setTargetRotation(-30.0f);
@@ -75,10 +85,9 @@ void Player::moveLeft(float deltaTime) {
 
 void Player::moveRight(float deltaTime) {
     position.x += speed * deltaTime;
-    if (position.x > 480.0f - size) {  // Adjusted for 480 width
-        position.x = 480.0f - size;
+    if (position.x > fieldWidth - size) {  // Adjusted for 480 width
+        position.x = fieldWidth - size;
     }
-    shape.setPosition(position);
     
     // Tilt right when moving right
     setTargetRotation(30.0f);
@@ -87,10 +96,9 @@ void Player::moveRight(float deltaTime) {
 void Player::moveForward(float deltaTime) {
     // Move upward (forward in rocket terms)
     position.y -= speed * deltaTime;
-    if (position.y < 60.0f) {  // Top boundary
-        position.y = 60.0f;
+    if (position.y < topLimit) {  // Top boundary
+        position.y = topLimit;
     }
-    shape.setPosition(position);
     
     // Slight upward tilt when moving forward
     setTargetRotation(-15.0f);
@@ -99,10 +107,9 @@ void Player::moveForward(float deltaTime) {
 void Player::moveBackward(float deltaTime) {
     // Move downward (backward in rocket terms)
     position.y += speed * deltaTime;
-    if (position.y > 793.0f) {  // Bottom boundary
-        position.y = 793.0f;
+    if (position.y > bottomLimit) {  // Bottom boundary
+        position.y = bottomLimit;
     }
-    shape.setPosition(position);
     
     // Slight downward tilt when moving backward
     setTargetRotation(15.0f);
@@ -134,8 +141,6 @@ void Player::updateRotation(float deltaTime) {
     // Keep rotation in 0-360 range
     while (currentRotation >= 360.0f) currentRotation -= 360.0f;
     while (currentRotation < 0.0f) currentRotation += 360.0f;
-    
-    shape.setRotation(currentRotation);
 }
 
 void Player::setTargetRotation(float rotation) {
@@ -144,73 +149,53 @@ void Player::setTargetRotation(float rotation) {
 
 void Player::setFlashing(bool flashing) {
     isFlashing = flashing;
-    flashTime = 0.0f;
+    flashVisible = true;
 }
 
-void Player::updateFlashing(float deltaTime) {
-    if (isFlashing) {
-        flashTime += deltaTime;
-        float flashRate = 8.0f; // Flashes per second
-        bool visible = static_cast<int>(flashTime * flashRate) % 2 == 0;
-        
-        if (visible) {
-            updateColors(); // Use power colors when visible
-        } else {
-            shape.setFillColor(sf::Color::Transparent);
-            shape.setOutlineColor(sf::Color::Transparent);
-        }
-    } else {
-        updateColors(); // Use power colors when not flashing
-    }
+void Player::toggleFlash() {
+    flashVisible = !flashVisible;
 }
 
-void Player::setPowerState(PowerState state, float duration) {
+void Player::setPowerState(PowerState state) {
     currentPowerState = state;
-    powerTime = 0.0f;
-    powerDuration = duration;
-}
-
-void Player::updatePowerState(float deltaTime) {
-    if (powerDuration > 0) {
-        powerTime += deltaTime;
-        if (powerTime >= powerDuration) {
-            currentPowerState = PowerState::Normal;
-            powerDuration = 0.0f;
-        }
-    }
 }
 
 void Player::updateColors() {
-    if (isFlashing) return; // Colors handled in updateFlashing
+    // Hidden during the off phase of a flash
+    if (isFlashing && !flashVisible) {
+        fillColor = sf::Color::Transparent;
+        outlineColor = sf::Color::Transparent;
+        return;
+    }
     
     switch (currentPowerState) {
         case PowerState::Normal:
-            shape.setFillColor(sf::Color::White);
-            shape.setOutlineColor(sf::Color::Cyan);
+            fillColor = sf::Color::White;
+            outlineColor = sf::Color::Cyan;
             break;
             
         case PowerState::SpeedBoost:
             // Blue for speed boost
-            shape.setFillColor(sf::Color(100, 150, 255));
-            shape.setOutlineColor(sf::Color::White);
+            fillColor = sf::Color(100, 150, 255);
+            outlineColor = sf::Color::White;
             break;
             
         case PowerState::Invulnerable:
             // Golden for invulnerability
-            shape.setFillColor(sf::Color::Yellow);
-            shape.setOutlineColor(sf::Color::White);
+            fillColor = sf::Color::Yellow;
+            outlineColor = sf::Color::White;
             break;
             
         case PowerState::Charging:
             // Green for charging
-            shape.setFillColor(sf::Color::Green);
-            shape.setOutlineColor(sf::Color::White);
+            fillColor = sf::Color::Green;
+            outlineColor = sf::Color::White;
             break;
             
         case PowerState::Overcharged:
             // Red for overcharged
-            shape.setFillColor(sf::Color::Red);
-            shape.setOutlineColor(sf::Color::Yellow);
+            fillColor = sf::Color::Red;
+            outlineColor = sf::Color::Yellow;
             break;
     }
 } 
\ No newline at end of file
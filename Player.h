@@ -1,8 +1,22 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include "Renderer.h"
+
+// Movement keys held this tick
+struct PlayerInput {
+    bool left = false;
+    bool right = false;
+    bool forward = false;
+    bool backward = false;
+};
 
 class Player {
 public:
+    // Movement limits; x is kept within [size, fieldWidth - size]
+    static constexpr float fieldWidth = 480.0f;
+    static constexpr float topLimit = 60.0f;
+    static constexpr float bottomLimit = 793.0f;
+    
     // Power colors
     enum class PowerState {
         Normal,
@@ -13,7 +27,7 @@ public:
     };
 
 private:
-    sf::ConvexShape shape;
+    sf::ConvexShape shape;     // Render-only; configured from the fields below in draw()
     sf::Vector2f position;
     float speed;
     float size;
@@ -21,22 +35,30 @@ private:
     float targetRotation;
     float rotationSpeed;
     bool isFlashing;
-    float flashTime;
+    bool flashVisible;
+    float outlineThickness;
+    sf::Color fillColor;
+    sf::Color outlineColor;
+    sf::Uint8 opacity;         // Applied at draw time, e.g. for the rival in versus
     
     PowerState currentPowerState;
-    float powerTime;
-    float powerDuration;
     
 public:
     Player();
     void update(float deltaTime);
-    void draw(sf::RenderWindow& window);
+    void draw(Renderer& renderer);
     void reset();
     
     // Getters
     sf::Vector2f getPosition() const { return position; }
     float getSize() const { return size; }
-    sf::FloatRect getBounds() const { return shape.getGlobalBounds(); }
+    float getSpeed() const { return speed; }
+    float getRotation() const { return currentRotation; }
+    sf::FloatRect getBounds() const;
+    void setPosition(const sf::Vector2f& newPosition) { position = newPosition; }
+    void setOpacity(sf::Uint8 alpha) { opacity = alpha; }
+    void setRotation(float rotation) { currentRotation = rotation; targetRotation = rotation; }
+    bool isVisible() const { return !isFlashing || flashVisible; }
     
     // Movement (rocket-like)
     void moveLeft(float deltaTime);
@@ -45,9 +67,11 @@ public:
     void moveBackward(float deltaTime);
     void updateRotation(float deltaTime);
     void setTargetRotation(float rotation);
+    
+    // Timing of flashes and power states is driven by Game's timer scheduler
     void setFlashing(bool flashing);
-    void updateFlashing(float deltaTime);
-    void setPowerState(PowerState state, float duration = 0.0f);
-    void updatePowerState(float deltaTime);
+    void toggleFlash();
+    void setPowerState(PowerState state);
+    PowerState getPowerState() const { return currentPowerState; }
     void updateColors();
 }; 
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "PlayerTrail.h"
+#include <algorithm>
+#include <cmath>
+
+PlayerTrail::PlayerTrail(float spacing, float lifetime, float width, sf::Color color)
+    : newest(0)
+    , count(0)
+    , spacing(spacing)
+    , lifetime(lifetime)
+    , width(width)
+    , color(color) {
+}
+
+const PlayerTrail::Sample& PlayerTrail::sampleAt(std::size_t age) const {
+    return samples[(newest + maxSamples - age) % maxSamples];
+}
+
+void PlayerTrail::update(const sf::Vector2f& position, float time) {
+    // Oldest samples fall off the tail
+    while (count > 0 && time - sampleAt(count - 1).time > lifetime) {
+        count--;
+    }
+
+    if (count == 0) {
+        newest = 0;
+        samples[0] = Sample{position, time};
+        count = 1;
+        return;
+    }
+
+    // One sample per `spacing` travelled, interpolated along the move so a
+    // long tick lays down the same samples as several short ones
+    for (std::size_t emitted = 0; emitted < maxSamples; ++emitted) {
+        sf::Vector2f delta = position - samples[newest].position;
+        float distance = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+        if (distance < spacing) {
+            break;
+        }
+        sf::Vector2f next = samples[newest].position + delta * (spacing / distance);
+        newest = (newest + 1) % maxSamples;
+        samples[newest] = Sample{next, time};
+        count = std::min(count + 1, maxSamples);
+    }
+}
+
+void PlayerTrail::draw(Renderer& renderer, const sf::Vector2f& head, float time) {
+    // A lone sample is the anchor left while standing still
+    if (count < 2) {
+        return;
+    }
+
+    // Points run from the head back to the oldest sample
+    std::size_t points = count + 1;
+    auto pointAt = [&](std::size_t i) { return i == 0 ? head : sampleAt(i - 1).position; };
+    auto ageAt = [&](std::size_t i) { return i == 0 ? 0.0f : time - sampleAt(i - 1).time; };
+
+    for (std::size_t i = 0; i < points; ++i) {
+        // Tangent from the neighbouring points; the normal gives the ribbon's edges
+        sf::Vector2f tangent = pointAt(i > 0 ? i - 1 : i) - pointAt(i + 1 < points ? i + 1 : i);
+        float length = std::sqrt(tangent.x * tangent.x + tangent.y * tangent.y);
+        sf::Vector2f normal = length > 0.0f ? sf::Vector2f(-tangent.y, tangent.x) / length
+                                            : sf::Vector2f(1.0f, 0.0f);
+
+        float fade = 1.0f - std::min(1.0f, ageAt(i) / lifetime);
+        float halfWidth = 0.5f * width * fade;
+        sf::Color shade = color;
+        shade.a = static_cast<sf::Uint8>(color.a * fade);
+
+        vertices[2 * i] = sf::Vertex(pointAt(i) + normal * halfWidth, shade);
+        vertices[2 * i + 1] = sf::Vertex(pointAt(i) - normal * halfWidth, shade);
+    }
+    renderer.draw(vertices.data(), 2 * points, sf::TriangleStrip);
+}
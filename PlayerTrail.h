@@ -0,0 +1,44 @@
+#pragma once
+#include "Renderer.h"
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstddef>
+
+// Fading ribbon behind the player.
+// Samples are emitted every `spacing` units travelled (not per frame or per
+// held key) into a fixed ring and expire after `lifetime` seconds, so the
+// trail looks the same at any frame rate. Drawn as a single triangle strip
+// that narrows and fades towards its tail.
+class PlayerTrail {
+public:
+    static constexpr std::size_t maxSamples = 32;
+
+private:
+    struct Sample {
+        sf::Vector2f position;
+        float time;
+    };
+
+    std::array<Sample, maxSamples> samples;
+    std::size_t newest;        // Ring index of the most recent sample
+    std::size_t count;
+    float spacing;
+    float lifetime;
+    float width;
+    sf::Color color;
+    std::array<sf::Vertex, 2 * (maxSamples + 1)> vertices;  // Head plus every sample
+
+    const Sample& sampleAt(std::size_t age) const;  // 0 = newest
+
+public:
+    PlayerTrail(float spacing = 8.0f, float lifetime = 0.3f, float width = 7.0f,
+                sf::Color color = sf::Color::Cyan);
+
+    // Once per tick with the player's position; emits and expires samples
+    void update(const sf::Vector2f& position, float time);
+    void clear() { count = 0; }
+    std::size_t size() const { return count; }
+
+    // `head` is the player's current position; the ribbon starts there
+    void draw(Renderer& renderer, const sf::Vector2f& head, float time);
+};
@@ -0,0 +1,163 @@
+#include "RecordingRenderer.h"
+#include <fstream>
+
+namespace {
+
+const char* commandName(RecordingRenderer::CommandKind kind) {
+    switch (kind) {
+        case RecordingRenderer::CommandKind::Clear: return "clear";
+        case RecordingRenderer::CommandKind::SetView: return "view";
+        case RecordingRenderer::CommandKind::Shape: return "shape";
+        case RecordingRenderer::CommandKind::Text: return "text";
+        case RecordingRenderer::CommandKind::Vertices: return "vertices";
+    }
+    return "?";
+}
+
+const char* primitiveName(sf::PrimitiveType type) {
+    switch (type) {
+        case sf::Points: return "points";
+        case sf::Lines: return "lines";
+        case sf::LineStrip: return "line-strip";
+        case sf::Triangles: return "triangles";
+        case sf::TriangleStrip: return "triangle-strip";
+        case sf::TriangleFan: return "triangle-fan";
+        default: return "quads";
+    }
+}
+
+} // namespace
+
+RecordingRenderer::RecordingRenderer()
+    : view(sf::FloatRect(0.0f, 0.0f, 480.0f, 853.0f))
+    , layerScale(1.0f)
+    , lastDrawKind(CommandKind::Clear)
+    , recording(false)
+    , frameCount(0) {
+}
+
+void RecordingRenderer::countDraw(CommandKind kind, int drawCalls, int vertices) {
+    // Switching between shapes, glyph textures and raw batches rebinds state
+    if (kind != lastDrawKind) {
+        current.stateChanges++;
+        lastDrawKind = kind;
+    }
+    current.drawCalls += drawCalls;
+    current.vertices += vertices;
+}
+
+void RecordingRenderer::record(CommandKind kind, int drawCalls, int vertices,
+                               const sf::Vector2f& position, const sf::Color& color,
+                               const std::string& label) {
+    if (recording) {
+        commands.push_back(Command{kind, drawCalls, vertices, position, color, label});
+    }
+}
+
+void RecordingRenderer::clear(const sf::Color& color) {
+    lastDrawKind = CommandKind::Clear;
+    record(CommandKind::Clear, 0, 0, sf::Vector2f(0, 0), color, "");
+}
+
+void RecordingRenderer::setView(const sf::View& newView) {
+    view = newView;
+    current.stateChanges++;
+    record(CommandKind::SetView, 0, 0, view.getCenter(), sf::Color::Transparent, "");
+}
+
+void RecordingRenderer::draw(const sf::Shape& shape) {
+    // SFML draws the fill as a fan (points + 2) and the outline as a strip
+    int points = static_cast<int>(shape.getPointCount());
+    int drawCalls = 1;
+    int vertices = points + 2;
+    if (shape.getOutlineThickness() != 0.0f) {
+        drawCalls++;
+        vertices += (points + 1) * 2;
+    }
+
+    countDraw(CommandKind::Shape, drawCalls, vertices);
+    record(CommandKind::Shape, drawCalls, vertices, shape.getPosition(), shape.getFillColor(), "");
+}
+
+void RecordingRenderer::draw(const sf::Text& text) {
+    std::string string = text.getString().toAnsiString();
+
+    // Six vertices per visible glyph
+    int glyphs = 0;
+    for (char c : string) {
+        if (c != ' ' && c != '\t' && c != '\n') {
+            glyphs++;
+        }
+    }
+
+    // SFML regenerates text geometry lazily when the string or size changed
+    TextGeometry& cached = textCache[&text];
+    if (cached.string != string || cached.characterSize != text.getCharacterSize()) {
+        cached.string = string;
+        cached.characterSize = text.getCharacterSize();
+        current.textRebuilds++;
+    }
+
+    countDraw(CommandKind::Text, 1, glyphs * 6);
+    record(CommandKind::Text, 1, glyphs * 6, text.getPosition(), text.getFillColor(), string);
+}
+
+void RecordingRenderer::draw(const sf::Vertex* vertices, std::size_t count, sf::PrimitiveType type) {
+    int vertexCount = static_cast<int>(count);
+    sf::Vector2f position = count > 0 ? vertices[0].position : sf::Vector2f(0, 0);
+    sf::Color color = count > 0 ? vertices[0].color : sf::Color::Transparent;
+
+    countDraw(CommandKind::Vertices, 1, vertexCount);
+    record(CommandKind::Vertices, 1, vertexCount, position, color, primitiveName(type));
+}
+
+void RecordingRenderer::display() {
+    finishFrame();
+    lastCommands.swap(commands);
+    commands.clear();
+    frameCount++;
+}
+
+void RecordingRenderer::beginScaledLayer(float scale) {
+    layerScale = scale;
+}
+
+void RecordingRenderer::endScaledLayer() {
+    // The upscale is one textured quad plus a view switch there and back
+    if (layerScale < 0.999f) {
+        current.stateChanges += 2;
+        countDraw(CommandKind::Vertices, 1, 4);
+        record(CommandKind::Vertices, 1, 4, sf::Vector2f(0, 0), sf::Color::White, "scaled-layer");
+    }
+    layerScale = 1.0f;
+}
+
+bool RecordingRenderer::writeLastFrame(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+
+    const RenderStats& stats = getFrameStats();
+    out << "# frame " << frameCount
+        << " draws=" << stats.drawCalls
+        << " vertices=" << stats.vertices
+        << " stateChanges=" << stats.stateChanges
+        << " textRebuilds=" << stats.textRebuilds << "\n";
+
+    for (const auto& command : lastCommands) {
+        out << commandName(command.kind)
+            << " draws=" << command.drawCalls
+            << " vertices=" << command.vertices
+            << " pos=" << command.position.x << "," << command.position.y
+            << " color=" << static_cast<int>(command.color.r) << ","
+            << static_cast<int>(command.color.g) << ","
+            << static_cast<int>(command.color.b) << ","
+            << static_cast<int>(command.color.a);
+        if (!command.label.empty()) {
+            out << " \"" << command.label << "\"";
+        }
+        out << "\n";
+    }
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include "Renderer.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Null backend: nothing reaches the GPU. Draws are counted the way SFML 2
+// would submit them (fill + outline for shapes, six vertices per glyph for
+// text) and can optionally be recorded as a per-frame command list.
+class RecordingRenderer : public Renderer {
+public:
+    enum class CommandKind {
+        Clear,
+        SetView,
+        Shape,
+        Text,
+        Vertices
+    };
+
+    struct Command {
+        CommandKind kind;
+        int drawCalls;
+        int vertices;
+        sf::Vector2f position;
+        sf::Color color;
+        std::string label;  // Text string, or primitive type for vertex batches
+    };
+
+private:
+    struct TextGeometry {
+        std::string string;
+        unsigned int characterSize;
+    };
+
+    sf::View view;
+    float layerScale;                     // Scale of the open scaled layer, 1 when none
+    CommandKind lastDrawKind;
+    bool recording;
+    int frameCount;
+    std::vector<Command> commands;        // Frame being built
+    std::vector<Command> lastCommands;    // Last frame finished by display()
+    std::unordered_map<const sf::Text*, TextGeometry> textCache;
+
+    void countDraw(CommandKind kind, int drawCalls, int vertices);
+    void record(CommandKind kind, int drawCalls, int vertices,
+                const sf::Vector2f& position, const sf::Color& color, const std::string& label);
+
+public:
+    RecordingRenderer();
+
+    void clear(const sf::Color& color) override;
+    void setView(const sf::View& view) override;
+    const sf::View& getView() const override { return view; }
+    void draw(const sf::Shape& shape) override;
+    void draw(const sf::Text& text) override;
+    void draw(const sf::Vertex* vertices, std::size_t count, sf::PrimitiveType type) override;
+    void display() override;
+    void beginScaledLayer(float scale) override;
+    void endScaledLayer() override;
+
+    // Command capture is off by default so counting stays cheap
+    void setRecording(bool enabled) { recording = enabled; }
+    const std::vector<Command>& getLastCommands() const { return lastCommands; }
+    bool writeLastFrame(const std::string& path) const;
+    int getFrameCount() const { return frameCount; }
+};
@@ -0,0 +1,86 @@
+#include "RenderScaleController.h"
+#include <algorithm>
+
+constexpr float RenderScaleController::levels[];
+
+RenderScaleController::RenderScaleController(float targetFrameSeconds)
+    : targetFrameSeconds(targetFrameSeconds)
+    , autoMode(false)
+    , fixedScale(1.0f)
+    , level(0)
+    , windowElapsed(0.0f)
+    , windowFrames(0)
+    , windowMisses(0)
+    , cleanSeconds(0.0f)
+    , upscaleDelay(baseUpscaleDelay)
+    , sinceUpscale(maxUpscaleDelay) {
+}
+
+void RenderScaleController::setFixedScale(float scale) {
+    autoMode = false;
+    fixedScale = std::min(1.0f, std::max(0.25f, scale));
+}
+
+void RenderScaleController::setAuto(bool enabled) {
+    autoMode = enabled;
+    level = 0;
+    windowElapsed = 0.0f;
+    windowFrames = 0;
+    windowMisses = 0;
+    cleanSeconds = 0.0f;
+    upscaleDelay = baseUpscaleDelay;
+}
+
+float RenderScaleController::getScale() const {
+    return autoMode ? levels[level] : fixedScale;
+}
+
+bool RenderScaleController::addFrame(float frameSeconds) {
+    if (!autoMode) {
+        return false;
+    }
+
+    windowElapsed += frameSeconds;
+    sinceUpscale += frameSeconds;
+    windowFrames++;
+    if (frameSeconds > targetFrameSeconds * missFactor) {
+        windowMisses++;
+    }
+    if (windowElapsed < windowSeconds) {
+        return false;
+    }
+
+    // End of an evaluation window
+    float missRatio = static_cast<float>(windowMisses) / static_cast<float>(windowFrames);
+    float elapsed = windowElapsed;
+    windowElapsed = 0.0f;
+    windowFrames = 0;
+    windowMisses = 0;
+
+    if (missRatio > missRatioToDrop) {
+        cleanSeconds = 0.0f;
+        if (level + 1 >= levelCount) {
+            return false;
+        }
+        // Dropping right after a step up: that level is too expensive, back off longer
+        if (sinceUpscale < 2.0f * windowSeconds) {
+            upscaleDelay = std::min(upscaleDelay * 2.0f, maxUpscaleDelay);
+        }
+        level++;
+        return true;
+    }
+
+    if (missRatio > 0.0f) {
+        cleanSeconds = 0.0f;
+        return false;
+    }
+
+    cleanSeconds += elapsed;
+    if (level > 0 && cleanSeconds >= upscaleDelay) {
+        level--;
+        cleanSeconds = 0.0f;
+        sinceUpscale = 0.0f;
+        return true;
+    }
+    return false;
+}
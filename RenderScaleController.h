@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+
+// Chooses the internal render scale for the gameplay layers.
+// Fixed mode always returns the configured scale. Auto mode watches frame
+// times against the target period: when too many frames in an evaluation
+// window miss it, the scale steps down a level; after a stretch without
+// misses it steps back up. Frame time is used rather than render time because
+// with vsync and software GL the rasterisation cost lands in display().
+// A step up that immediately misses again doubles the wait before the next
+// attempt, so the scale does not oscillate.
+class RenderScaleController {
+private:
+    static constexpr float levels[] = {1.0f, 0.85f, 0.7f, 0.5f};
+    static constexpr std::size_t levelCount = sizeof(levels) / sizeof(levels[0]);
+    static constexpr float windowSeconds = 2.0f;        // Evaluation window
+    static constexpr float missFactor = 1.25f;          // Frame counts as missed above target * this
+    static constexpr float missRatioToDrop = 0.1f;
+    static constexpr float baseUpscaleDelay = 6.0f;     // Seconds without misses before stepping up
+    static constexpr float maxUpscaleDelay = 60.0f;
+
+    float targetFrameSeconds;
+    bool autoMode;
+    float fixedScale;
+    std::size_t level;
+
+    float windowElapsed;
+    int windowFrames;
+    int windowMisses;
+    float cleanSeconds;       // Consecutive time in windows without misses
+    float upscaleDelay;
+    float sinceUpscale;       // Time since the last step up
+
+public:
+    explicit RenderScaleController(float targetFrameSeconds = 1.0f / 60.0f);
+
+    void setFixedScale(float scale);   // Clamped to [0.25, 1]; leaves auto mode
+    void setAuto(bool enabled);
+    bool isAuto() const { return autoMode; }
+    float getScale() const;
+
+    // Feed one frame's wall time; returns true when the scale changed
+    bool addFrame(float frameSeconds);
+};
@@ -0,0 +1,55 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+
+// Per-frame render counters
+struct RenderStats {
+    int drawCalls = 0;
+    int vertices = 0;
+    int stateChanges = 0;  // View switches and shape/text/vertex-batch transitions
+    int textRebuilds = 0;  // Text draws whose geometry had to be regenerated
+};
+
+// Upper limits a scene is expected to stay under
+struct RenderBudget {
+    int maxDrawCalls;
+    int maxVertices;
+
+    bool allows(const RenderStats& stats) const {
+        return stats.drawCalls <= maxDrawCalls && stats.vertices <= maxVertices;
+    }
+};
+
+// Thin drawing interface used by Game and its widgets.
+// SfmlRenderer draws into the window; RecordingRenderer only counts and
+// records, so render cost can be measured without a display.
+class Renderer {
+protected:
+    RenderStats current;    // Frame being built
+    RenderStats lastFrame;  // Last frame finished by display()
+
+    void finishFrame() {
+        lastFrame = current;
+        current = RenderStats{};
+    }
+
+public:
+    virtual ~Renderer() {}
+
+    virtual void clear(const sf::Color& color) = 0;
+    virtual void setView(const sf::View& view) = 0;
+    virtual const sf::View& getView() const = 0;
+    virtual void draw(const sf::Shape& shape) = 0;
+    virtual void draw(const sf::Text& text) = 0;
+    virtual void draw(const sf::Vertex* vertices, std::size_t count, sf::PrimitiveType type) = 0;
+    virtual void display() = 0;
+
+    // Draws between these go to an offscreen target at `scale` of the window
+    // resolution and are upscaled onto the window in endScaledLayer(). Used
+    // for the gameplay layers so the HUD stays at native resolution. A scale
+    // of 1 (or a backend without offscreen targets) draws straight through.
+    virtual void beginScaledLayer(float scale) { (void)scale; }
+    virtual void endScaledLayer() {}
+
+    const RenderStats& getFrameStats() const { return lastFrame; }
+};
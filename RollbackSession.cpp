@@ -0,0 +1,185 @@
+#include "RollbackSession.h"
+#include <algorithm>
+#include <chrono>
+
+RollbackSession::RollbackSession(std::unique_ptr<VersusTransport> transport, int localSide, std::uint64_t seed,
+                                 VersusPhysics physics)
+    : transport(std::move(transport))
+    , localSide(localSide)
+    , simulation(seed, physics)
+    , currentTick(0)
+    , confirmedTick(0)
+    , peerAck(0)
+    , firstMismatch(noMismatch)
+    , recordedTick(1)
+    , lastRemoteInput(0)
+    , peerChecksumTick(0)
+    , peerChecksum(0) {
+    localInputs.fill(0);
+    remoteInputs.fill(0);
+    remoteKnown.fill(false);
+    confirmedChecksums.fill(0);
+    confirmedChecksumTicks.fill(0);
+    for (VersusState& snapshot : snapshots) {
+        simulation.prepareSnapshot(snapshot);
+    }
+}
+
+bool RollbackSession::advance(const PlayerInput& input) {
+    receivePackets();
+    if (firstMismatch != noMismatch) {
+        rollback();
+    } else {
+        stats.lastDepth = 0;
+        stats.lastResimMicros = 0.0f;
+    }
+    recordConfirmed();
+    checkPeerChecksum();
+
+    // Too far ahead of the peer: wait rather than predict further
+    if (currentTick >= confirmedTick + maxRollbackTicks) {
+        stats.stalls++;
+        sendInputs();
+        return false;
+    }
+
+    localInputs[currentTick % historyTicks] = encodeInput(input);
+    simulateTick(currentTick);
+    currentTick++;
+    stats.ticks++;
+    sendInputs();
+    return true;
+}
+
+void RollbackSession::receivePackets() {
+    InputPacket packet;
+    while (transport->receive(packet)) {
+        stats.packetsReceived++;
+        peerAck = std::max(peerAck, packet.ackTick);
+        for (std::uint32_t i = 0; i < packet.count && i < InputPacket::maxInputs; ++i) {
+            acceptRemoteInput(packet.firstTick + i, packet.inputs[i]);
+        }
+        if (peerChecksumTick == 0) {  // Hold one until it can be compared
+            peerChecksumTick = packet.checksumTick;
+            peerChecksum = packet.checksum;
+        }
+    }
+}
+
+void RollbackSession::recordConfirmed() {
+    // States up to the confirmed tick are final; hash each once while its
+    // snapshot is still in the ring
+    std::uint32_t last = getConfirmedTick();
+    for (; recordedTick <= last; ++recordedTick) {
+        std::uint32_t slot = recordedTick % historyTicks;
+        confirmedChecksumTicks[slot] = recordedTick;
+        confirmedChecksums[slot] = recordedTick == currentTick
+            ? simulation.checksum()
+            : simulation.checksum(snapshots[recordedTick % snapshotCount]);
+    }
+}
+
+void RollbackSession::checkPeerChecksum() {
+    std::uint32_t tick = peerChecksumTick;
+    std::uint32_t slot = tick % historyTicks;
+    if (tick == 0 || confirmedChecksumTicks[slot] < tick) {
+        return;  // Not final here yet
+    }
+    if (confirmedChecksumTicks[slot] > tick) {
+        peerChecksumTick = 0;  // Too old to compare
+        return;
+    }
+    if (confirmedChecksums[slot] != peerChecksum) {
+        stats.desyncs++;
+    }
+    peerChecksumTick = 0;
+}
+
+void RollbackSession::acceptRemoteInput(std::uint32_t tick, std::uint8_t bits) {
+    // Already confirmed, or too far ahead to hold
+    if (tick < confirmedTick || tick >= confirmedTick + historyTicks) {
+        return;
+    }
+    std::uint32_t slot = tick % historyTicks;
+    if (remoteKnown[slot]) {
+        return;
+    }
+    if (tick < currentTick && remoteInputs[slot] != bits) {
+        firstMismatch = std::min(firstMismatch, tick);
+    }
+    remoteInputs[slot] = bits;
+    remoteKnown[slot] = true;
+
+    while (remoteKnown[confirmedTick % historyTicks]) {
+        lastRemoteInput = remoteInputs[confirmedTick % historyTicks];
+        remoteKnown[confirmedTick % historyTicks] = false;  // Slot is free for tick + historyTicks
+        confirmedTick++;
+    }
+}
+
+std::uint8_t RollbackSession::predictRemote(std::uint32_t tick) const {
+    std::uint32_t slot = tick % historyTicks;
+    if (tick < confirmedTick || remoteKnown[slot]) {
+        return remoteInputs[slot];
+    }
+    return lastRemoteInput;
+}
+
+void RollbackSession::simulateTick(std::uint32_t tick) {
+    std::uint32_t slot = tick % historyTicks;
+    remoteInputs[slot] = predictRemote(tick);
+    simulation.save(snapshots[tick % snapshotCount]);
+
+    PlayerInput local = decodeInput(localInputs[slot]);
+    PlayerInput remote = decodeInput(remoteInputs[slot]);
+    if (localSide == 0) {
+        simulation.step(local, remote);
+    } else {
+        simulation.step(remote, local);
+    }
+}
+
+void RollbackSession::rollback() {
+    auto begin = std::chrono::steady_clock::now();
+    std::uint32_t from = firstMismatch;
+    firstMismatch = noMismatch;
+
+    // The stall rule keeps every unconfirmed tick inside the snapshot ring
+    simulation.load(snapshots[from % snapshotCount]);
+    for (std::uint32_t tick = from; tick < currentTick; ++tick) {
+        simulateTick(tick);
+    }
+
+    float micros = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - begin).count();
+    std::uint32_t depth = currentTick - from;
+    stats.rollbacks++;
+    stats.resimulatedTicks += depth;
+    stats.lastDepth = depth;
+    stats.maxDepth = std::max(stats.maxDepth, depth);
+    stats.lastResimMicros = micros;
+    stats.maxResimMicros = std::max(stats.maxResimMicros, micros);
+}
+
+void RollbackSession::sendInputs() {
+    InputPacket packet;
+    std::uint32_t first = std::max(peerAck, currentTick > InputPacket::maxInputs ? currentTick - InputPacket::maxInputs : 0u);
+    packet.firstTick = first;
+    packet.count = static_cast<std::uint8_t>(currentTick - first);
+    for (std::uint32_t i = 0; i < packet.count; ++i) {
+        packet.inputs[i] = localInputs[(first + i) % historyTicks];
+    }
+    packet.ackTick = confirmedTick;
+    packet.checksumTick = getConfirmedTick();
+    packet.checksum = getConfirmedChecksum();
+    if (transport->send(packet)) {
+        stats.packetsSent++;
+    }
+}
+
+std::uint64_t RollbackSession::getConfirmedChecksum() const {
+    std::uint32_t tick = getConfirmedTick();
+    if (tick == currentTick) {
+        return simulation.checksum();
+    }
+    return simulation.checksum(snapshots[tick % snapshotCount]);
+}
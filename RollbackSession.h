@@ -0,0 +1,82 @@
+#pragma once
+#include "VersusSimulation.h"
+#include "VersusTransport.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+
+struct RollbackStats {
+    std::uint64_t ticks = 0;
+    std::uint64_t rollbacks = 0;
+    std::uint64_t resimulatedTicks = 0;
+    std::uint32_t lastDepth = 0;          // Ticks re-simulated in the last advance()
+    std::uint32_t maxDepth = 0;
+    float lastResimMicros = 0.0f;         // Cost of that re-simulation
+    float maxResimMicros = 0.0f;
+    std::uint64_t stalls = 0;             // advance() calls that waited for the peer
+    std::uint64_t packetsSent = 0;
+    std::uint64_t packetsReceived = 0;
+    std::uint64_t desyncs = 0;            // Peer's confirmed checksum differed from ours
+};
+
+// Rollback netcode for VersusSimulation.
+// Each tick the local input is applied at once and sent to the peer; the
+// peer's input for that tick is predicted by repeating its last known one.
+// When the real input arrives and differs, the state saved before that tick
+// is restored and the ticks since are re-simulated with the corrected
+// inputs, all within the same advance() call. The local side runs at most
+// maxRollbackTicks ahead of the last confirmed remote input and otherwise
+// stalls, which bounds both the snapshot ring and the re-simulation cost.
+class RollbackSession {
+public:
+    static constexpr std::uint32_t maxRollbackTicks = 8;
+
+private:
+    static constexpr std::uint32_t historyTicks = 64;     // Input ring; power of two
+    static constexpr std::uint32_t snapshotCount = maxRollbackTicks + 1;
+
+    std::unique_ptr<VersusTransport> transport;
+    int localSide;
+    VersusSimulation simulation;
+    std::array<VersusState, snapshotCount> snapshots;      // State at the start of tick t
+    std::array<std::uint8_t, historyTicks> localInputs;
+    std::array<std::uint8_t, historyTicks> remoteInputs;   // Actual when known, else the prediction used
+    std::array<bool, historyTicks> remoteKnown;
+    std::array<std::uint64_t, historyTicks> confirmedChecksums;   // Our final states, by tick
+    std::array<std::uint32_t, historyTicks> confirmedChecksumTicks;
+
+    std::uint32_t currentTick;       // Next tick to simulate
+    std::uint32_t confirmedTick;     // Every remote input before this tick is known
+    std::uint32_t peerAck;           // Peer has our inputs before this tick
+    std::uint32_t firstMismatch;     // Earliest mispredicted tick, or noMismatch
+    std::uint32_t recordedTick;      // Next confirmed tick to checksum
+    std::uint8_t lastRemoteInput;
+    std::uint32_t peerChecksumTick;  // Latest confirmed checksum from the peer
+    std::uint64_t peerChecksum;
+    RollbackStats stats;
+
+    static constexpr std::uint32_t noMismatch = 0xFFFFFFFFu;
+
+    void receivePackets();
+    void acceptRemoteInput(std::uint32_t tick, std::uint8_t bits);
+    void rollback();
+    void recordConfirmed();
+    void checkPeerChecksum();
+    void simulateTick(std::uint32_t tick);
+    void sendInputs();
+    std::uint8_t predictRemote(std::uint32_t tick) const;
+
+public:
+    RollbackSession(std::unique_ptr<VersusTransport> transport, int localSide, std::uint64_t seed,
+                    VersusPhysics physics = VersusPhysics::Float);
+
+    // Simulates one tick with the local input. Returns false when stalled
+    // waiting for the peer; the input is then not consumed.
+    bool advance(const PlayerInput& input);
+
+    int getLocalSide() const { return localSide; }
+    std::uint32_t getConfirmedTick() const { return confirmedTick < currentTick ? confirmedTick : currentTick; }
+    std::uint64_t getConfirmedChecksum() const;   // State at getConfirmedTick(); final on both peers
+    VersusSimulation& getSimulation() { return simulation; }
+    const RollbackStats& getStats() const { return stats; }
+};
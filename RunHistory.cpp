@@ -0,0 +1,324 @@
+#include "RunHistory.h"
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstddef>
+#include <ctime>
+#include <iostream>
+
+namespace {
+
+const std::uint32_t historyMagic = 0x48524754;   // "TGRH"
+const std::uint32_t historyVersion = 1;
+const std::size_t pageBytes = 4096;
+const std::uint32_t initialRecords = 1024;
+
+std::uint32_t fnv1a(const void* data, std::size_t bytes) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    std::uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < bytes; ++i) {
+        hash = (hash ^ p[i]) * 16777619u;
+    }
+    return hash;
+}
+
+} // namespace
+
+struct RunHistory::FileHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t recordBytes;
+    std::uint32_t topCapacity;
+    std::uint32_t dayCapacity;
+    std::uint32_t reserved;
+};
+
+struct RunHistory::CommitSlot {
+    std::uint64_t sequence;
+    std::uint32_t count;           // Committed records
+    std::uint32_t dayCount;        // Committed entries in the day table
+    RunDay today;                  // Day in progress; runs == 0 before the first run
+    std::uint32_t topCount;
+    std::uint32_t top[topCapacity];
+    std::uint32_t checksum;        // Over everything above
+};
+
+namespace {
+
+const std::size_t slotOffset = pageBytes;                 // Two slots, one page each
+const std::size_t daysOffset = 3 * pageBytes;
+const std::size_t recordsOffset = daysOffset + RunHistory::dayCapacity * sizeof(RunDay);
+
+} // namespace
+
+RunHistory::RunHistory()
+    : fd(-1)
+    , mapping(nullptr)
+    , mappedBytes(0)
+    , recordCapacity(0)
+    , activeSlot(0)
+    , syncCommits(true)
+    , readOnly(false) {
+    static_assert(sizeof(CommitSlot) <= pageBytes, "commit slot must fit a page");
+    static_assert(recordsOffset % pageBytes == 0, "records must start on a page");
+}
+
+RunHistory::~RunHistory() {
+    close();
+}
+
+RunHistory::CommitSlot* RunHistory::slot(int index) const {
+    return reinterpret_cast<CommitSlot*>(mapping + slotOffset + index * pageBytes);
+}
+
+RunDay* RunHistory::days() const {
+    return reinterpret_cast<RunDay*>(mapping + daysOffset);
+}
+
+RunRecord* RunHistory::records() const {
+    return reinterpret_cast<RunRecord*>(mapping + recordsOffset);
+}
+
+bool RunHistory::open(const std::string& filePath, bool readOnlyAccess) {
+    close();
+
+    readOnly = readOnlyAccess;
+    fd = readOnly ? ::open(filePath.c_str(), O_RDONLY) : ::open(filePath.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        std::cerr << "Failed to open run history " << filePath << std::endl;
+        return false;
+    }
+    if (!readOnly && flock(fd, LOCK_EX | LOCK_NB) != 0) {
+        std::cerr << "Run history " << filePath << " is in use by another game" << std::endl;
+        close();
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close();
+        return false;
+    }
+
+    std::size_t fileBytes = static_cast<std::size_t>(info.st_size);
+    bool fresh = fileBytes == 0;
+    if (fresh && !readOnly) {
+        fileBytes = recordsOffset + initialRecords * sizeof(RunRecord);
+        if (ftruncate(fd, static_cast<off_t>(fileBytes)) != 0) {
+            std::cerr << "Failed to size run history " << filePath << std::endl;
+            close();
+            return false;
+        }
+    } else if (fileBytes < recordsOffset) {
+        std::cerr << filePath << " is not a run history" << std::endl;
+        close();
+        return false;
+    }
+    if (!mapFile(fileBytes)) {
+        std::cerr << "Failed to map run history " << filePath << std::endl;
+        close();
+        return false;
+    }
+
+    FileHeader* header = reinterpret_cast<FileHeader*>(mapping);
+    if (fresh) {
+        // Slot 1 stays zeroed, which never passes the checksum
+        CommitSlot* first = slot(0);
+        *first = CommitSlot{};
+        first->sequence = 1;
+        first->checksum = fnv1a(first, offsetof(CommitSlot, checksum));
+        *header = FileHeader{historyMagic, historyVersion, sizeof(RunRecord), topCapacity, dayCapacity, 0};
+        if (msync(mapping, recordsOffset, MS_SYNC) != 0) {
+            std::cerr << "Failed to write run history " << filePath << std::endl;
+        }
+    } else if (header->magic != historyMagic || header->version != historyVersion ||
+               header->recordBytes != sizeof(RunRecord) || header->topCapacity != topCapacity ||
+               header->dayCapacity != dayCapacity) {
+        std::cerr << filePath << " is not a run history this build can read" << std::endl;
+        close();
+        return false;
+    }
+
+    // The current commit: the newer of the two slots that check out
+    activeSlot = -1;
+    for (int index = 0; index < 2; ++index) {
+        const CommitSlot& candidate = *slot(index);
+        bool valid = candidate.checksum == fnv1a(&candidate, offsetof(CommitSlot, checksum)) &&
+                     candidate.count <= recordCapacity && candidate.dayCount <= dayCapacity &&
+                     candidate.topCount <= topCapacity;
+        if (valid && (activeSlot < 0 || candidate.sequence > slot(activeSlot)->sequence)) {
+            activeSlot = index;
+        }
+    }
+    if (activeSlot < 0) {
+        std::cerr << "Run history " << filePath << " has no intact commit" << std::endl;
+        close();
+        return false;
+    }
+    path = filePath;
+    return true;
+}
+
+void RunHistory::close() {
+    if (mapping) {
+        munmap(mapping, mappedBytes);
+        mapping = nullptr;
+        mappedBytes = 0;
+        recordCapacity = 0;
+    }
+    if (fd >= 0) {
+        ::close(fd);   // Also drops the lock
+        fd = -1;
+    }
+}
+
+bool RunHistory::mapFile(std::size_t bytes) {
+    if (mapping) {
+        munmap(mapping, mappedBytes);
+        mapping = nullptr;
+    }
+    int protection = readOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+    void* address = mmap(nullptr, bytes, protection, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED) {
+        return false;
+    }
+    mapping = static_cast<unsigned char*>(address);
+    mappedBytes = bytes;
+    recordCapacity = static_cast<std::uint32_t>((bytes - recordsOffset) / sizeof(RunRecord));
+    return true;
+}
+
+bool RunHistory::grow(std::uint32_t minRecords) {
+    std::uint32_t capacity = std::max(minRecords, std::max(initialRecords, recordCapacity * 2));
+    std::size_t bytes = recordsOffset + static_cast<std::size_t>(capacity) * sizeof(RunRecord);
+    if (ftruncate(fd, static_cast<off_t>(bytes)) != 0 || !mapFile(bytes)) {
+        std::cerr << "Failed to grow run history " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void RunHistory::sync(const void* begin, std::size_t bytes) {
+    if (!syncCommits) {
+        return;
+    }
+    std::size_t offset = static_cast<const unsigned char*>(begin) - mapping;
+    std::size_t pageStart = offset / pageBytes * pageBytes;
+    msync(mapping + pageStart, offset + bytes - pageStart, MS_SYNC);
+}
+
+std::int64_t RunHistory::append(std::uint64_t timestamp, std::uint64_t worldSeed, float survivalSeconds,
+                                float peakSpeed, std::int32_t score) {
+    if (!mapping || readOnly) {
+        return -1;
+    }
+    std::uint32_t index = current().count;
+    if (index >= recordCapacity && !grow(index + 1)) {
+        return -1;
+    }
+
+    // 1. The record and any finished day, past the committed ends
+    RunRecord& entry = records()[index];
+    entry = RunRecord{timestamp, worldSeed, survivalSeconds, peakSpeed, score, dayOf(timestamp), 0, 0};
+    entry.checksum = fnv1a(&entry, offsetof(RunRecord, checksum));
+    sync(&entry, sizeof(RunRecord));
+
+    CommitSlot next = current();
+    next.sequence++;
+    next.count = index + 1;
+
+    if (next.today.runs > 0 && next.today.day != entry.day) {
+        if (next.dayCount < dayCapacity) {
+            days()[next.dayCount] = next.today;
+            sync(&days()[next.dayCount], sizeof(RunDay));
+            next.dayCount++;
+        }
+        next.today.runs = 0;
+    }
+    if (next.today.runs == 0) {
+        next.today = RunDay{entry.day, 1, index, index};
+    } else {
+        next.today.runs++;
+        if (score > records()[next.today.bestRecord].score) {
+            next.today.bestRecord = index;
+        }
+    }
+
+    // Top-N: after every run with the same score, so earlier runs keep their place
+    const RunRecord* all = records();
+    std::uint32_t* position = std::upper_bound(next.top, next.top + next.topCount, score,
+        [all](std::int32_t value, std::uint32_t other) { return value > all[other].score; });
+    std::uint32_t rank = static_cast<std::uint32_t>(position - next.top);
+    if (rank < topCapacity) {
+        std::uint32_t last = std::min(next.topCount, topCapacity - 1);
+        std::copy_backward(next.top + rank, next.top + last, next.top + last + 1);
+        next.top[rank] = index;
+        next.topCount = std::min(next.topCount + 1, topCapacity);
+    }
+
+    // 2. The commit: the other slot, then switch
+    next.checksum = fnv1a(&next, offsetof(CommitSlot, checksum));
+    int target = 1 - activeSlot;
+    *slot(target) = next;
+    sync(slot(target), sizeof(CommitSlot));
+    activeSlot = target;
+    return index;
+}
+
+std::uint32_t RunHistory::size() const {
+    return mapping ? current().count : 0;
+}
+
+const RunRecord& RunHistory::record(std::uint32_t index) const {
+    return records()[index];
+}
+
+bool RunHistory::isValid(const RunRecord& record) const {
+    return record.checksum == fnv1a(&record, offsetof(RunRecord, checksum));
+}
+
+std::uint32_t RunHistory::top(std::uint32_t* out, std::uint32_t count) const {
+    if (!mapping) {
+        return 0;
+    }
+    std::uint32_t available = std::min(count, current().topCount);
+    std::copy(current().top, current().top + available, out);
+    return available;
+}
+
+bool RunHistory::findDay(std::uint32_t day, RunDay& out) const {
+    if (!mapping) {
+        return false;
+    }
+    // The day in progress plus any finished entries for it (more than one
+    // only if the clock was set back)
+    const CommitSlot& commit = current();
+    const RunRecord* all = records();
+    out = RunDay{day, 0, 0, 0};
+    auto merge = [&](const RunDay& entry) {
+        if (entry.day != day || entry.runs == 0) {
+            return;
+        }
+        if (out.runs == 0 || entry.firstRecord < out.firstRecord) {
+            out.firstRecord = entry.firstRecord;
+        }
+        if (out.runs == 0 || all[entry.bestRecord].score > all[out.bestRecord].score) {
+            out.bestRecord = entry.bestRecord;
+        }
+        out.runs += entry.runs;
+    };
+    merge(commit.today);
+    for (std::uint32_t i = commit.dayCount; i > 0; --i) {
+        merge(days()[i - 1]);
+    }
+    return out.runs > 0;
+}
+
+std::uint32_t RunHistory::dayOf(std::uint64_t timestamp) {
+    std::time_t time = static_cast<std::time_t>(timestamp);
+    std::tm local;
+    localtime_r(&time, &local);
+    return static_cast<std::uint32_t>((static_cast<std::int64_t>(time) + local.tm_gmtoff) / 86400);
+}
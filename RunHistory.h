@@ -0,0 +1,93 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// One finished game, as stored on disk (native byte order)
+struct RunRecord {
+    std::uint64_t timestamp;       // Unix seconds at game over
+    std::uint64_t worldSeed;
+    float survivalSeconds;
+    float peakSpeed;
+    std::int32_t score;
+    std::uint32_t day;             // Local calendar day, days since 1970-01-01
+    std::uint32_t checksum;
+    std::uint32_t reserved;
+};
+
+// Runs recorded on one local day
+struct RunDay {
+    std::uint32_t day = 0;
+    std::uint32_t runs = 0;
+    std::uint32_t firstRecord = 0;  // Runs of a day are contiguous unless the clock went back
+    std::uint32_t bestRecord = 0;
+};
+
+// Every finished run, kept in one append-only memory-mapped file.
+//
+// Layout: a header page, two commit slots on pages of their own, a table of
+// finished days, then the records. A commit slot holds the run count, the
+// top-N index (record numbers sorted by score) and the day in progress; the
+// slot with the higher sequence and a valid checksum is current. append()
+// writes the record and, when the day changes, the finished day past the
+// committed ends, syncs them, then writes the other slot and syncs it, so a
+// crash leaves either the old or the new commit, never half of one.
+//
+// open() maps the file and checks two slots: no parse and no read of the
+// records, however many there are. Queries read the index and the records
+// they return.
+// One writer at a time (the file is locked); readers need no lock, since a
+// slot caught mid-write fails its checksum and the other one is used.
+class RunHistory {
+public:
+    static constexpr std::uint32_t topCapacity = 100;
+    static constexpr std::uint32_t dayCapacity = 4096;   // Finished days indexed, ~11 years
+
+private:
+    struct FileHeader;
+    struct CommitSlot;
+
+    std::string path;
+    int fd;
+    unsigned char* mapping;
+    std::size_t mappedBytes;
+    std::uint32_t recordCapacity;
+    int activeSlot;
+    bool syncCommits;
+    bool readOnly;
+
+    CommitSlot* slot(int index) const;
+    const CommitSlot& current() const { return *slot(activeSlot); }
+    RunDay* days() const;
+    RunRecord* records() const;
+    bool mapFile(std::size_t bytes);
+    bool grow(std::uint32_t minRecords);
+    void sync(const void* begin, std::size_t bytes);
+
+public:
+    RunHistory();
+    ~RunHistory();
+    RunHistory(const RunHistory&) = delete;
+    RunHistory& operator=(const RunHistory&) = delete;
+
+    bool open(const std::string& filePath, bool readOnly = false);   // Writers create the file if missing
+    void close();
+    bool isOpen() const { return mapping != nullptr; }
+
+    // Commits one run; returns its record number, or -1 on failure
+    std::int64_t append(std::uint64_t timestamp, std::uint64_t worldSeed, float survivalSeconds,
+                        float peakSpeed, std::int32_t score);
+    // Skip the syncs (bulk imports, benchmarks); commits stay ordered but not durable
+    void setSyncCommits(bool enabled) { syncCommits = enabled; }
+
+    std::uint32_t size() const;
+    const RunRecord& record(std::uint32_t index) const;
+    bool isValid(const RunRecord& record) const;
+
+    // Record numbers of the best runs, highest score first; returns how many were written
+    std::uint32_t top(std::uint32_t* out, std::uint32_t count) const;
+    // Runs on a day (see dayOf); false if none are indexed
+    bool findDay(std::uint32_t day, RunDay& out) const;
+
+    static std::uint32_t dayOf(std::uint64_t timestamp);   // Local calendar day
+};
@@ -0,0 +1,65 @@
+#include "SfmlAudioSink.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+SfmlAudioSink::SfmlAudioSink()
+    : silenceSamples(0)
+    , streaming(false)
+    , started(false)
+    , underruns(0) {
+}
+
+SfmlAudioSink::~SfmlAudioSink() {
+    stop();
+}
+
+bool SfmlAudioSink::start(unsigned int sampleRate, unsigned int channels) {
+    initialize(channels, sampleRate);
+    silenceSamples = std::min<std::size_t>(maxBlockSamples, 512 * channels);
+    streaming = true;
+    return true;
+}
+
+void SfmlAudioSink::write(const std::int16_t* samples, std::size_t frameCount) {
+    std::size_t count = std::min(maxBlockSamples, frameCount * getChannelCount());
+    std::copy(samples, samples + count, pending.samples);
+    pending.count = count;
+
+    while (!blocks.push(pending)) {
+        if (!streaming) {
+            return;
+        }
+        // Start the device once there is something buffered to avoid an initial underrun
+        if (!started) {
+            started = true;
+            play();
+            continue;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+}
+
+void SfmlAudioSink::stop() {
+    if (!streaming) {
+        return;
+    }
+    streaming = false;
+    sf::SoundStream::stop();
+    started = false;
+}
+
+bool SfmlAudioSink::onGetData(Chunk& data) {
+    if (!blocks.pop(playing)) {
+        std::fill(playing.samples, playing.samples + silenceSamples, static_cast<std::int16_t>(0));
+        playing.count = silenceSamples;
+        underruns.fetch_add(1, std::memory_order_relaxed);
+    }
+    data.samples = playing.samples;
+    data.sampleCount = playing.count;
+    return streaming;
+}
+
+void SfmlAudioSink::onSeek(sf::Time) {
+    // A live stream cannot seek
+}
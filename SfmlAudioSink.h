@@ -0,0 +1,41 @@
+#pragma once
+#include "AudioSink.h"
+#include "SpscQueue.h"
+#include <SFML/Audio.hpp>
+#include <atomic>
+
+// Plays mixer output through the sound device.
+// SFML pulls chunks from its own streaming thread; blocks travel there
+// through a small SPSC ring, so write() only waits when the device has
+// enough queued (that wait is what paces the mixer). If the ring is empty
+// when SFML asks, a block of silence is played and counted as an underrun.
+class SfmlAudioSink : public AudioSink, private sf::SoundStream {
+public:
+    static constexpr std::size_t maxBlockSamples = 2048;
+
+private:
+    struct Block {
+        std::int16_t samples[maxBlockSamples];
+        std::size_t count = 0;
+    };
+
+    SpscQueue<Block, 5> blocks;         // ~46 ms of 512-frame stereo blocks
+    Block pending;                      // Mixer thread
+    Block playing;                      // SFML thread; must outlive the chunk it backs
+    std::size_t silenceSamples;
+    std::atomic<bool> streaming;
+    std::atomic<bool> started;
+    std::atomic<std::uint64_t> underruns;
+
+    bool onGetData(Chunk& data) override;
+    void onSeek(sf::Time timeOffset) override;
+
+public:
+    SfmlAudioSink();
+    ~SfmlAudioSink() override;
+
+    bool start(unsigned int sampleRate, unsigned int channels) override;
+    void write(const std::int16_t* samples, std::size_t frameCount) override;
+    void stop() override;
+    std::uint64_t getUnderruns() const override { return underruns.load(std::memory_order_relaxed); }
+};
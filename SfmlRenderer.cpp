@@ -0,0 +1,87 @@
+#include "SfmlRenderer.h"
+#include <cmath>
+
+SfmlRenderer::SfmlRenderer(sf::RenderWindow& window)
+    : window(window)
+    , target(&window)
+    , layerSize(0, 0)
+    , layerAvailable(true) {
+}
+
+void SfmlRenderer::clear(const sf::Color& color) {
+    target->clear(color);
+}
+
+void SfmlRenderer::setView(const sf::View& view) {
+    target->setView(view);
+    current.stateChanges++;
+}
+
+const sf::View& SfmlRenderer::getView() const {
+    return target->getView();
+}
+
+void SfmlRenderer::draw(const sf::Shape& shape) {
+    target->draw(shape);
+    current.drawCalls++;
+}
+
+void SfmlRenderer::draw(const sf::Text& text) {
+    target->draw(text);
+    current.drawCalls++;
+}
+
+void SfmlRenderer::draw(const sf::Vertex* vertices, std::size_t count, sf::PrimitiveType type) {
+    target->draw(vertices, count, type);
+    current.drawCalls++;
+}
+
+void SfmlRenderer::display() {
+    window.display();
+    finishFrame();
+}
+
+void SfmlRenderer::beginScaledLayer(float scale) {
+    if (scale >= 0.999f || !layerAvailable) {
+        return;
+    }
+    
+    sf::Vector2u windowSize = window.getSize();
+    sf::Vector2u size(static_cast<unsigned int>(std::lround(windowSize.x * scale)),
+                      static_cast<unsigned int>(std::lround(windowSize.y * scale)));
+    if (size != layerSize) {
+        // Recreated only when the scale changes
+        if (!layer.create(size.x, size.y)) {
+            layerAvailable = false;  // No FBO support: keep drawing at native resolution
+            return;
+        }
+        layer.setSmooth(true);
+        layerSize = size;
+        layerSprite.setTexture(layer.getTexture(), true);
+    }
+    
+    // Same world view as the window, so callers need not know about the scale
+    layer.setView(window.getView());
+    layer.clear(sf::Color::Black);
+    target = &layer;
+}
+
+void SfmlRenderer::endScaledLayer() {
+    if (target != &layer) {
+        return;
+    }
+    layer.display();
+    target = &window;
+    
+    // One textured quad covering the window, drawn in pixel coordinates
+    sf::Vector2u windowSize = window.getSize();
+    sf::View worldView = window.getView();
+    window.setView(sf::View(sf::FloatRect(0.0f, 0.0f, static_cast<float>(windowSize.x),
+                                          static_cast<float>(windowSize.y))));
+    layerSprite.setScale(static_cast<float>(windowSize.x) / layerSize.x,
+                         static_cast<float>(windowSize.y) / layerSize.y);
+    window.draw(layerSprite);
+    window.setView(worldView);
+    current.drawCalls++;
+    current.stateChanges += 2;
+}
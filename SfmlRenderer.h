@@ -0,0 +1,27 @@
+#pragma once
+#include "Renderer.h"
+
+// Renderer backed by an SFML window. Only draw calls are counted, so the
+// production path pays nothing for geometry accounting.
+class SfmlRenderer : public Renderer {
+private:
+    sf::RenderWindow& window;
+    sf::RenderTarget* target;       // The window, or the layer while a scaled layer is open
+    sf::RenderTexture layer;
+    sf::Vector2u layerSize;
+    sf::Sprite layerSprite;
+    bool layerAvailable;            // False once RenderTexture creation has failed
+
+public:
+    explicit SfmlRenderer(sf::RenderWindow& window);
+
+    void clear(const sf::Color& color) override;
+    void setView(const sf::View& view) override;
+    const sf::View& getView() const override;
+    void draw(const sf::Shape& shape) override;
+    void draw(const sf::Text& text) override;
+    void draw(const sf::Vertex* vertices, std::size_t count, sf::PrimitiveType type) override;
+    void display() override;
+    void beginScaledLayer(float scale) override;
+    void endScaledLayer() override;
+};
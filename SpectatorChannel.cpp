@@ -0,0 +1,143 @@
+#include "SpectatorChannel.h"
+#include "SpectatorCodec.h"
+#include <cstring>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+const char* socketPrefix = "unix:";
+
+bool socketAddress(const std::string& path, sockaddr_un& address) {
+    if (path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+bool isSocketTarget(const std::string& target) {
+    return target.compare(0, std::strlen(socketPrefix), socketPrefix) == 0;
+}
+
+} // namespace
+
+SpectatorOutput::SpectatorOutput()
+    : file(nullptr)
+    , socketHandle(-1)
+    , dropped(0) {
+}
+
+SpectatorOutput::~SpectatorOutput() {
+    if (file) {
+        std::fclose(file);
+    }
+    if (socketHandle >= 0) {
+        close(socketHandle);
+    }
+}
+
+bool SpectatorOutput::open(const std::string& target) {
+    if (!isSocketTarget(target)) {
+        file = std::fopen(target.c_str(), "wb");
+        return file != nullptr;
+    }
+    socketPath = target.substr(std::strlen(socketPrefix));
+    sockaddr_un address;
+    if (!socketAddress(socketPath, address)) {
+        return false;
+    }
+    socketHandle = socket(AF_UNIX, SOCK_DGRAM, 0);
+    if (socketHandle < 0 || fcntl(socketHandle, F_SETFL, O_NONBLOCK) != 0) {
+        return false;
+    }
+    return true;
+}
+
+bool SpectatorOutput::write(const std::uint8_t* data, std::size_t size) {
+    if (size == 0 || size > 0xFFFF) {
+        dropped++;
+        return false;
+    }
+    if (file) {
+        std::uint8_t prefix[2] = {static_cast<std::uint8_t>(size & 0xFF), static_cast<std::uint8_t>(size >> 8)};
+        return std::fwrite(prefix, 1, 2, file) == 2 && std::fwrite(data, 1, size, file) == size;
+    }
+    if (socketHandle < 0) {
+        return false;
+    }
+    // No viewer bound yet, or its queue is full: drop and carry on
+    sockaddr_un address;
+    socketAddress(socketPath, address);
+    ssize_t sent = sendto(socketHandle, data, size, 0, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+    if (sent != static_cast<ssize_t>(size)) {
+        dropped++;
+        return false;
+    }
+    return true;
+}
+
+SpectatorInput::SpectatorInput()
+    : file(nullptr)
+    , socketHandle(-1)
+    , buffer(SpectatorFormat::maxMessageBytes) {
+}
+
+SpectatorInput::~SpectatorInput() {
+    if (file) {
+        std::fclose(file);
+    }
+    if (socketHandle >= 0) {
+        close(socketHandle);
+        unlink(socketPath.c_str());
+    }
+}
+
+bool SpectatorInput::open(const std::string& source) {
+    if (!isSocketTarget(source)) {
+        file = std::fopen(source.c_str(), "rb");
+        return file != nullptr;
+    }
+    socketPath = source.substr(std::strlen(socketPrefix));
+    sockaddr_un address;
+    if (!socketAddress(socketPath, address)) {
+        return false;
+    }
+    unlink(socketPath.c_str());  // Left behind by a viewer that crashed
+    socketHandle = socket(AF_UNIX, SOCK_DGRAM, 0);
+    if (socketHandle < 0 ||
+        bind(socketHandle, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        fcntl(socketHandle, F_SETFL, O_NONBLOCK) != 0) {
+        return false;
+    }
+    return true;
+}
+
+bool SpectatorInput::read(const std::uint8_t*& data, std::size_t& size) {
+    if (file) {
+        std::uint8_t prefix[2];
+        if (std::fread(prefix, 1, 2, file) != 2) {
+            return false;
+        }
+        size = static_cast<std::size_t>(prefix[0]) | (static_cast<std::size_t>(prefix[1]) << 8);
+        if (size > buffer.size() || std::fread(buffer.data(), 1, size, file) != size) {
+            return false;
+        }
+        data = buffer.data();
+        return true;
+    }
+    if (socketHandle < 0) {
+        return false;
+    }
+    ssize_t received = recv(socketHandle, buffer.data(), buffer.size(), 0);
+    if (received <= 0) {
+        return false;
+    }
+    data = buffer.data();
+    size = static_cast<std::size_t>(received);
+    return true;
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Transport for the spectator stream. A target is either a file path (each
+// message prefixed with its 16-bit little-endian length) or "unix:<path>",
+// a Unix datagram socket bound by the viewer. Socket writes never block: a
+// message the viewer has no room for is dropped, which the keyframe-relative
+// deltas tolerate.
+class SpectatorOutput {
+private:
+    std::FILE* file;
+    int socketHandle;
+    std::string socketPath;
+    std::uint64_t dropped;
+
+public:
+    SpectatorOutput();
+    ~SpectatorOutput();
+    SpectatorOutput(const SpectatorOutput&) = delete;
+    SpectatorOutput& operator=(const SpectatorOutput&) = delete;
+
+    bool open(const std::string& target);
+    bool write(const std::uint8_t* data, std::size_t size);
+    std::uint64_t getDropped() const { return dropped; }
+};
+
+class SpectatorInput {
+private:
+    std::FILE* file;
+    int socketHandle;
+    std::string socketPath;
+    std::vector<std::uint8_t> buffer;
+
+public:
+    SpectatorInput();
+    ~SpectatorInput();
+    SpectatorInput(const SpectatorInput&) = delete;
+    SpectatorInput& operator=(const SpectatorInput&) = delete;
+
+    bool open(const std::string& source);
+    bool isLive() const { return socketHandle >= 0; }
+
+    // Next message, or false if none is waiting (or the file has ended)
+    bool read(const std::uint8_t*& data, std::size_t& size);
+};
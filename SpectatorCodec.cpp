@@ -0,0 +1,313 @@
+#include "SpectatorCodec.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const sf::Color palette[] = {sf::Color::Green, sf::Color::Yellow, sf::Color::Red, sf::Color::Magenta};
+const std::uint8_t rawColor = 0xFF;
+
+struct Writer {
+    std::uint8_t* out;
+    std::size_t capacity;
+    std::size_t position;
+    bool overflow;
+
+    void byte(std::uint8_t value) {
+        if (position < capacity) {
+            out[position++] = value;
+        } else {
+            overflow = true;
+        }
+    }
+
+    void varint(std::uint32_t value) {
+        while (value >= 0x80) {
+            byte(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        byte(static_cast<std::uint8_t>(value));
+    }
+
+    void signedVarint(std::int32_t value) {
+        varint((static_cast<std::uint32_t>(value) << 1) ^ static_cast<std::uint32_t>(value >> 31));
+    }
+};
+
+struct Reader {
+    const std::uint8_t* in;
+    std::size_t size;
+    std::size_t position;
+    bool failed;
+
+    std::uint8_t byte() {
+        if (position < size) {
+            return in[position++];
+        }
+        failed = true;
+        return 0;
+    }
+
+    std::uint32_t varint() {
+        std::uint32_t value = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            std::uint8_t next = byte();
+            value |= static_cast<std::uint32_t>(next & 0x7F) << shift;
+            if ((next & 0x80) == 0) {
+                return value;
+            }
+        }
+        failed = true;
+        return 0;
+    }
+
+    std::int32_t signedVarint() {
+        std::uint32_t value = varint();
+        return static_cast<std::int32_t>((value >> 1) ^ (~(value & 1) + 1));
+    }
+};
+
+std::int32_t quantize(float position) {
+    return static_cast<std::int32_t>(std::lround(position * SpectatorFormat::positionScale));
+}
+
+float dequantize(std::int32_t value) {
+    return static_cast<float>(value) / SpectatorFormat::positionScale;
+}
+
+void writeColor(Writer& writer, const sf::Color& color) {
+    for (std::uint8_t i = 0; i < 4; ++i) {
+        if (palette[i] == color) {
+            writer.byte(i);
+            return;
+        }
+    }
+    writer.byte(rawColor);
+    writer.byte(color.r);
+    writer.byte(color.g);
+    writer.byte(color.b);
+    writer.byte(color.a);
+}
+
+sf::Color readColor(Reader& reader) {
+    std::uint8_t index = reader.byte();
+    if (index < 4) {
+        return palette[index];
+    }
+    sf::Color color;
+    color.r = reader.byte();
+    color.g = reader.byte();
+    color.b = reader.byte();
+    color.a = reader.byte();
+    return color;
+}
+
+void writeHud(Writer& writer, const SpectatorFrame& frame) {
+    std::uint8_t rotation = static_cast<std::uint8_t>(std::lround(frame.playerRotation * 256.0f / 360.0f) & 0xFF);
+    writer.byte(rotation);
+    writer.byte(static_cast<std::uint8_t>((frame.powerState & 0x7F) | (frame.playerVisible ? 0x80 : 0)));
+    writer.signedVarint(frame.score);
+    writer.signedVarint(frame.lives);
+    writer.signedVarint(frame.speed);
+}
+
+void readHud(Reader& reader, SpectatorFrame& frame) {
+    frame.playerRotation = reader.byte() * 360.0f / 256.0f;
+    std::uint8_t power = reader.byte();
+    frame.powerState = power & 0x7F;
+    frame.playerVisible = (power & 0x80) != 0;
+    frame.score = reader.signedVarint();
+    frame.lives = reader.signedVarint();
+    frame.speed = reader.signedVarint();
+}
+
+void writeObstacle(Writer& writer, const SpectatorObstacle& obstacle) {
+    writer.varint(obstacle.slot);
+    writer.varint(obstacle.generation);
+    writer.signedVarint(quantize(obstacle.x));
+    writer.signedVarint(quantize(obstacle.y));
+    writer.byte(static_cast<std::uint8_t>(std::min(255L, std::lround(obstacle.radius * SpectatorFormat::radiusScale))));
+    writeColor(writer, obstacle.fill);
+}
+
+SpectatorObstacle readObstacle(Reader& reader) {
+    SpectatorObstacle obstacle;
+    obstacle.slot = reader.varint();
+    obstacle.generation = reader.varint();
+    obstacle.x = dequantize(reader.signedVarint());
+    obstacle.y = dequantize(reader.signedVarint());
+    obstacle.radius = reader.byte() / SpectatorFormat::radiusScale;
+    obstacle.fill = readColor(reader);
+    return obstacle;
+}
+
+} // namespace
+
+SpectatorEncoder::SpectatorEncoder(std::uint32_t keyframeInterval)
+    : buffer(SpectatorFormat::maxMessageBytes)
+    , length(0)
+    , haveReference(false)
+    , keyframeInterval(std::max<std::uint32_t>(1, keyframeInterval))
+    , sinceKeyframe(0) {
+    referenceIndex.assign(1024, -1);
+}
+
+void SpectatorEncoder::encode(const SpectatorFrame& frame) {
+    if (!haveReference || ++sinceKeyframe >= keyframeInterval) {
+        encodeKeyframe(frame);
+    } else {
+        encodeDelta(frame);
+    }
+    stats.frames++;
+    stats.bytes += length;
+    stats.largestFrame = std::max<std::uint64_t>(stats.largestFrame, length);
+}
+
+void SpectatorEncoder::encodeKeyframe(const SpectatorFrame& frame) {
+    Writer writer{buffer.data(), buffer.size(), 0, false};
+    writer.byte(SpectatorFormat::keyframe);
+    writer.varint(frame.tick);
+    writer.byte(frame.gameState);
+    writer.signedVarint(quantize(frame.playerX));
+    writer.signedVarint(quantize(frame.playerY));
+    writeHud(writer, frame);
+    writer.varint(frame.obstacleCount);
+    for (std::uint32_t i = 0; i < frame.obstacleCount; ++i) {
+        writeObstacle(writer, frame.obstacles[i]);
+    }
+    length = writer.overflow ? 0 : writer.position;
+
+    // Becomes the reference for the deltas that follow
+    for (std::uint32_t i = 0; i < reference.obstacleCount; ++i) {
+        referenceIndex[reference.obstacles[i].slot] = -1;
+    }
+    reference = frame;
+    for (std::uint32_t i = 0; i < frame.obstacleCount; ++i) {
+        std::uint32_t slot = frame.obstacles[i].slot;
+        if (slot >= referenceIndex.size()) {
+            referenceIndex.resize(slot + 1, -1);  // Only when a higher slot shows up
+        }
+        referenceIndex[slot] = static_cast<std::int32_t>(i);
+    }
+    haveReference = true;
+    sinceKeyframe = 0;
+    stats.keyframes++;
+}
+
+void SpectatorEncoder::encodeDelta(const SpectatorFrame& frame) {
+    // Pair current obstacles with keyframe rows; the rest are sent in full
+    std::array<std::int32_t, SpectatorFrame::maxObstacles> matched;
+    std::fill(matched.begin(), matched.begin() + reference.obstacleCount, -1);
+    std::uint32_t newCount = 0;
+    for (std::uint32_t i = 0; i < frame.obstacleCount; ++i) {
+        const SpectatorObstacle& obstacle = frame.obstacles[i];
+        std::int32_t row = obstacle.slot < referenceIndex.size() ? referenceIndex[obstacle.slot] : -1;
+        if (row >= 0 && reference.obstacles[row].generation == obstacle.generation) {
+            matched[row] = static_cast<std::int32_t>(i);
+        } else {
+            newCount++;
+        }
+    }
+
+    Writer writer{buffer.data(), buffer.size(), 0, false};
+    writer.byte(SpectatorFormat::delta);
+    writer.varint(frame.tick);
+    writer.varint(reference.tick);
+    writer.byte(frame.gameState);
+    writer.signedVarint(quantize(frame.playerX) - quantize(reference.playerX));
+    writer.signedVarint(quantize(frame.playerY) - quantize(reference.playerY));
+    writeHud(writer, frame);
+
+    // Which keyframe obstacles are still there, then how far each has moved
+    for (std::uint32_t base = 0; base < reference.obstacleCount; base += 8) {
+        std::uint8_t bits = 0;
+        for (std::uint32_t bit = 0; bit < 8 && base + bit < reference.obstacleCount; ++bit) {
+            bits |= matched[base + bit] >= 0 ? static_cast<std::uint8_t>(1u << bit) : 0;
+        }
+        writer.byte(bits);
+    }
+    for (std::uint32_t row = 0; row < reference.obstacleCount; ++row) {
+        if (matched[row] >= 0) {
+            const SpectatorObstacle& now = frame.obstacles[matched[row]];
+            writer.signedVarint(quantize(now.x) - quantize(reference.obstacles[row].x));
+            writer.signedVarint(quantize(now.y) - quantize(reference.obstacles[row].y));
+        }
+    }
+
+    writer.varint(newCount);
+    for (std::uint32_t i = 0; i < frame.obstacleCount; ++i) {
+        const SpectatorObstacle& obstacle = frame.obstacles[i];
+        std::int32_t row = obstacle.slot < referenceIndex.size() ? referenceIndex[obstacle.slot] : -1;
+        if (row < 0 || matched[row] != static_cast<std::int32_t>(i)) {
+            writeObstacle(writer, obstacle);
+        }
+    }
+    length = writer.overflow ? 0 : writer.position;
+}
+
+SpectatorDecoder::SpectatorDecoder()
+    : haveReference(false) {
+}
+
+bool SpectatorDecoder::decode(const std::uint8_t* data, std::size_t size, SpectatorFrame& frame) {
+    Reader reader{data, size, 0, false};
+    std::uint8_t type = reader.byte();
+
+    if (type == SpectatorFormat::keyframe) {
+        frame.tick = reader.varint();
+        frame.gameState = reader.byte();
+        frame.playerX = dequantize(reader.signedVarint());
+        frame.playerY = dequantize(reader.signedVarint());
+        readHud(reader, frame);
+        std::uint32_t count = reader.varint();
+        if (count > SpectatorFrame::maxObstacles) {
+            return false;
+        }
+        frame.obstacleCount = count;
+        for (std::uint32_t i = 0; i < count; ++i) {
+            frame.obstacles[i] = readObstacle(reader);
+        }
+        if (reader.failed) {
+            return false;
+        }
+        reference = frame;
+        haveReference = true;
+        return true;
+    }
+
+    if (type != SpectatorFormat::delta || !haveReference) {
+        return false;
+    }
+    frame.tick = reader.varint();
+    if (reader.varint() != reference.tick) {
+        return false;  // Its keyframe was lost; wait for the next one
+    }
+    frame.gameState = reader.byte();
+    frame.playerX = dequantize(quantize(reference.playerX) + reader.signedVarint());
+    frame.playerY = dequantize(quantize(reference.playerY) + reader.signedVarint());
+    readHud(reader, frame);
+
+    std::array<std::uint8_t, (SpectatorFrame::maxObstacles + 7) / 8> alive;
+    std::uint32_t bitmapBytes = (reference.obstacleCount + 7) / 8;
+    for (std::uint32_t i = 0; i < bitmapBytes; ++i) {
+        alive[i] = reader.byte();
+    }
+    std::uint32_t count = 0;
+    for (std::uint32_t row = 0; row < reference.obstacleCount; ++row) {
+        if (alive[row / 8] & (1u << (row % 8))) {
+            SpectatorObstacle obstacle = reference.obstacles[row];
+            obstacle.x = dequantize(quantize(obstacle.x) + reader.signedVarint());
+            obstacle.y = dequantize(quantize(obstacle.y) + reader.signedVarint());
+            frame.obstacles[count++] = obstacle;
+        }
+    }
+    std::uint32_t added = reader.varint();
+    if (count + added > SpectatorFrame::maxObstacles) {
+        return false;
+    }
+    for (std::uint32_t i = 0; i < added; ++i) {
+        frame.obstacles[count++] = readObstacle(reader);
+    }
+    frame.obstacleCount = count;
+    return !reader.failed;
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include "SpectatorFrame.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Wire format of the spectator stream.
+// A keyframe carries the full frame. Every other frame is a delta against
+// the latest keyframe (not the previous frame), so any delta can be dropped
+// and a viewer can join at the next keyframe. Coordinates are quantized to
+// 1/8 unit and sent as zigzag varints, rotation as one byte, radius as
+// quarter units and colours as a palette index.
+namespace SpectatorFormat {
+    constexpr std::uint8_t keyframe = 'K';
+    constexpr std::uint8_t delta = 'D';
+    constexpr float positionScale = 8.0f;
+    constexpr float radiusScale = 4.0f;
+    constexpr std::size_t maxMessageBytes = 16 * 1024;
+}
+
+struct SpectatorStats {
+    std::uint64_t frames = 0;
+    std::uint64_t keyframes = 0;
+    std::uint64_t bytes = 0;
+    std::uint64_t largestFrame = 0;
+};
+
+// Encodes frames into one preallocated buffer; encode() does not allocate
+// once the slot lookup has grown to the highest entity slot in use.
+class SpectatorEncoder {
+private:
+    std::vector<std::uint8_t> buffer;
+    std::size_t length;
+    SpectatorFrame reference;                 // Latest keyframe
+    bool haveReference;
+    std::vector<std::int32_t> referenceIndex; // Entity slot -> row in `reference`, -1 if absent
+    std::uint32_t keyframeInterval;
+    std::uint32_t sinceKeyframe;
+    SpectatorStats stats;
+
+    void encodeKeyframe(const SpectatorFrame& frame);
+    void encodeDelta(const SpectatorFrame& frame);
+
+public:
+    explicit SpectatorEncoder(std::uint32_t keyframeInterval = 30);
+
+    // Encodes one frame; the bytes stay valid until the next call
+    void encode(const SpectatorFrame& frame);
+    void forceKeyframe() { haveReference = false; }
+    const std::uint8_t* data() const { return buffer.data(); }
+    std::size_t size() const { return length; }
+    const SpectatorStats& getStats() const { return stats; }
+};
+
+// Rebuilds frames from messages. Deltas that arrive before their keyframe
+// are rejected.
+class SpectatorDecoder {
+private:
+    SpectatorFrame reference;
+    bool haveReference;
+
+public:
+    SpectatorDecoder();
+    bool decode(const std::uint8_t* data, std::size_t size, SpectatorFrame& frame);
+};
@@ -0,0 +1,31 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstdint>
+
+struct SpectatorObstacle {
+    std::uint32_t slot;          // EntityId, so deltas can follow an obstacle
+    std::uint32_t generation;
+    float x;
+    float y;
+    float radius;
+    sf::Color fill;
+};
+
+// Everything a spectator sees in one tick
+struct SpectatorFrame {
+    static constexpr std::size_t maxObstacles = 256;
+
+    std::uint32_t tick = 0;
+    std::uint8_t gameState = 0;      // GameState
+    float playerX = 0.0f;
+    float playerY = 0.0f;
+    float playerRotation = 0.0f;
+    std::uint8_t powerState = 0;     // Player::PowerState
+    bool playerVisible = true;
+    std::int32_t score = 0;
+    std::int32_t lives = 0;
+    std::int32_t speed = 0;
+    std::uint32_t obstacleCount = 0;
+    std::array<SpectatorObstacle, maxObstacles> obstacles;
+};
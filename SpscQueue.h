@@ -0,0 +1,48 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+// Wait-free single-producer/single-consumer ring of fixed capacity.
+// push() is only called from one thread and pop() from one other thread;
+// neither blocks nor allocates. push() fails when the ring is full and pop()
+// when it is empty. One slot is kept free to tell full from empty.
+template <typename T, std::size_t Capacity>
+class SpscQueue {
+private:
+    static_assert(Capacity >= 2, "SpscQueue needs at least two slots");
+
+    T items[Capacity];
+    alignas(64) std::atomic<std::size_t> head{0};  // Next slot to pop (consumer)
+    alignas(64) std::atomic<std::size_t> tail{0};  // Next slot to push (producer)
+
+public:
+    bool push(const T& item) {
+        std::size_t current = tail.load(std::memory_order_relaxed);
+        std::size_t next = (current + 1) % Capacity;
+        if (next == head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        items[current] = item;
+        tail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& item) {
+        std::size_t current = head.load(std::memory_order_relaxed);
+        if (current == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = items[current];
+        head.store((current + 1) % Capacity, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate when called while the other side is active
+    std::size_t size() const {
+        std::size_t h = head.load(std::memory_order_acquire);
+        std::size_t t = tail.load(std::memory_order_acquire);
+        return (t + Capacity - h) % Capacity;
+    }
+
+    static constexpr std::size_t capacity() { return Capacity - 1; }
+};
@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdint>
+
+// On-disk layout of a telemetry session file:
+// one TelemetryFileHeader followed by TelemetryRecord entries, one per frame.
+// Both are plain fixed-size structs written in native byte order.
+
+const std::uint32_t telemetryMagic = 0x4C544754;  // "TGTL"
+const std::uint32_t telemetryVersion = 1;
+
+struct TelemetryFileHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t recordSize;
+    std::uint32_t reserved;
+};
+
+struct TelemetryRecord {
+    std::uint32_t frame;
+    std::uint8_t state;                  // GameState
+    std::uint8_t padding[3];
+
+    // Timings in microseconds
+    float frameTime;
+    float eventTime;
+    float updateTime;
+    float renderTime;
+
+    // Entity counts
+    std::uint16_t obstacles;
+    std::uint16_t explosionParticles;
+    std::uint16_t trailParticles;     // Trail ribbon samples
+    std::uint16_t backgroundParticles;
+    std::uint32_t pairsTested;        // Summed over every simulation tick of the frame
+
+    // Difficulty and progress
+    float gameSpeed;
+    float spawnInterval;                 // Seconds
+    std::int32_t score;
+    std::int32_t lives;
+};
+
+static_assert(sizeof(TelemetryFileHeader) == 16, "telemetry header layout changed");
+static_assert(sizeof(TelemetryRecord) == 52, "telemetry record layout changed");
@@ -0,0 +1,112 @@
+#include "TelemetryRecorder.h"
+#include <chrono>
+
+TelemetryRecorder::TelemetryRecorder(std::size_t recordsPerBlock, std::size_t blockCount)
+    : file(nullptr)
+    , blocks(new Block[blockCount])
+    , blockCount(blockCount)
+    , recordsPerBlock(recordsPerBlock)
+    , activeBlock(0)
+    , nextToWrite(0)
+    , stopping(false)
+    , recordsWritten(0)
+    , recordsDropped(0) {
+
+    for (std::size_t i = 0; i < blockCount; ++i) {
+        blocks[i].records.resize(recordsPerBlock);
+    }
+}
+
+TelemetryRecorder::~TelemetryRecorder() {
+    close();
+}
+
+bool TelemetryRecorder::open(const std::string& path) {
+    close();
+
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+
+    TelemetryFileHeader header{telemetryMagic, telemetryVersion,
+                               static_cast<std::uint32_t>(sizeof(TelemetryRecord)), 0};
+    std::fwrite(&header, sizeof(header), 1, file);
+
+    activeBlock = 0;
+    nextToWrite = 0;
+    stopping = false;
+    writer = std::thread(&TelemetryRecorder::writerLoop, this);
+    return true;
+}
+
+void TelemetryRecorder::record(const TelemetryRecord& entry) {
+    if (!file) {
+        return;
+    }
+
+    Block& block = blocks[activeBlock];
+    if (block.pending.load(std::memory_order_acquire)) {
+        recordsDropped++;  // Writer has not caught up with this block yet
+        return;
+    }
+
+    block.records[block.count++] = entry;
+    if (block.count == recordsPerBlock) {
+        submitActiveBlock();
+    }
+}
+
+void TelemetryRecorder::submitActiveBlock() {
+    blocks[activeBlock].pending.store(true, std::memory_order_release);
+    activeBlock = (activeBlock + 1) % blockCount;
+    wake.notify_one();
+}
+
+void TelemetryRecorder::writerLoop() {
+    while (true) {
+        // Read before looking for work: close() submits the last block before
+        // setting stopping, so once stopping is seen that block is visible too
+        bool finishing = stopping.load();
+        Block& block = blocks[nextToWrite];
+        if (block.pending.load(std::memory_order_acquire)) {
+            std::fwrite(block.records.data(), sizeof(TelemetryRecord), block.count, file);
+            recordsWritten += block.count;
+            block.count = 0;
+            block.pending.store(false, std::memory_order_release);
+            nextToWrite = (nextToWrite + 1) % blockCount;
+            continue;
+        }
+
+        // Blocks are submitted in order, so nothing newer can be pending
+        if (finishing) {
+            break;
+        }
+
+        // The game thread notifies without locking; the timeout covers a missed wakeup
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wake.wait_for(lock, std::chrono::milliseconds(50));
+    }
+    std::fflush(file);
+}
+
+void TelemetryRecorder::close() {
+    if (!file) {
+        return;
+    }
+
+    // Hand over whatever the current block holds
+    Block& block = blocks[activeBlock];
+    if (block.count > 0 && !block.pending.load()) {
+        submitActiveBlock();
+    }
+
+    stopping = true;
+    wake.notify_one();
+    if (writer.joinable()) {
+        writer.join();
+    }
+
+    std::fclose(file);
+    file = nullptr;
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include "TelemetryRecord.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Streams TelemetryRecords to a session file.
+// The game thread copies each record into one of a few preallocated blocks;
+// a background thread writes full blocks to disk. record() never touches the
+// file or allocates. If the writer falls behind and every block is still
+// pending, records are dropped and counted instead of stalling the frame.
+class TelemetryRecorder {
+private:
+    struct Block {
+        std::vector<TelemetryRecord> records;
+        std::size_t count = 0;
+        std::atomic<bool> pending{false};  // Full and waiting for the writer
+    };
+
+    std::FILE* file;
+    std::unique_ptr<Block[]> blocks;
+    std::size_t blockCount;
+    std::size_t recordsPerBlock;
+    std::size_t activeBlock;               // Game thread only
+    std::size_t nextToWrite;               // Writer thread only
+
+    std::thread writer;
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::atomic<bool> stopping;
+    std::atomic<std::uint64_t> recordsWritten;
+    std::atomic<std::uint64_t> recordsDropped;
+
+    void writerLoop();
+    void submitActiveBlock();
+
+public:
+    explicit TelemetryRecorder(std::size_t recordsPerBlock = 1024, std::size_t blockCount = 4);
+    ~TelemetryRecorder();
+
+    TelemetryRecorder(const TelemetryRecorder&) = delete;
+    TelemetryRecorder& operator=(const TelemetryRecorder&) = delete;
+
+    bool open(const std::string& path);
+    void record(const TelemetryRecord& entry);
+    void close();  // Flushes the partial block and joins the writer
+
+    bool isOpen() const { return file != nullptr; }
+    std::uint64_t getRecordsWritten() const { return recordsWritten.load(); }
+    std::uint64_t getRecordsDropped() const { return recordsDropped.load(); }
+};
@@ -0,0 +1,174 @@
+#include "TimerScheduler.h"
+#include <algorithm>
+
+TimerScheduler::TimerScheduler(std::size_t capacity)
+    : currentTick(0)
+    , nextSequence(0)
+    , activeCount(0) {
+    nodes.reserve(capacity);
+    freeNodes.reserve(capacity);
+    std::fill(std::begin(heads), std::end(heads), -1);
+}
+
+std::int32_t TimerScheduler::allocateNode() {
+    if (!freeNodes.empty()) {
+        std::int32_t index = freeNodes.back();
+        freeNodes.pop_back();
+        return index;
+    }
+    nodes.push_back(Node{0, 0, 0, 0, -1, -1, noBucket});
+    return static_cast<std::int32_t>(nodes.size() - 1);
+}
+
+TimerHandle TimerScheduler::schedule(Tick delayTicks, std::uint32_t payload) {
+    std::int32_t index = allocateNode();
+    Node& node = nodes[index];
+    node.deadline = currentTick + std::max<Tick>(delayTicks, 1);
+    node.sequence = nextSequence++;
+    node.payload = payload;
+    insert(index);
+    activeCount++;
+    return TimerHandle{static_cast<std::uint32_t>(index), node.generation};
+}
+
+bool TimerScheduler::isPending(const TimerHandle& handle) const {
+    return handle.index < nodes.size() &&
+           nodes[handle.index].generation == handle.generation &&
+           nodes[handle.index].bucket != noBucket;
+}
+
+bool TimerScheduler::cancel(TimerHandle& handle) {
+    if (!isPending(handle)) {
+        handle = TimerHandle{};
+        return false;
+    }
+    std::int32_t index = static_cast<std::int32_t>(handle.index);
+    unlink(index);
+    release(index);
+    handle = TimerHandle{};
+    return true;
+}
+
+void TimerScheduler::clear() {
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        if (nodes[i].bucket != noBucket) {
+            std::int32_t index = static_cast<std::int32_t>(i);
+            unlink(index);
+            release(index);
+        }
+    }
+    currentTick = 0;
+    nextSequence = 0;
+}
+
+void TimerScheduler::insert(std::int32_t index) {
+    Tick deadline = nodes[index].deadline;
+    Tick delta = deadline - currentTick;
+
+    if (delta < wheelSize) {
+        link(index, static_cast<int>(deadline & wheelMask));
+    } else if (delta < static_cast<Tick>(wheelSize) * wheelSize) {
+        link(index, static_cast<int>(wheelSize + ((deadline >> wheelBits) & wheelMask)));
+    } else {
+        link(index, overflowBucket);
+    }
+}
+
+void TimerScheduler::link(std::int32_t index, int bucket) {
+    // Push front; firing order is restored from the sequence numbers
+    Node& node = nodes[index];
+    node.bucket = bucket;
+    node.prev = -1;
+    node.next = heads[bucket];
+    if (node.next >= 0) {
+        nodes[node.next].prev = index;
+    }
+    heads[bucket] = index;
+}
+
+void TimerScheduler::unlink(std::int32_t index) {
+    Node& node = nodes[index];
+    if (node.prev >= 0) {
+        nodes[node.prev].next = node.next;
+    } else {
+        heads[node.bucket] = node.next;
+    }
+    if (node.next >= 0) {
+        nodes[node.next].prev = node.prev;
+    }
+    node.prev = -1;
+    node.next = -1;
+    node.bucket = noBucket;
+}
+
+void TimerScheduler::release(std::int32_t index) {
+    nodes[index].generation++;
+    freeNodes.push_back(index);
+    activeCount--;
+}
+
+void TimerScheduler::cascade(int bucket) {
+    // Detach the whole bucket, then re-file each timer relative to the new tick
+    std::int32_t index = heads[bucket];
+    heads[bucket] = -1;
+    while (index >= 0) {
+        std::int32_t next = nodes[index].next;
+        insert(index);
+        index = next;
+    }
+}
+
+void TimerScheduler::advance(std::vector<std::uint32_t>& fired) {
+    currentTick++;
+
+    // Every 256 ticks pull the next level-1 bucket down, and every 65536
+    // ticks re-file the overflow list
+    if ((currentTick & wheelMask) == 0) {
+        Tick block = currentTick >> wheelBits;
+        if ((block & wheelMask) == 0) {
+            cascade(overflowBucket);
+        }
+        cascade(static_cast<int>(wheelSize + (block & wheelMask)));
+    }
+
+    int bucket = static_cast<int>(currentTick & wheelMask);
+    if (heads[bucket] < 0) {
+        return;
+    }
+
+    // Collect due timers, restore scheduling order, then release them
+    std::size_t firstFired = fired.size();
+    std::int32_t index = heads[bucket];
+    heads[bucket] = -1;
+    std::int32_t dueHead = -1;
+    while (index >= 0) {
+        std::int32_t next = nodes[index].next;
+        if (nodes[index].deadline == currentTick) {
+            nodes[index].next = dueHead;
+            dueHead = index;
+        } else {
+            link(index, bucket);  // Not reachable with delta < 256, kept for safety
+        }
+        index = next;
+    }
+
+    for (index = dueHead; index >= 0; ) {
+        std::int32_t next = nodes[index].next;
+        fired.push_back(static_cast<std::uint32_t>(index));
+        index = next;
+    }
+
+    auto bySequence = [this](std::uint32_t a, std::uint32_t b) {
+        return nodes[a].sequence < nodes[b].sequence;
+    };
+    std::sort(fired.begin() + firstFired, fired.end(), bySequence);
+
+    for (std::size_t i = firstFired; i < fired.size(); ++i) {
+        std::int32_t due = static_cast<std::int32_t>(fired[i]);
+        fired[i] = nodes[due].payload;
+        nodes[due].bucket = noBucket;
+        nodes[due].prev = -1;
+        nodes[due].next = -1;
+        release(due);
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// Reference to a scheduled timer; stale after it fires or is cancelled
+struct TimerHandle {
+    std::uint32_t index = 0xFFFFFFFFu;
+    std::uint32_t generation = 0;
+
+    bool isValid() const { return index != 0xFFFFFFFFu; }
+};
+
+// Two-level hierarchical timer wheel driven by simulation ticks.
+// Level 0 has one bucket per tick for the next 256 ticks, level 1 one bucket
+// per 256 ticks for the next 65536; anything further waits in an overflow
+// list. advance() only visits the bucket for the new tick (plus a cascade
+// every 256 ticks), so its cost follows the number of timers firing rather
+// than the number scheduled. Timers due on the same tick fire in the order
+// they were scheduled, which keeps replays deterministic.
+class TimerScheduler {
+public:
+    typedef std::uint64_t Tick;
+
+private:
+    static constexpr int wheelBits = 8;
+    static constexpr std::uint32_t wheelSize = 1u << wheelBits;
+    static constexpr std::uint32_t wheelMask = wheelSize - 1;
+    static constexpr int overflowBucket = 2 * wheelSize;
+    static constexpr int noBucket = -1;
+
+    struct Node {
+        Tick deadline;
+        std::uint64_t sequence;   // Tie-break for timers due on the same tick
+        std::uint32_t payload;
+        std::uint32_t generation;
+        std::int32_t prev;
+        std::int32_t next;
+        std::int32_t bucket;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<std::int32_t> freeNodes;
+    std::int32_t heads[overflowBucket + 1];
+    Tick currentTick;
+    std::uint64_t nextSequence;
+    std::size_t activeCount;
+
+    std::int32_t allocateNode();
+    void insert(std::int32_t index);
+    void link(std::int32_t index, int bucket);
+    void unlink(std::int32_t index);
+    void cascade(int bucket);
+    void release(std::int32_t index);
+
+public:
+    explicit TimerScheduler(std::size_t capacity = 64);
+
+    // Fire `payload` after delayTicks (at least one tick from now)
+    TimerHandle schedule(Tick delayTicks, std::uint32_t payload);
+    bool cancel(TimerHandle& handle);   // Also invalidates the handle
+    bool isPending(const TimerHandle& handle) const;
+    void clear();                       // Cancels everything and rewinds to tick 0
+
+    // Step one tick; payloads of due timers are appended to `fired` in order
+    void advance(std::vector<std::uint32_t>& fired);
+
+    Tick now() const { return currentTick; }
+    std::size_t size() const { return activeCount; }
+};
@@ -0,0 +1,72 @@
+#include "UdpTransport.h"
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+sockaddr_in loopbackAddress(std::uint16_t port) {
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return address;
+}
+
+} // namespace
+
+UdpTransport::UdpTransport()
+    : socketHandle(-1)
+    , peerPort(0) {
+}
+
+UdpTransport::~UdpTransport() {
+    if (socketHandle >= 0) {
+        close(socketHandle);
+    }
+}
+
+bool UdpTransport::open(std::uint16_t localPort, std::uint16_t remotePort) {
+    socketHandle = socket(AF_INET, SOCK_DGRAM, 0);
+    if (socketHandle < 0) {
+        return false;
+    }
+    sockaddr_in address = loopbackAddress(localPort);
+    if (bind(socketHandle, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        fcntl(socketHandle, F_SETFL, O_NONBLOCK) != 0) {
+        close(socketHandle);
+        socketHandle = -1;
+        return false;
+    }
+    peerPort = remotePort;
+    return true;
+}
+
+bool UdpTransport::send(const InputPacket& packet) {
+    if (socketHandle < 0) {
+        return false;
+    }
+    sockaddr_in address = loopbackAddress(peerPort);
+    ssize_t sent = sendto(socketHandle, &packet, sizeof(packet), 0,
+                          reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+    return sent == static_cast<ssize_t>(sizeof(packet));
+}
+
+bool UdpTransport::receive(InputPacket& packet) {
+    if (socketHandle < 0) {
+        return false;
+    }
+    // Skip anything that is not one of ours
+    for (;;) {
+        ssize_t received = recv(socketHandle, &packet, sizeof(packet), 0);
+        if (received < 0) {
+            return false;
+        }
+        if (received == static_cast<ssize_t>(sizeof(packet)) && packet.magic == InputPacket::magicValue &&
+            packet.count <= InputPacket::maxInputs) {
+            return true;
+        }
+    }
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include "VersusTransport.h"
+#include <cstdint>
+
+// Non-blocking UDP between two processes on this machine (127.0.0.1).
+// Packets are sent as raw structs, so both peers must be the same build.
+class UdpTransport : public VersusTransport {
+private:
+    int socketHandle;
+    std::uint16_t peerPort;
+
+public:
+    UdpTransport();
+    ~UdpTransport();
+    UdpTransport(const UdpTransport&) = delete;
+    UdpTransport& operator=(const UdpTransport&) = delete;
+
+    bool open(std::uint16_t localPort, std::uint16_t peerPort);
+    bool isOpen() const { return socketHandle >= 0; }
+
+    bool send(const InputPacket& packet) override;
+    bool receive(InputPacket& packet) override;
+};
@@ -0,0 +1,380 @@
+#include "VersusSimulation.h"
+#include "EntitySystems.h"
+#include "Obstacle.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+const float chunkSeconds = 2.0f;        // One speed step, as in Game
+const std::uint32_t chunkTicks = 120;
+const Fixed offscreenY = 880 * fixedOne;   // isObstacleOffscreen()
+const sf::Vector2f startPositions[2] = {sf::Vector2f(160.0f, 650.0f), sf::Vector2f(320.0f, 650.0f)};
+
+void hashBytes(std::uint64_t& hash, const void* data, std::size_t size) {
+    // FNV-1a
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+}
+
+void applyInput(Player& player, const PlayerInput& input) {
+    // Same handling as Game::updatePlayer, minus the cosmetic power states
+    const float dt = VersusSimulation::tickSeconds;
+    bool isMoving = input.left || input.right || input.forward || input.backward;
+    if (input.left) {
+        player.moveLeft(dt);
+    }
+    if (input.right) {
+        player.moveRight(dt);
+    }
+    if (input.forward) {
+        player.moveForward(dt);
+    }
+    if (input.backward) {
+        player.moveBackward(dt);
+    }
+    if (!isMoving) {
+        player.setTargetRotation(0.0f);
+    }
+    player.update(dt);
+}
+
+} // namespace
+
+std::uint8_t encodeInput(const PlayerInput& input) {
+    return static_cast<std::uint8_t>((input.left ? 1 : 0) | (input.right ? 2 : 0) |
+                                     (input.forward ? 4 : 0) | (input.backward ? 8 : 0));
+}
+
+PlayerInput decodeInput(std::uint8_t bits) {
+    PlayerInput input;
+    input.left = (bits & 1) != 0;
+    input.right = (bits & 2) != 0;
+    input.forward = (bits & 4) != 0;
+    input.backward = (bits & 8) != 0;
+    return input;
+}
+
+VersusSimulation::VersusSimulation(std::uint64_t seed, VersusPhysics physics)
+    : seed(seed)
+    , physics(physics) {
+    chunkCached.fill(false);
+    state.obstacles.setCapacity(EntityKind::Obstacle, obstacleCapacity);
+    if (physics == VersusPhysics::Fixed) {
+        state.bodies.reserve(obstacleCapacity);
+        contactScratch.reserve(obstacleCapacity);
+    }
+    startRound();
+}
+
+void VersusSimulation::prepareSnapshot(VersusState& snapshot) const {
+    snapshot = state;
+    snapshot.obstacles.setCapacity(EntityKind::Obstacle, obstacleCapacity);
+    if (physics == VersusPhysics::Fixed) {
+        snapshot.bodies.reserve(obstacleCapacity);
+    }
+}
+
+const WorldChunk& VersusSimulation::chunkFor(std::uint32_t round, std::uint64_t index) {
+    std::size_t entry = static_cast<std::size_t>(index % chunkCacheSize);
+    WorldChunk& chunk = chunkCache[entry];
+    if (chunkCached[entry] && chunk.request.index == index && chunk.request.epoch == round) {
+        return chunk;
+    }
+
+    // Density follows Game::stepSpeed(): 0.15 s less per step while above 0.2 s
+    float interval = 1.0f;
+    for (std::uint64_t step = 0; step < index && interval - 0.15f > 0.2f; ++step) {
+        interval -= 0.15f;
+    }
+    chunk.request = ChunkRequest{index, round, seed + round * 0x9E3779B97F4A7C15ull,
+                                 static_cast<float>(index) * chunkSeconds, chunkSeconds, interval};
+    generateChunk(chunk);
+    validateChunk(chunk);
+    chunkCached[entry] = true;
+    return chunk;
+}
+
+float VersusSimulation::speedAt(float roundTime) const {
+    float steps = std::floor(roundTime / chunkSeconds);
+    return std::min(300.0f + 40.0f * steps, 1200.0f);
+}
+
+void VersusSimulation::startRound() {
+    state.round++;
+    state.roundStartTick = state.tick;
+    state.roundEndTick = 0;
+    state.roundWinner = -1;
+    state.obstacles.clear();
+    state.bodies.clear();
+    state.chunkIndex = 0;
+    state.nextPlacement = 0;
+    for (int side = 0; side < 2; ++side) {
+        VersusPlayer& entry = state.players[side];
+        resetPlayer(side);
+        entry.lives = startingLives;
+        entry.dodges = 0;
+        entry.invulnerableUntil = state.tick + invulnerableTicks;
+    }
+}
+
+void VersusSimulation::step(const PlayerInput& first, const PlayerInput& second) {
+    state.tick++;
+    if (state.roundEndTick != 0) {
+        if (state.tick >= state.roundEndTick + intermissionTicks) {
+            startRound();
+        }
+        return;
+    }
+
+    const PlayerInput* inputs[2] = {&first, &second};
+    for (int side = 0; side < 2; ++side) {
+        VersusPlayer& entry = state.players[side];
+        if (entry.lives <= 0) {
+            continue;
+        }
+        if (physics == VersusPhysics::Fixed) {
+            entry.body.move(*inputs[side]);
+            entry.body.mirror(entry.player);
+        } else {
+            applyInput(entry.player, *inputs[side]);
+        }
+    }
+
+    if (physics == VersusPhysics::Fixed) {
+        stepFixed();
+    } else {
+        stepFloat();
+    }
+
+    bool firstOut = state.players[0].lives <= 0;
+    bool secondOut = state.players[1].lives <= 0;
+    if (firstOut || secondOut) {
+        state.roundEndTick = state.tick;
+        state.roundWinner = firstOut && secondOut ? -1 : (firstOut ? 1 : 0);
+        if (state.roundWinner >= 0) {
+            state.wins[state.roundWinner]++;
+        }
+    }
+}
+
+void VersusSimulation::stepFloat() {
+    float roundTime = static_cast<float>(state.tick - state.roundStartTick) * tickSeconds;
+    spawnDue(roundTime);
+    integrateVelocities(state.obstacles, tickSeconds);
+    collideObstacles();
+
+    // Off the bottom: a dodge for everyone still flying
+    Archetype& obstacles = state.obstacles.archetype(EntityKind::Obstacle);
+    for (std::size_t row = obstacles.size(); row-- > 0;) {
+        if (isObstacleOffscreen(obstacles.transforms[row])) {
+            removeObstacle(row);
+            for (VersusPlayer& entry : state.players) {
+                entry.dodges += entry.lives > 0 ? 1 : 0;
+            }
+        }
+    }
+
+    hitPlayers();
+}
+
+void VersusSimulation::stepFixed() {
+    spawnDueFixed(state.tick - state.roundStartTick);
+    integrateFixed(state.bodies);
+    collideFixed(state.bodies, contactScratch);
+
+    FixedBodies& bodies = state.bodies;
+    for (std::size_t row = bodies.size(); row-- > 0;) {
+        if (bodies.y[row] > offscreenY) {
+            removeObstacle(row);
+            for (VersusPlayer& entry : state.players) {
+                entry.dodges += entry.lives > 0 ? 1 : 0;
+            }
+        }
+    }
+
+    hitPlayersFixed();
+
+    // Float mirror for drawing and the spectator stream
+    Archetype& obstacles = state.obstacles.archetype(EntityKind::Obstacle);
+    for (std::size_t row = 0; row < bodies.size(); ++row) {
+        obstacles.transforms[row].position = sf::Vector2f(fromFixed(bodies.x[row]), fromFixed(bodies.y[row]));
+        obstacles.velocities[row].linear = sf::Vector2f(fromFixed(bodies.vx[row]) / tickSeconds,
+                                                        fromFixed(bodies.vy[row]) / tickSeconds);
+    }
+}
+
+void VersusSimulation::removeObstacle(std::size_t row) {
+    state.obstacles.destroyAt(EntityKind::Obstacle, row);
+    if (physics == VersusPhysics::Fixed) {
+        state.bodies.swapRemove(row);
+    }
+}
+
+void VersusSimulation::resetPlayer(int side) {
+    VersusPlayer& entry = state.players[side];
+    entry.player.reset();
+    entry.player.setPosition(startPositions[side]);
+    entry.body.place(startPositions[side].x, startPositions[side].y);
+}
+
+void VersusSimulation::spawnDue(float roundTime) {
+    for (;;) {
+        const WorldChunk& chunk = chunkFor(state.round, state.chunkIndex);
+        if (state.nextPlacement >= chunk.count) {
+            if (roundTime < chunk.request.startTime + chunk.request.duration) {
+                return;
+            }
+            state.chunkIndex++;
+            state.nextPlacement = 0;
+            continue;
+        }
+        const ObstaclePlacement& placement = chunk.placements[state.nextPlacement];
+        if (placement.time > roundTime) {
+            return;
+        }
+        state.nextPlacement++;
+        float speed = speedAt(placement.time) * placement.speedMultiplier;
+        float y = -50.0f + speed * (roundTime - placement.time);
+        createObstacle(state.obstacles, placement.x, y, speed, placement.radius, placement.speedMultiplier);
+    }
+}
+
+void VersusSimulation::collideObstacles() {
+    // A few dozen obstacles at most; pairs in row order keep it deterministic
+    Archetype& obstacles = state.obstacles.archetype(EntityKind::Obstacle);
+    for (std::size_t i = 0; i < obstacles.size(); ++i) {
+        sf::FloatRect first = obstacleBounds(obstacles, i);
+        for (std::size_t j = i + 1; j < obstacles.size(); ++j) {
+            if (first.intersects(obstacleBounds(obstacles, j))) {
+                resolveContact(obstacles.transforms[i].position, obstacles.velocities[i].linear,
+                               obstacles.colliders[i].radius,
+                               obstacles.transforms[j].position, obstacles.velocities[j].linear,
+                               obstacles.colliders[j].radius);
+            }
+        }
+    }
+}
+
+void VersusSimulation::hitPlayers() {
+    Archetype& obstacles = state.obstacles.archetype(EntityKind::Obstacle);
+    for (int side = 0; side < 2; ++side) {
+        VersusPlayer& entry = state.players[side];
+        if (entry.lives <= 0 || state.tick < entry.invulnerableUntil) {
+            continue;
+        }
+        sf::FloatRect bounds = entry.player.getBounds();
+        for (std::size_t row = 0; row < obstacles.size(); ++row) {
+            if (bounds.intersects(obstacleBounds(obstacles, row))) {
+                removeObstacle(row);
+                entry.lives--;
+                entry.invulnerableUntil = state.tick + invulnerableTicks;
+                resetPlayer(side);
+                break;
+            }
+        }
+    }
+}
+
+void VersusSimulation::spawnDueFixed(std::uint32_t roundTick) {
+    // spawnDue() on the tick grid: placements are quantized to ticks and
+    // Q16.16 as they enter, and the speed curve is integer
+    for (;;) {
+        const WorldChunk& chunk = chunkFor(state.round, state.chunkIndex);
+        if (state.nextPlacement >= chunk.count) {
+            if (roundTick < static_cast<std::uint32_t>(state.chunkIndex + 1) * chunkTicks) {
+                return;
+            }
+            state.chunkIndex++;
+            state.nextPlacement = 0;
+            continue;
+        }
+        const ObstaclePlacement& placement = chunk.placements[state.nextPlacement];
+        std::uint32_t dueTick = static_cast<std::uint32_t>(std::ceil(placement.time * 60.0f - 0.001f));
+        if (dueTick > roundTick) {
+            return;
+        }
+        state.nextPlacement++;
+        std::int64_t speed = std::min<std::int64_t>(300 + 40 * (dueTick / chunkTicks), 1200);
+        Fixed velocity = static_cast<Fixed>(speed * toFixed(placement.speedMultiplier) / 60);
+        Fixed y = -50 * fixedOne + velocity * static_cast<Fixed>(roundTick - dueTick);
+        Fixed radius = toFixed(placement.radius);
+        EntityId id = createObstacle(state.obstacles, placement.x, fromFixed(y), fromFixed(velocity) / tickSeconds,
+                                     fromFixed(radius), placement.speedMultiplier);
+        if (id.isValid()) {
+            state.bodies.push(toFixed(placement.x), y, velocity, radius);
+        }
+    }
+}
+
+void VersusSimulation::hitPlayersFixed() {
+    for (int side = 0; side < 2; ++side) {
+        VersusPlayer& entry = state.players[side];
+        if (entry.lives <= 0 || state.tick < entry.invulnerableUntil) {
+            continue;
+        }
+        Fixed half = entry.body.halfExtent();
+        std::size_t row = findFixedOverlap(state.bodies, entry.body.x - half, entry.body.y - half,
+                                           entry.body.x + half, entry.body.y + half);
+        if (row < state.bodies.size()) {
+            removeObstacle(row);
+            entry.lives--;
+            entry.invulnerableUntil = state.tick + invulnerableTicks;
+            resetPlayer(side);
+        }
+    }
+}
+
+std::uint64_t VersusSimulation::checksum(const VersusState& snapshot) const {
+    std::uint64_t hash = 14695981039346656037ull;
+    hashBytes(hash, &physics, sizeof(physics));   // Peers in different modes show up as a desync
+    hashBytes(hash, &snapshot.tick, sizeof(snapshot.tick));
+    hashBytes(hash, &snapshot.round, sizeof(snapshot.round));
+    if (physics == VersusPhysics::Fixed) {
+        // Integer state only; the float mirror is derived from it
+        for (const VersusPlayer& entry : snapshot.players) {
+            hashBytes(hash, &entry.body, sizeof(entry.body));
+            hashBytes(hash, &entry.lives, sizeof(entry.lives));
+            hashBytes(hash, &entry.dodges, sizeof(entry.dodges));
+        }
+        const FixedBodies& bodies = snapshot.bodies;
+        for (const std::vector<Fixed>* column : {&bodies.x, &bodies.y, &bodies.vx, &bodies.vy}) {
+            hashBytes(hash, column->data(), column->size() * sizeof(Fixed));
+        }
+        return hash;
+    }
+    for (const VersusPlayer& entry : snapshot.players) {
+        sf::Vector2f position = entry.player.getPosition();
+        float rotation = entry.player.getRotation();
+        hashBytes(hash, &position.x, sizeof(position.x));
+        hashBytes(hash, &position.y, sizeof(position.y));
+        hashBytes(hash, &rotation, sizeof(rotation));
+        hashBytes(hash, &entry.lives, sizeof(entry.lives));
+        hashBytes(hash, &entry.dodges, sizeof(entry.dodges));
+    }
+    const Archetype& obstacles = snapshot.obstacles.archetype(EntityKind::Obstacle);
+    for (std::size_t row = 0; row < obstacles.size(); ++row) {
+        hashBytes(hash, &obstacles.transforms[row].position.x, sizeof(float));
+        hashBytes(hash, &obstacles.transforms[row].position.y, sizeof(float));
+        hashBytes(hash, &obstacles.velocities[row].linear.x, sizeof(float));
+        hashBytes(hash, &obstacles.velocities[row].linear.y, sizeof(float));
+    }
+    return hash;
+}
+
+void VersusSimulation::draw(Renderer& renderer, int localSide) {
+    drawCircles(state.obstacles.archetype(EntityKind::Obstacle), renderer, brush);
+    for (int side = 0; side < 2; ++side) {
+        VersusPlayer& entry = state.players[side];
+        if (entry.lives <= 0) {
+            continue;
+        }
+        // Flicker while invulnerable, like the single-player flash
+        bool flicker = state.tick < entry.invulnerableUntil && (state.tick / 6) % 2 == 0;
+        entry.player.setOpacity(flicker ? 60 : (side == localSide ? 255 : 120));
+        entry.player.draw(renderer);
+    }
+}
@@ -0,0 +1,108 @@
+#pragma once
+#include "EntityStore.h"
+#include "FixedPhysics.h"
+#include "Player.h"
+#include "Renderer.h"
+#include "WorldChunk.h"
+#include <array>
+#include <cstdint>
+
+// Inputs travel as one byte per tick
+std::uint8_t encodeInput(const PlayerInput& input);
+PlayerInput decodeInput(std::uint8_t bits);
+
+// Float runs the same math as single-player. Fixed runs positions,
+// velocities and contacts in Q16.16 integers (see FixedPhysics.h), so peers
+// built with different compilers, flags or CPUs stay bit-exact; the float
+// obstacles and players are then only a mirror for drawing. Both peers must
+// use the same mode.
+enum class VersusPhysics : std::uint8_t {
+    Float,
+    Fixed
+};
+
+struct VersusPlayer {
+    Player player;
+    FixedPlayer body;                     // Fixed mode only
+    int lives = 0;
+    int dodges = 0;
+    std::uint32_t invulnerableUntil = 0;  // Tick
+};
+
+// Everything a versus tick reads or writes. Plain copyable data, so saving
+// and restoring for rollback is an assignment; once the snapshot's columns
+// have grown to the obstacle capacity that assignment no longer allocates.
+struct VersusState {
+    std::uint32_t tick = 0;
+    std::uint32_t round = 0;
+    std::uint32_t roundStartTick = 0;
+    std::uint32_t roundEndTick = 0;    // 0 while the round is being played
+    int roundWinner = -1;              // -1 draw or still playing
+    std::array<VersusPlayer, 2> players;
+    std::array<int, 2> wins = {{0, 0}};
+    EntityStore obstacles;
+    FixedBodies bodies;                // Fixed mode only; rows match the obstacle rows
+    std::uint64_t chunkIndex = 0;
+    std::uint32_t nextPlacement = 0;
+};
+
+// Deterministic two-player match: both players dodge one shared obstacle
+// field, and an obstacle that hits either of them is gone for both. Rounds
+// end when a player runs out of lives; the next one starts after a short
+// intermission with a new field. The same seed and the same inputs give the
+// same states on every peer, which is what rollback relies on.
+//
+// Obstacles follow Game's difficulty curve and come from the same chunk
+// generator. Generation here is inline rather than on the streaming worker:
+// a re-simulated tick may need any recent chunk immediately, and a chunk is a
+// pure function of (seed, round, index), so a small cache is enough.
+class VersusSimulation {
+public:
+    static constexpr float tickSeconds = 1.0f / 60.0f;
+    static constexpr int startingLives = 3;
+    static constexpr std::uint32_t invulnerableTicks = 90;
+    static constexpr std::uint32_t intermissionTicks = 180;
+    static constexpr std::size_t obstacleCapacity = 256;
+
+private:
+    static constexpr std::size_t chunkCacheSize = 4;
+
+    std::uint64_t seed;
+    VersusPhysics physics;
+    VersusState state;
+    std::vector<std::uint8_t> contactScratch;
+    std::array<WorldChunk, chunkCacheSize> chunkCache;
+    std::array<bool, chunkCacheSize> chunkCached;
+    sf::CircleShape brush;
+
+    const WorldChunk& chunkFor(std::uint32_t round, std::uint64_t index);
+    void startRound();
+    void spawnDue(float roundTime);
+    void collideObstacles();
+    void hitPlayers();
+    void stepFloat();
+    void stepFixed();
+    void spawnDueFixed(std::uint32_t roundTick);
+    void hitPlayersFixed();
+    void removeObstacle(std::size_t row);
+    void resetPlayer(int side);
+
+public:
+    explicit VersusSimulation(std::uint64_t seed, VersusPhysics physics = VersusPhysics::Float);
+
+    // One tick with both players' inputs (index 0 and 1)
+    void step(const PlayerInput& first, const PlayerInput& second);
+
+    const VersusState& getState() const { return state; }
+    void save(VersusState& snapshot) const { snapshot = state; }
+    void load(const VersusState& snapshot) { state = snapshot; }
+    void prepareSnapshot(VersusState& snapshot) const;  // Reserve so save() never allocates
+    std::uint64_t checksum() const { return checksum(state); }
+    std::uint64_t checksum(const VersusState& snapshot) const;   // Of the authoritative state
+    VersusPhysics getPhysics() const { return physics; }
+
+    float speedAt(float roundTime) const;
+
+    // Obstacles and both players; `localSide` is drawn solid, the rival faded
+    void draw(Renderer& renderer, int localSide);
+};
@@ -0,0 +1,30 @@
+#pragma once
+#include <cstdint>
+
+// One datagram between versus peers. Every packet repeats the sender's
+// inputs from the last tick the peer acknowledged (up to maxInputs), so a
+// lost packet is covered by the next one and no retransmission is needed.
+struct InputPacket {
+    static constexpr std::uint32_t magicValue = 0x54475650;  // "TGVP"
+    static constexpr std::uint32_t maxInputs = 24;
+
+    std::uint32_t magic = magicValue;
+    std::uint32_t firstTick = 0;       // Tick of inputs[0]
+    std::uint32_t ackTick = 0;         // Sender has all of the receiver's inputs before this tick
+    std::uint32_t checksumTick = 0;    // Sender's confirmed state at this tick...
+    std::uint64_t checksum = 0;        // ...hashes to this; lets the receiver detect a desync
+    std::uint8_t count = 0;
+    std::uint8_t inputs[maxInputs] = {};
+};
+
+// How versus peers reach each other.
+// MemoryTransport connects two sessions in one process, UdpTransport two
+// processes over a socket, and ConditionedTransport wraps either to add
+// latency, jitter and loss. Neither call may block.
+class VersusTransport {
+public:
+    virtual ~VersusTransport() {}
+
+    virtual bool send(const InputPacket& packet) = 0;
+    virtual bool receive(InputPacket& packet) = 0;
+};
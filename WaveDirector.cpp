@@ -0,0 +1,97 @@
+#include "WaveDirector.h"
+#include "BoidSwarm.h"
+#include "Obstacle.h"
+
+WaveDirector::WaveDirector(std::size_t capacity)
+    : frames(capacity)
+    , scripts(capacity, nullptr)
+    , wakeups(capacity)
+    , randomState(0)
+    , obstacles(nullptr)
+    , swarm(nullptr)
+    , gameSpeed(0.0f)
+    , playerPosition(0.0f, 0.0f) {
+    freeFrames.reserve(capacity);
+    for (std::size_t i = capacity; i > 0; --i) {
+        freeFrames.push_back(static_cast<std::uint32_t>(i - 1));
+    }
+    ready.reserve(capacity);
+}
+
+WaveDirector::~WaveDirector() {
+    clear(0);
+}
+
+void WaveDirector::release(std::uint32_t frame) {
+    scripts[frame]->~WaveScript();
+    scripts[frame] = nullptr;
+    freeFrames.push_back(frame);
+    stats.running--;
+}
+
+void WaveDirector::update(EntityStore& store, float speed, sf::Vector2f player, BoidSwarm* flocks) {
+    obstacles = &store;
+    swarm = flocks;
+    gameSpeed = speed;
+    playerPosition = player;
+
+    ready.clear();
+    wakeups.advance(ready);
+    for (std::uint32_t frame : ready) {
+        WaveStep step = scripts[frame]->resume(*this);
+        if (step.waitTicks == WaveStep::done) {
+            release(frame);
+            stats.finished++;
+        } else {
+            wakeups.schedule(step.waitTicks, frame);
+        }
+    }
+    stats.resumes += ready.size();
+    stats.lastReady = static_cast<std::uint32_t>(ready.size());
+    stats.peakReady = std::max(stats.peakReady, stats.lastReady);
+    obstacles = nullptr;
+    swarm = nullptr;
+}
+
+void WaveDirector::clear(std::uint64_t seed) {
+    wakeups.clear();
+    for (std::uint32_t frame = 0; frame < scripts.size(); ++frame) {
+        if (scripts[frame]) {
+            release(frame);
+        }
+    }
+    randomState = seed;
+}
+
+EntityId WaveDirector::spawn(float x, float speedMultiplier, float radius) {
+    float speed = gameSpeed * speedMultiplier;
+    EntityId id = createObstacle(*obstacles, x, -50.0f, speed, radius, speedMultiplier);
+    if (id.isValid()) {
+        stats.spawned++;
+    }
+    return id;
+}
+
+float WaveDirector::random(float low, float high) {
+    // splitmix64; same seed and same player, same waves
+    std::uint64_t value = (randomState += 0x9E3779B97F4A7C15ull);
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    value ^= value >> 31;
+    float unit = static_cast<float>(value >> 40) / static_cast<float>(1ull << 24);
+    return low + (high - low) * unit;
+}
+
+std::uint32_t WaveDirector::releaseFlock(float x, std::uint32_t count) {
+    if (!swarm) {
+        return 0;
+    }
+    std::uint32_t released = swarm->release(sf::Vector2f(x, -120.0f), count, 40.0f,
+                                            sf::Vector2f(0.0f, gameSpeed * BoidSwarm::flowRatio));
+    stats.boidsReleased += released;
+    return released;
+}
+
+std::size_t WaveDirector::getObstacleCount() const {
+    return obstacles ? obstacles->count(EntityKind::Obstacle) : 0;
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "EntityStore.h"
+#include "TimerScheduler.h"
+#include "WaveScript.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+class BoidSwarm;
+
+struct WaveStats {
+    std::uint64_t started = 0;
+    std::uint64_t finished = 0;
+    std::uint64_t dropped = 0;       // start() with the pool exhausted
+    std::uint64_t resumes = 0;
+    std::uint64_t spawned = 0;
+    std::uint64_t boidsReleased = 0;
+    std::uint32_t running = 0;
+    std::uint32_t peakRunning = 0;
+    std::uint32_t lastReady = 0;     // Scripts resumed on the latest tick
+    std::uint32_t peakReady = 0;
+};
+
+// Runs wave scripts (see WaveScript.h) on the game thread.
+// Each script lives in a fixed-size frame from a pool sized at construction
+// and has at most one wake-up pending in a TimerScheduler, so update() only
+// touches the scripts due this tick: hundreds of waiting scripts cost
+// nothing until they wake. Condition waits are re-checked every
+// WaveStep::pollTicks. Nothing allocates after construction.
+class WaveDirector {
+public:
+    static constexpr std::size_t maxScriptBytes = 128;
+    static constexpr std::size_t defaultCapacity = 32;
+
+private:
+    struct alignas(alignof(std::max_align_t)) Frame {
+        unsigned char bytes[maxScriptBytes];
+    };
+
+    std::vector<Frame> frames;
+    std::vector<WaveScript*> scripts;       // Per frame; null when free
+    std::vector<std::uint32_t> freeFrames;
+    TimerScheduler wakeups;                 // Payload is the frame index
+    std::vector<std::uint32_t> ready;
+    WaveStats stats;
+    std::uint64_t randomState;
+
+    // Valid during update(); swarm may be null
+    EntityStore* obstacles;
+    BoidSwarm* swarm;
+    float gameSpeed;
+    sf::Vector2f playerPosition;
+
+    void release(std::uint32_t frame);
+
+public:
+    explicit WaveDirector(std::size_t capacity = defaultCapacity);
+    ~WaveDirector();
+    WaveDirector(const WaveDirector&) = delete;
+    WaveDirector& operator=(const WaveDirector&) = delete;
+
+    // Starts a script on the next tick; false when the pool is full.
+    // Scripts may start other scripts from resume().
+    template <typename Script, typename... Args>
+    bool start(Args&&... args) {
+        static_assert(sizeof(Script) <= maxScriptBytes, "Wave script does not fit a pool frame");
+        static_assert(alignof(Script) <= alignof(Frame), "Wave script is over-aligned");
+        if (freeFrames.empty()) {
+            stats.dropped++;
+            return false;
+        }
+        std::uint32_t frame = freeFrames.back();
+        freeFrames.pop_back();
+        scripts[frame] = new (frames[frame].bytes) Script(std::forward<Args>(args)...);
+        wakeups.schedule(1, frame);
+        stats.started++;
+        stats.running++;
+        stats.peakRunning = std::max(stats.peakRunning, stats.running);
+        return true;
+    }
+
+    // One simulation tick: resumes the scripts that are due
+    void update(EntityStore& store, float speed, sf::Vector2f player, BoidSwarm* flocks = nullptr);
+    void clear(std::uint64_t seed);        // Ends every script and reseeds random()
+
+    // For scripts, during resume()
+    EntityId spawn(float x, float speedMultiplier, float radius);
+    std::uint32_t releaseFlock(float x, std::uint32_t count);   // Above the screen; 0 without a swarm
+    float random(float low, float high);
+    TimerScheduler::Tick now() const { return wakeups.now(); }
+    float getGameSpeed() const { return gameSpeed; }
+    sf::Vector2f getPlayerPosition() const { return playerPosition; }
+    std::size_t getObstacleCount() const;
+
+    const WaveStats& getStats() const { return stats; }
+    std::size_t capacity() const { return frames.size(); }
+};
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+
+class WaveDirector;
+
+// What a script asks for when it yields
+struct WaveStep {
+    static constexpr std::uint32_t pollTicks = 4;   // How often WAVE_WAIT_UNTIL re-checks
+    static constexpr std::uint32_t done = 0;
+
+    std::uint32_t waitTicks;   // 0 = finished
+};
+
+// A spawn pattern written as sequential code that yields between steps.
+// C++17 has no coroutines, so scripts are stackless resumable functions:
+// resume() opens with WAVE_BEGIN, yields with the WAVE_WAIT_* macros and
+// closes with WAVE_END. Anything that must survive a wait (loop counters,
+// positions) has to be a member of the script, not a local variable.
+// Only one WAVE_ macro per source line (the line number is the resume point).
+// Scripts are created in WaveDirector's fixed-size pool, so they must fit
+// in WaveDirector::maxScriptBytes.
+class WaveScript {
+protected:
+    int resumePoint = 0;
+
+public:
+    virtual ~WaveScript() {}
+    virtual WaveStep resume(WaveDirector& director) = 0;
+};
+
+#define WAVE_BEGIN switch (resumePoint) { case 0:
+
+#define WAVE_WAIT_TICKS(ticks) \
+    do { resumePoint = __LINE__; return WaveStep{(ticks) > 0 ? static_cast<std::uint32_t>(ticks) : 1u}; \
+         case __LINE__:; } while (0)
+
+#define WAVE_WAIT_SECONDS(seconds) WAVE_WAIT_TICKS(static_cast<std::uint32_t>((seconds) * 60.0f + 0.5f))
+
+#define WAVE_WAIT_UNTIL(condition) \
+    do { resumePoint = __LINE__; [[fallthrough]]; case __LINE__: \
+         if (!(condition)) return WaveStep{WaveStep::pollTicks}; } while (0)
+
+#define WAVE_END } return WaveStep{WaveStep::done}
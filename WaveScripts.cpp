@@ -0,0 +1,105 @@
+#include "WaveScripts.h"
+#include "WaveDirector.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const float fieldWidth = 480.0f;
+const float gapHalfWidth = 80.0f;       // Leaves at least the 120 the track generator keeps
+const float edgeDistance = 130.0f;      // Player x this close to a side counts as hugging it
+
+} // namespace
+
+WaveStep GapWallWave::resume(WaveDirector& director) {
+    WAVE_BEGIN;
+    gapCenter = director.random(gapHalfWidth + 20.0f, fieldWidth - gapHalfWidth - 20.0f);
+    for (row = 0; row < rows; ++row) {
+        for (float x = 6.0f; x + 36.0f <= fieldWidth; x += 48.0f) {
+            if (std::fabs(x + 18.0f - gapCenter) > gapHalfWidth) {
+                director.spawn(x, 1.0f, 18.0f);
+            }
+        }
+        WAVE_WAIT_SECONDS(0.8f);
+        // Drift no further than the player can follow in one row's time
+        gapCenter = std::min(fieldWidth - gapHalfWidth - 20.0f,
+                             std::max(gapHalfWidth + 20.0f, gapCenter + director.random(-120.0f, 120.0f)));
+    }
+    WAVE_END;
+}
+
+WaveStep ZigzagWave::resume(WaveDirector& director) {
+    WAVE_BEGIN;
+    x = director.random(40.0f, fieldWidth - 70.0f);
+    step = director.random(0.0f, 1.0f) < 0.5f ? -55.0f : 55.0f;
+    for (index = 0; index < count; ++index) {
+        director.spawn(x, 1.3f, 13.0f);
+        if (x + step < 10.0f || x + step > fieldWidth - 36.0f) {
+            step = -step;
+        }
+        x += step;
+        WAVE_WAIT_TICKS(7);
+    }
+    WAVE_END;
+}
+
+WaveStep BurstWave::resume(WaveDirector& director) {
+    WAVE_BEGIN;
+    deadline = director.now() + 5 * 60;
+    WAVE_WAIT_UNTIL(director.getObstacleCount() < 12 || director.now() >= deadline);
+    center = director.random(90.0f, fieldWidth - 90.0f);
+    for (int i = 0; i < 6; ++i) {
+        director.spawn(center + director.random(-80.0f, 50.0f), director.random(0.8f, 1.6f),
+                       director.random(10.0f, 16.0f));
+    }
+    WAVE_END;
+}
+
+WaveStep PincerWave::resume(WaveDirector& director) {
+    WAVE_BEGIN;
+    deadline = director.now() + 6 * 60;
+    WAVE_WAIT_UNTIL(director.getPlayerPosition().x < edgeDistance ||
+                    director.getPlayerPosition().x > fieldWidth - edgeDistance ||
+                    director.now() >= deadline);
+    if (director.now() >= deadline) {
+        return WaveStep{WaveStep::done};
+    }
+    x = director.getPlayerPosition().x < edgeDistance ? 10.0f : fieldWidth - 54.0f;
+    for (index = 0; index < 4; ++index) {
+        director.spawn(x, 1.1f, 20.0f);
+        WAVE_WAIT_SECONDS(0.3f);
+    }
+    WAVE_END;
+}
+
+WaveStep BarrageWave::resume(WaveDirector& director) {
+    WAVE_BEGIN;
+    for (index = 0; index < count; ++index) {
+        director.start<BurstWave>();
+        WAVE_WAIT_SECONDS(0.9f);
+    }
+    WAVE_END;
+}
+
+WaveStep SwarmWave::resume(WaveDirector& director) {
+    WAVE_BEGIN;
+    for (index = 0; index < flocks; ++index) {
+        director.releaseFlock(director.random(80.0f, fieldWidth - 80.0f), flockSize);
+        WAVE_WAIT_SECONDS(1.5f);
+    }
+    WAVE_END;
+}
+
+bool startRandomWave(WaveDirector& director, float speedRatio) {
+    // Harder set pieces join the rotation as the game speeds up
+    int choices = speedRatio < 0.3f ? 2 : speedRatio < 0.6f ? 5 : 6;
+    int choice = std::min(choices - 1, static_cast<int>(director.random(0.0f, static_cast<float>(choices))));
+    switch (choice) {
+        case 0: return director.start<BurstWave>();
+        case 1: return director.start<ZigzagWave>(8 + static_cast<int>(speedRatio * 8.0f));
+        case 2: return director.start<GapWallWave>(3);
+        case 3: return director.start<PincerWave>();
+        case 4: return director.start<SwarmWave>(2 + static_cast<int>(speedRatio * 2.0f), 160);
+        default: return director.start<BarrageWave>(3);
+    }
+}
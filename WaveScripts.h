@@ -0,0 +1,83 @@
+#pragma once
+#include "WaveScript.h"
+#include <cstdint>
+
+class WaveDirector;
+
+// Built-in set pieces. They play on top of the streamed track; see
+// startRandomWave() for when each one is picked.
+
+// Rows across the field with one gap each; the gap drifts between rows
+class GapWallWave : public WaveScript {
+private:
+    int rows;
+    int row;
+    float gapCenter;
+
+public:
+    explicit GapWallWave(int rows) : rows(rows), row(0), gapCenter(0.0f) {}
+    WaveStep resume(WaveDirector& director) override;
+};
+
+// A fast stream that sweeps back and forth across the field
+class ZigzagWave : public WaveScript {
+private:
+    int count;
+    int index;
+    float x;
+    float step;
+
+public:
+    explicit ZigzagWave(int count) : count(count), index(0), x(0.0f), step(0.0f) {}
+    WaveStep resume(WaveDirector& director) override;
+};
+
+// Waits for a quiet moment, then drops a tight cluster at mixed speeds
+class BurstWave : public WaveScript {
+private:
+    std::uint64_t deadline;
+    float center;
+
+public:
+    BurstWave() : deadline(0), center(0.0f) {}
+    WaveStep resume(WaveDirector& director) override;
+};
+
+// Punishes hugging a wall: waits for the player to reach an edge, then
+// sends a column down that side. Gives up after a few seconds.
+class PincerWave : public WaveScript {
+private:
+    std::uint64_t deadline;
+    int index;
+    float x;
+
+public:
+    PincerWave() : deadline(0), index(0), x(0.0f) {}
+    WaveStep resume(WaveDirector& director) override;
+};
+
+// Several bursts in quick succession, each its own script
+class BarrageWave : public WaveScript {
+private:
+    int count;
+    int index;
+
+public:
+    explicit BarrageWave(int count) : count(count), index(0) {}
+    WaveStep resume(WaveDirector& director) override;
+};
+
+// Flocks of boids released one after another above a random spot
+class SwarmWave : public WaveScript {
+private:
+    int flocks;
+    std::uint32_t flockSize;
+    int index;
+
+public:
+    SwarmWave(int flocks, std::uint32_t flockSize) : flocks(flocks), flockSize(flockSize), index(0) {}
+    WaveStep resume(WaveDirector& director) override;
+};
+
+// Starts one set piece suited to the difficulty (speedRatio 0 at the start, 1 at max speed)
+bool startRandomWave(WaveDirector& director, float speedRatio);
@@ -0,0 +1,221 @@
+#include "WorldChunk.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace {
+
+const float fieldWidth = 480.0f;
+const float minWallGap = 120.0f;        // The player's box is up to ~66 wide when tilted
+const float playerSpeed = 400.0f;       // Limits how far the gap may move between rows
+const float sameRowSeconds = 0.001f;
+const float outline = 1.5f;             // Obstacles are drawn and collide with this outline
+
+// Sine from basic arithmetic only, so it rounds the same everywhere (libm
+// implementations differ in the last bits). Within 2e-4 of std::sin.
+float portableSin(float x) {
+    const float pi = 3.14159265f;
+    x -= 2.0f * pi * std::floor(x / (2.0f * pi) + 0.5f);   // -pi..pi
+    if (x > 0.5f * pi) {
+        x = pi - x;
+    } else if (x < -0.5f * pi) {
+        x = -pi - x;
+    }
+    float x2 = x * x;
+    return x * (1.0f - x2 / 6.0f * (1.0f - x2 / 20.0f * (1.0f - x2 / 42.0f)));
+}
+
+std::uint64_t mixSeed(std::uint64_t value) {
+    // splitmix64
+    value += 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+struct Builder {
+    WorldChunk& chunk;
+    std::mt19937 gen;
+
+    // mt19937's output is fixed by the standard; uniform_real_distribution's
+    // mapping is not, so it is done here to give every platform the same track
+    float uniform(float low, float high) {
+        float unit = static_cast<float>(gen() >> 8) * (1.0f / 16777216.0f);
+        return low + (high - low) * unit;
+    }
+
+    bool add(float time, float x, float multiplier, float radius) {
+        if (chunk.count >= WorldChunk::maxPlacements) {
+            return false;
+        }
+        chunk.placements[chunk.count++] = ObstaclePlacement{time, x, multiplier, radius, ObstacleKind::Straight};
+        return true;
+    }
+};
+
+void buildScatter(Builder& b, float start, float end, float interval) {
+    // Same ranges as the original timer-driven spawner
+    for (float t = start; t < end; t += interval * b.uniform(0.7f, 1.3f)) {
+        if (!b.add(t, b.uniform(60.0f, 420.0f), b.uniform(0.5f, 2.0f), b.uniform(15.0f, 35.0f))) {
+            return;
+        }
+    }
+}
+
+void buildWalls(Builder& b, float start, float end, float interval) {
+    float rowSpacing = std::min(1.2f, std::max(0.6f, interval * 3.0f));
+    float maxShift = 0.5f * playerSpeed * rowSpacing;   // Reachable with room to spare
+    float gapLeft = b.uniform(20.0f, fieldWidth - 20.0f - minWallGap);
+    for (float t = start + 0.2f; t < end; t += rowSpacing) {
+        float radius = b.uniform(16.0f, 22.0f);
+        float pitch = 2.0f * (radius + outline) + 6.0f;
+        float multiplier = b.uniform(0.8f, 1.2f);
+        for (float x = b.uniform(0.0f, 8.0f); x + 2.0f * radius <= fieldWidth; x += pitch) {
+            bool inGap = x + 2.0f * (radius + outline) > gapLeft && x - outline < gapLeft + minWallGap;
+            if (!inGap && !b.add(t, x, multiplier, radius)) {
+                return;
+            }
+        }
+        float shifted = gapLeft + b.uniform(-maxShift, maxShift);
+        gapLeft = std::min(fieldWidth - 20.0f - minWallGap, std::max(20.0f, shifted));
+    }
+}
+
+void buildZigzag(Builder& b, float start, float end, float interval) {
+    float phase = b.uniform(0.0f, 6.2832f);
+    for (float t = start; t < end; t += interval * 0.8f) {
+        float x = 210.0f + 170.0f * portableSin(phase);
+        phase += b.uniform(0.5f, 1.0f);
+        if (!b.add(t, x, b.uniform(0.9f, 1.3f), b.uniform(15.0f, 28.0f))) {
+            return;
+        }
+    }
+}
+
+void buildLanes(Builder& b, float start, float end, float interval) {
+    float lanes[2] = {b.uniform(40.0f, 150.0f), b.uniform(270.0f, 380.0f)};
+    int lane = 0;
+    for (float t = start; t < end; t += interval * 0.7f) {
+        if (!b.add(t, lanes[lane], b.uniform(1.0f, 1.6f), b.uniform(15.0f, 25.0f))) {
+            return;
+        }
+        lane = 1 - lane;
+    }
+}
+
+void assignKinds(WorldChunk& chunk, float difficulty) {
+    // Only scattered singles change kind; walls and lanes keep their shape.
+    // A stream of its own, so the layout of the track does not change.
+    const ChunkRequest& request = chunk.request;
+    std::mt19937 gen(static_cast<std::uint32_t>(mixSeed(request.worldSeed ^ mixSeed(request.index) ^ 0x4B494E44ull)));
+    float share = 0.1f + 0.4f * difficulty;
+    for (std::size_t i = 0; i < chunk.count; ++i) {
+        float roll = static_cast<float>(gen() >> 8) * (1.0f / 16777216.0f);
+        if (roll < share) {
+            chunk.placements[i].kind = static_cast<ObstacleKind>(1 + gen() % (static_cast<unsigned>(ObstacleKind::Count) - 1));
+        }
+    }
+}
+
+float largestRowGap(const WorldChunk& chunk, std::size_t first, std::size_t last, float& gapStart) {
+    // Members of a row are generated left to right
+    float edge = 0.0f;
+    float largest = 0.0f;
+    gapStart = 0.0f;
+    for (std::size_t i = first; i < last; ++i) {
+        const ObstaclePlacement& p = chunk.placements[i];
+        if (p.x - outline - edge > largest) {
+            largest = p.x - outline - edge;
+            gapStart = edge;
+        }
+        edge = std::max(edge, p.x + 2.0f * p.radius + outline);
+    }
+    if (fieldWidth - edge > largest) {
+        largest = fieldWidth - edge;
+        gapStart = edge;
+    }
+    return largest;
+}
+
+} // namespace
+
+void generateChunk(WorldChunk& chunk) {
+    const ChunkRequest& request = chunk.request;
+    Builder builder{chunk, std::mt19937(static_cast<std::uint32_t>(mixSeed(request.worldSeed ^ mixSeed(request.index))))};
+    chunk.count = 0;
+
+    // Denser patterns show up as the spawn interval shrinks; the first chunk is always gentle
+    float difficulty = std::min(1.0f, std::max(0.0f, (1.0f - request.spawnInterval) / 0.8f));
+    chunk.pattern = ChunkPattern::Scatter;
+    if (request.index > 0 && builder.uniform(0.0f, 1.0f) < 0.7f * difficulty) {
+        chunk.pattern = static_cast<ChunkPattern>(1 + builder.gen() % 3);
+    }
+
+    float start = request.startTime;
+    float end = request.startTime + request.duration;
+    float interval = std::max(0.05f, request.spawnInterval);
+    switch (chunk.pattern) {
+        case ChunkPattern::Scatter: buildScatter(builder, start, end, interval); break;
+        case ChunkPattern::Walls:   buildWalls(builder, start, end, interval); break;
+        case ChunkPattern::Zigzag:  buildZigzag(builder, start, end, interval); break;
+        case ChunkPattern::Lanes:   buildLanes(builder, start, end, interval); break;
+        case ChunkPattern::Count:   break;
+    }
+    if (chunk.pattern == ChunkPattern::Scatter && request.index > 0) {
+        assignKinds(chunk, difficulty);
+    }
+}
+
+int validateChunk(WorldChunk& chunk) {
+    int dropped = 0;
+    std::size_t kept = 0;
+
+    // Keep x on screen and drop anything that would start out touching an
+    // earlier placement (the pair response would scatter it immediately)
+    for (std::size_t i = 0; i < chunk.count; ++i) {
+        ObstaclePlacement p = chunk.placements[i];
+        p.x = std::min(fieldWidth - 2.0f * p.radius, std::max(0.0f, p.x));
+        bool overlaps = false;
+        for (std::size_t j = kept; j-- > 0;) {
+            const ObstaclePlacement& q = chunk.placements[j];
+            if (p.time - q.time > 0.05f) {
+                break;
+            }
+            float reach = p.radius + q.radius + 2.0f * outline;
+            if (std::abs((p.x + p.radius) - (q.x + q.radius)) < reach) {
+                overlaps = true;
+                break;
+            }
+        }
+        if (overlaps) {
+            dropped++;
+            continue;
+        }
+        chunk.placements[kept++] = p;
+    }
+    chunk.count = static_cast<std::uint32_t>(kept);
+
+    // Every row of three or more must leave a gap the player fits through
+    std::size_t first = 0;
+    while (first < chunk.count) {
+        std::size_t last = first + 1;
+        while (last < chunk.count && chunk.placements[last].time - chunk.placements[first].time < sameRowSeconds) {
+            last++;
+        }
+        float gapStart = 0.0f;
+        while (last - first >= 3 && largestRowGap(chunk, first, last, gapStart) < minWallGap) {
+            // Remove the member just right of the widest gap, widening it
+            std::size_t victim = first;
+            while (victim + 1 < last && chunk.placements[victim].x < gapStart) {
+                victim++;
+            }
+            std::copy(chunk.placements.begin() + victim + 1, chunk.placements.begin() + chunk.count,
+                      chunk.placements.begin() + victim);
+            chunk.count--;
+            last--;
+            dropped++;
+        }
+        first = last;
+    }
+    return dropped;
+}
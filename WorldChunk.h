@@ -0,0 +1,59 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Layout of each chunk of the track
+enum class ChunkPattern : std::uint8_t {
+    Scatter,    // Singles at random positions, like the original spawner
+    Walls,      // Rows across the screen with one gap to fly through
+    Zigzag,     // Singles sweeping from side to side
+    Lanes,      // Two columns taking turns
+    Count
+};
+
+// How an obstacle moves once it spawns. Anything but Straight also runs the
+// matching policy from ObstacleBehaviours.h every tick.
+enum class ObstacleKind : std::uint8_t {
+    Straight,
+    Weaving,        // Sways from side to side around its spawn column
+    Homing,         // Steers sideways towards the player until it is level
+    Accelerating,   // Keeps speeding up as it falls
+    Splitting,      // Breaks into two smaller obstacles when another one hits it
+    Count
+};
+
+// One obstacle to drop at the top of the screen at `time` (gameplay seconds)
+struct ObstaclePlacement {
+    float time;
+    float x;                  // Left edge, like Transform::position
+    float speedMultiplier;    // Applied to gameSpeed when it spawns; also picks the colour
+    float radius;
+    ObstacleKind kind;
+};
+
+// What the game asks the worker to generate
+struct ChunkRequest {
+    std::uint64_t index;      // Chunk i covers [i, i + 1) * duration seconds of play
+    std::uint32_t epoch;      // Bumped on restart; chunks from older epochs are discarded
+    std::uint64_t worldSeed;
+    float startTime;
+    float duration;
+    float spawnInterval;      // Forecast for when the chunk plays; sets density
+};
+
+struct WorldChunk {
+    static constexpr std::size_t maxPlacements = 64;
+
+    ChunkRequest request;
+    ChunkPattern pattern;
+    std::uint32_t count;
+    std::array<ObstaclePlacement, maxPlacements> placements;  // Sorted by time
+};
+
+// Fills `chunk` from chunk.request. The same request always gives the same chunk.
+void generateChunk(WorldChunk& chunk);
+
+// Drops placements that would overlap another one as they spawn and opens up
+// any wall row whose gap is too narrow for the player. Returns how many were dropped.
+int validateChunk(WorldChunk& chunk);
@@ -0,0 +1,219 @@
+#include "WorldStreamer.h"
+#include <chrono>
+#include <cmath>
+
+WorldStreamer::WorldStreamer()
+    : running(false)
+    , chunksGenerated(0)
+    , placementsDropped(0)
+    , worstGenerateMicros(0)
+    , worldSeed(0)
+    , epoch(0)
+    , nextRequest(0)
+    , expected(0)
+    , inFlight(0)
+    , active(nullptr)
+    , held(nullptr)
+    , nextPlacement(0)
+    , skipBefore(0.0f)
+    , waitForLateChunks(false)
+    , chunksMissed(0)
+    , lateWaits(0) {
+    for (auto& count : patternCounts) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    for (WorldChunk& chunk : pool) {
+        chunk.count = 0;
+        recycled.push(&chunk);
+    }
+}
+
+WorldStreamer::~WorldStreamer() {
+    stop();
+}
+
+void WorldStreamer::start() {
+    if (running) {
+        return;
+    }
+    running = true;
+    worker = std::thread(&WorldStreamer::workerLoop, this);
+}
+
+void WorldStreamer::stop() {
+    if (!running) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        running = false;
+    }
+    wake.notify_one();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void WorldStreamer::workerLoop() {
+    while (running) {
+        ChunkRequest request;
+        if (!requests.pop(request)) {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wake.wait_for(lock, std::chrono::milliseconds(5),
+                          [this] { return !running || requests.size() > 0; });
+            continue;
+        }
+
+        // The pool is sized so a chunk is always back before long
+        WorldChunk* chunk = nullptr;
+        while (!recycled.pop(chunk)) {
+            if (!running) {
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        auto begin = std::chrono::steady_clock::now();
+        chunk->request = request;
+        generateChunk(*chunk);
+        int dropped = validateChunk(*chunk);
+        auto micros = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - begin).count();
+
+        placementsDropped.fetch_add(static_cast<std::uint64_t>(dropped), std::memory_order_relaxed);
+        patternCounts[static_cast<std::size_t>(chunk->pattern)].fetch_add(1, std::memory_order_relaxed);
+        if (static_cast<std::uint32_t>(micros) > worstGenerateMicros.load(std::memory_order_relaxed)) {
+            worstGenerateMicros.store(static_cast<std::uint32_t>(micros), std::memory_order_relaxed);
+        }
+        chunksGenerated.fetch_add(1, std::memory_order_relaxed);
+        ready.push(chunk);  // Can't fail: it holds the whole pool
+    }
+}
+
+void WorldStreamer::restart(std::uint64_t seed, float time) {
+    release(active);
+    release(held);
+    worldSeed = seed;
+    epoch++;
+    expected = static_cast<std::uint64_t>(std::floor(std::max(0.0f, time) / chunkSeconds));
+    nextRequest = expected;
+    nextPlacement = 0;
+    skipBefore = time;
+}
+
+bool WorldStreamer::wantsChunk(float time, ChunkRequest& request) const {
+    std::uint64_t current = static_cast<std::uint64_t>(std::floor(std::max(0.0f, time) / chunkSeconds));
+    std::uint64_t first = std::max(nextRequest, expected);
+    if (first > std::max(current, expected) + lookaheadChunks) {
+        return false;
+    }
+    request.index = first;
+    request.epoch = epoch;
+    request.worldSeed = worldSeed;
+    request.startTime = static_cast<float>(first) * chunkSeconds;
+    request.duration = chunkSeconds;
+    request.spawnInterval = 1.0f;
+    return true;
+}
+
+bool WorldStreamer::submit(const ChunkRequest& request) {
+    if (!requests.push(request)) {
+        return false;
+    }
+    nextRequest = request.index + 1;
+    inFlight++;
+    wake.notify_one();
+    return true;
+}
+
+void WorldStreamer::release(WorldChunk*& chunk) {
+    if (chunk) {
+        recycled.push(chunk);
+        chunk = nullptr;
+    }
+}
+
+bool WorldStreamer::acquire(std::uint64_t index) {
+    if (held && held->request.index <= index) {
+        if (held->request.index == index) {
+            active = held;
+            held = nullptr;
+            return true;
+        }
+        release(held);
+    }
+    if (held) {
+        return false;
+    }
+
+    WorldChunk* chunk = nullptr;
+    while (ready.pop(chunk)) {
+        inFlight--;
+        if (chunk->request.epoch != epoch || chunk->request.index < index) {
+            release(chunk);  // From before a restart, or played without it
+            continue;
+        }
+        if (chunk->request.index == index) {
+            active = chunk;
+            return true;
+        }
+        held = chunk;
+        return false;
+    }
+    return false;
+}
+
+bool WorldStreamer::nextDue(float time, ObstaclePlacement& placement) {
+    for (;;) {
+        if (active) {
+            while (nextPlacement < active->count) {
+                const ObstaclePlacement& next = active->placements[nextPlacement];
+                if (next.time > time) {
+                    return false;
+                }
+                nextPlacement++;
+                if (next.time >= skipBefore) {
+                    placement = next;
+                    return true;
+                }
+            }
+            if (time < active->request.startTime + active->request.duration) {
+                return false;
+            }
+            // Played out: behind the player now, hand it back for reuse
+            release(active);
+            expected++;
+        }
+
+        if (time < static_cast<float>(expected) * chunkSeconds) {
+            return false;
+        }
+        nextPlacement = 0;
+        if (acquire(expected)) {
+            continue;
+        }
+        if (waitForLateChunks && nextRequest > expected && inFlight > 0) {
+            lateWaits++;
+            while (!acquire(expected)) {
+                std::this_thread::yield();
+            }
+            continue;
+        }
+        // Not ready: leave this stretch empty rather than generate here
+        chunksMissed++;
+        expected++;
+    }
+}
+
+WorldStats WorldStreamer::getStats() const {
+    WorldStats stats;
+    stats.chunksGenerated = chunksGenerated.load(std::memory_order_relaxed);
+    stats.chunksMissed = chunksMissed;
+    stats.lateWaits = lateWaits;
+    stats.placementsDropped = placementsDropped.load(std::memory_order_relaxed);
+    stats.worstGenerateMicros = worstGenerateMicros.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < static_cast<std::size_t>(ChunkPattern::Count); ++i) {
+        stats.patternCounts[i] = patternCounts[i].load(std::memory_order_relaxed);
+    }
+    return stats;
+}
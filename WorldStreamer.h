@@ -0,0 +1,94 @@
+#pragma once
+#include "SpscQueue.h"
+#include "WorldChunk.h"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+struct WorldStats {
+    std::uint64_t chunksGenerated = 0;
+    std::uint64_t chunksMissed = 0;        // Due before the worker finished; skipped
+    std::uint64_t lateWaits = 0;           // Headless: waited for the worker instead of skipping
+    std::uint64_t placementsDropped = 0;   // Removed by validation
+    std::uint32_t worstGenerateMicros = 0;
+    std::uint64_t patternCounts[static_cast<std::size_t>(ChunkPattern::Count)] = {};
+};
+
+// Streams the track ahead of the player in seeded chunks.
+// The game thread queues requests for the next few chunks; a worker thread
+// generates and validates them into chunks from a fixed pool and hands them
+// back through a wait-free SPSC queue. Chunks that have played out go back
+// to the worker through a second queue, so nothing allocates after start()
+// and the game thread never runs the generator.
+class WorldStreamer {
+public:
+    static constexpr float chunkSeconds = 2.0f;           // One speed step
+    static constexpr std::uint64_t lookaheadChunks = 3;    // ~6 s of track queued
+    static constexpr std::size_t poolSize = 8;
+
+private:
+    std::array<WorldChunk, poolSize> pool;
+    SpscQueue<ChunkRequest, 16> requests;              // Game -> worker
+    SpscQueue<WorldChunk*, poolSize + 1> ready;        // Worker -> game
+    SpscQueue<WorldChunk*, poolSize + 1> recycled;     // Game -> worker
+
+    std::thread worker;
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::atomic<bool> running;
+
+    // Written by the worker
+    std::atomic<std::uint64_t> chunksGenerated;
+    std::atomic<std::uint64_t> placementsDropped;
+    std::atomic<std::uint32_t> worstGenerateMicros;
+    std::atomic<std::uint64_t> patternCounts[static_cast<std::size_t>(ChunkPattern::Count)];
+
+    // Game thread only
+    std::uint64_t worldSeed;
+    std::uint32_t epoch;
+    std::uint64_t nextRequest;
+    std::uint64_t expected;        // Index of the chunk playing (or due next)
+    std::uint32_t inFlight;        // Requested but not yet popped from `ready`
+    WorldChunk* active;
+    WorldChunk* held;              // Popped ahead of time
+    std::uint32_t nextPlacement;
+    float skipBefore;
+    bool waitForLateChunks;
+    std::uint64_t chunksMissed;
+    std::uint64_t lateWaits;
+
+    void workerLoop();
+    bool acquire(std::uint64_t index);
+    void release(WorldChunk*& chunk);
+
+public:
+    WorldStreamer();
+    ~WorldStreamer();
+    WorldStreamer(const WorldStreamer&) = delete;
+    WorldStreamer& operator=(const WorldStreamer&) = delete;
+
+    void start();
+    void stop();
+
+    // Headless runs tick far faster than real time and would outrun the
+    // worker; with this set they wait for a late chunk instead of skipping it.
+    void setWaitForLateChunks(bool enabled) { waitForLateChunks = enabled; }
+
+    // Game thread. Starts a new track from `time` (gameplay seconds); chunks
+    // already requested are discarded when they arrive.
+    void restart(std::uint64_t seed, float time);
+
+    // Game thread. True while another chunk should be requested; fills in
+    // everything but the difficulty forecast. Follow with submit().
+    bool wantsChunk(float time, ChunkRequest& request) const;
+    bool submit(const ChunkRequest& request);
+
+    // Game thread. Pops the next placement due at or before `time`.
+    bool nextDue(float time, ObstaclePlacement& placement);
+
+    std::uint64_t getSeed() const { return worldSeed; }
+    WorldStats getStats() const;
+};
@@ -0,0 +1,133 @@
+// Steady-state allocation check.
+// Plays a scripted gameplay session headlessly with the global operator
+// new/delete replaced (TRIANGLE_ALLOC_TRACKING) and fails (exit code 1) if any
+// frame after warm-up allocates. The only exception is the HUD: frames where
+// the score, speed or lives text changed may allocate in the UI and Render
+// tags, because sf::Text rebuilds its string and geometry then. Audio runs
+// through a NullAudioSink, so the mixer thread is counted as well, and the
+// spectator stream is encoded every tick (to /dev/null). Before warm-up it
+// waits for the asset loader thread to finish the font, so its load and the
+// text rebuild it causes are never measured, however slow the disk is.
+// Usage: AllocationCheck [frames]
+#include "../Game.h"
+#include "../RecordingRenderer.h"
+#include "../AllocationTracker.h"
+#include "../NullAudioSink.h"
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace {
+
+const float tickDelta = 1.0f / 60.0f;
+const int warmUpFrames = 60 * 10;
+const std::chrono::seconds assetTimeout(30);
+
+PlayerInput scriptedInput(int frame) {
+    // Same weave as RenderBudgetCheck: exercises trails, rotation and power states
+    PlayerInput input;
+    input.left = (frame / 30) % 2 == 0;
+    input.right = !input.left;
+    input.forward = (frame / 45) % 2 == 0;
+    return input;
+}
+
+bool isHudTag(AllocTag tag) {
+    return tag == AllocTag::UI || tag == AllocTag::Render;
+}
+
+void printFrame(int frame, const AllocationSnapshot& delta) {
+    std::cout << "  frame " << frame << ":";
+    for (std::size_t i = 0; i < static_cast<std::size_t>(AllocTag::Count); ++i) {
+        AllocTag tag = static_cast<AllocTag>(i);
+        if (delta[tag].allocations > 0) {
+            std::cout << " " << AllocationTracker::tagName(tag) << "=" << delta[tag].allocations
+                      << " (" << delta[tag].bytesAllocated << " B)";
+        }
+    }
+    std::cout << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (!AllocationTracker::enabled()) {
+        std::cerr << "AllocationCheck must be built with TRIANGLE_ALLOC_TRACKING" << std::endl;
+        return 2;
+    }
+
+    int measuredFrames = argc > 1 ? std::stoi(argv[1]) : 60 * 60;
+
+    auto recorder = std::make_unique<RecordingRenderer>();
+    RecordingRenderer& renderer = *recorder;
+    Game game(std::move(recorder));
+    game.enableAudio(std::make_unique<NullAudioSink>());
+    game.enableSpectatorOutput("/dev/null");
+    game.setState(GameState::Playing);
+    game.reset();
+    if (!game.waitForStartupAssets(assetTimeout)) {
+        std::cerr << "Startup assets still loading after " << assetTimeout.count() << " s" << std::endl;
+        return 1;
+    }
+
+    int hudFrames = 0;
+    int restarts = 0;
+    int violations = 0;
+    for (int frame = 0; frame < warmUpFrames + measuredFrames; ++frame) {
+        // Restarting after a game over is part of the steady state too
+        if (game.getState() != GameState::Playing) {
+            game.setState(GameState::Playing);
+            game.reset();
+            restarts++;
+        }
+
+        AllocationSnapshot before = AllocationTracker::snapshot();
+        game.setInput(scriptedInput(frame));
+        game.tick(tickDelta);
+        game.renderFrame();
+        AllocationSnapshot delta = AllocationTracker::difference(before, AllocationTracker::snapshot());
+
+        if (frame < warmUpFrames || delta.totalAllocations() == 0) {
+            continue;
+        }
+
+        bool hudChanged = renderer.getFrameStats().textRebuilds > 0;
+        bool allowed = hudChanged;
+        for (std::size_t i = 0; i < static_cast<std::size_t>(AllocTag::Count); ++i) {
+            AllocTag tag = static_cast<AllocTag>(i);
+            if (delta[tag].allocations > 0 && !isHudTag(tag)) {
+                allowed = false;
+            }
+        }
+
+        if (allowed) {
+            hudFrames++;
+        } else {
+            if (violations < 20) {
+                printFrame(frame, delta);
+            }
+            violations++;
+        }
+    }
+
+    std::cout << "Measured " << measuredFrames << " frames after " << warmUpFrames
+              << " warm-up frames (" << restarts << " restarts): "
+              << violations << " allocating frames, "
+              << hudFrames << " HUD text rebuild frames" << std::endl;
+    std::cout << "Frame arena: peak " << game.getFrameArena().getHighWater() << " bytes, "
+              << game.getFrameArena().getOverflows() << " overflows" << std::endl;
+    if (const AudioMixer* audio = game.getAudio()) {
+        AudioStats stats = audio->getStats();
+        std::cout << "Audio: peak " << stats.peakVoices << " voices, " << stats.voicesStolen << " stolen, "
+                  << stats.commandsDropped << " commands dropped" << std::endl;
+    }
+    if (const SpectatorEncoder* spectator = game.getSpectatorEncoder()) {
+        const SpectatorStats& stats = spectator->getStats();
+        std::cout << "Spectator: " << stats.frames << " frames, " << (stats.frames ? stats.bytes * 60 / stats.frames : 0)
+                  << " bytes/s at 60 fps, largest " << stats.largestFrame << " bytes" << std::endl;
+    }
+    game.logAllocationReport();
+
+    return violations == 0 ? 0 : 1;
+}
@@ -0,0 +1,80 @@
+// Autopilot soak run.
+// Plays full games headlessly with the autopilot driving, from the normal
+// start until the speed reaches maxSpeed and then a further minute at that
+// speed. Reports how far each session got and what the planner cost per tick.
+// Exits 1 if any session ends in a game over before reaching maxSpeed.
+// Usage: AutopilotSoak [sessions] [budget-us]
+#include "../Game.h"
+#include "../RecordingRenderer.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+const float tickDelta = 1.0f / 60.0f;
+const int ticksAtMaxSpeed = 60 * 60;
+const int maxTicks = 60 * 60 * 5;   // Stop a session that somehow never speeds up
+
+double percentile(std::vector<double>& values, double fraction) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    return values[static_cast<std::size_t>(fraction * (values.size() - 1) + 0.5)];
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int sessions = argc > 1 ? std::stoi(argv[1]) : 3;
+    float budgetMicros = argc > 2 ? std::stof(argv[2]) : Autopilot::defaultBudgetMicros;
+
+    int failures = 0;
+    for (int session = 0; session < sessions; ++session) {
+        Game game(std::make_unique<RecordingRenderer>());
+        game.setAutopilot(true, budgetMicros);
+        game.setState(GameState::Playing);
+        game.reset();
+
+        std::vector<double> planMicros;
+        planMicros.reserve(maxTicks);
+        int tick = 0;
+        int maxSpeedTick = -1;
+        for (; tick < maxTicks && game.getState() == GameState::Playing; ++tick) {
+            game.tick(tickDelta);
+            game.renderFrame();
+            planMicros.push_back(game.getAutopilot()->getStats().lastPlanMicros);
+
+            if (maxSpeedTick < 0 && game.getGameSpeed() >= game.getMaxSpeed()) {
+                maxSpeedTick = tick;
+            }
+            if (maxSpeedTick >= 0 && tick - maxSpeedTick >= ticksAtMaxSpeed) {
+                break;
+            }
+        }
+
+        const AutopilotStats& stats = game.getAutopilot()->getStats();
+        bool reachedMax = maxSpeedTick >= 0;
+        if (!reachedMax) {
+            failures++;
+        }
+        double meanCandidates = stats.plans > 0 ? static_cast<double>(stats.candidatesEvaluated) / stats.plans : 0.0;
+        std::cout << std::fixed << std::setprecision(1)
+                  << "Session " << session + 1 << ": "
+                  << (reachedMax ? "reached max speed at " + std::to_string(maxSpeedTick / 60) + " s"
+                                 : std::string("game over before max speed"))
+                  << ", survived " << tick / 60.0f << " s, speed " << game.getGameSpeed()
+                  << ", score " << game.getScore() << ", lives " << game.getLives() << std::endl
+                  << "  planner: p50 " << percentile(planMicros, 0.50) << " us, p99 "
+                  << percentile(planMicros, 0.99) << " us, worst " << stats.worstPlanMicros
+                  << " us (budget " << budgetMicros << "), " << meanCandidates << " candidates/tick, "
+                  << stats.budgetOverruns << " overruns" << std::endl;
+    }
+
+    std::cout << (sessions - failures) << "/" << sessions << " sessions reached max speed" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
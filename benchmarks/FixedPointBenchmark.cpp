@@ -0,0 +1,160 @@
+// Float vs fixed-point obstacle physics.
+// Times one tick of integration plus pairwise contacts for a dense field in
+// each mode, then plays a scripted ten-minute versus match twice in each
+// mode and digests every tick's state checksum. The fixed-point digest is
+// the same on every build and machine: compare it across compilers, flags
+// and CPUs. Fails (exit code 1) if two runs in one process disagree.
+// Usage: FixedPointBenchmark [ticks]
+#include "../EntitySystems.h"
+#include "../FixedPhysics.h"
+#include "../Obstacle.h"
+#include "../VersusSimulation.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+const float tickDelta = 1.0f / 60.0f;
+const float wrapY = 880.0f;
+const float wrapDistance = 930.0f;
+
+struct Body {
+    float x;
+    float y;
+    float speed;
+    float radius;
+};
+
+std::vector<Body> makeField(std::size_t count) {
+    std::mt19937 gen(99);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<Body> field(count);
+    for (Body& body : field) {
+        body = Body{440.0f * unit(gen), -50.0f + 930.0f * unit(gen), 300.0f + 2100.0f * unit(gen),
+                    10.0f + 25.0f * unit(gen)};
+    }
+    return field;
+}
+
+double timeFloat(const std::vector<Body>& field, int ticks) {
+    EntityStore store;
+    store.setCapacity(EntityKind::Obstacle, field.size());
+    for (const Body& body : field) {
+        createObstacle(store, body.x, body.y, body.speed, body.radius, 1.0f);
+    }
+    Archetype& obstacles = store.archetype(EntityKind::Obstacle);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < ticks; ++tick) {
+        integrateVelocities(store, tickDelta);
+        // VersusSimulation::collideObstacles
+        for (std::size_t i = 0; i < obstacles.size(); ++i) {
+            sf::FloatRect first = obstacleBounds(obstacles, i);
+            for (std::size_t j = i + 1; j < obstacles.size(); ++j) {
+                if (first.intersects(obstacleBounds(obstacles, j))) {
+                    resolveContact(obstacles.transforms[i].position, obstacles.velocities[i].linear,
+                                   obstacles.colliders[i].radius,
+                                   obstacles.transforms[j].position, obstacles.velocities[j].linear,
+                                   obstacles.colliders[j].radius);
+                }
+            }
+        }
+        for (Transform& transform : obstacles.transforms) {
+            if (transform.position.y > wrapY) {
+                transform.position.y -= wrapDistance;
+            }
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / ticks;
+}
+
+double timeFixed(const std::vector<Body>& field, int ticks) {
+    FixedBodies bodies;
+    bodies.reserve(field.size());
+    for (const Body& body : field) {
+        bodies.push(toFixed(body.x), toFixed(body.y), toFixed(body.speed * tickDelta), toFixed(body.radius));
+    }
+    std::vector<std::uint8_t> scratch;
+    scratch.reserve(field.size());
+    const Fixed fixedWrapY = toFixed(wrapY);
+    const Fixed fixedWrapDistance = toFixed(wrapDistance);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < ticks; ++tick) {
+        integrateFixed(bodies);
+        collideFixed(bodies, scratch);
+        for (Fixed& y : bodies.y) {
+            y -= y > fixedWrapY ? fixedWrapDistance : 0;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / ticks;
+}
+
+// Holds a random key combination for a few ticks, as RollbackCheck does
+PlayerInput scriptedInput(std::mt19937& gen, PlayerInput& held, int& remaining) {
+    if (remaining-- <= 0) {
+        held = decodeInput(static_cast<std::uint8_t>(gen() % 16));
+        remaining = 2 + static_cast<int>(gen() % 12);
+    }
+    return held;
+}
+
+std::uint64_t playMatch(VersusPhysics physics, int ticks, double& nsPerTick) {
+    VersusSimulation simulation(20240601, physics);
+    std::mt19937 gens[2] = {std::mt19937(1), std::mt19937(2)};
+    PlayerInput held[2];
+    int remaining[2] = {0, 0};
+    std::uint64_t digest = 14695981039346656037ull;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < ticks; ++tick) {
+        PlayerInput first = scriptedInput(gens[0], held[0], remaining[0]);
+        PlayerInput second = scriptedInput(gens[1], held[1], remaining[1]);
+        simulation.step(first, second);
+        digest = (digest ^ simulation.checksum()) * 1099511628211ull;
+    }
+    auto end = std::chrono::steady_clock::now();
+    nsPerTick = std::chrono::duration<double, std::nano>(end - start).count() / ticks;
+    return digest;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int ticks = argc > 1 ? std::stoi(argv[1]) : 60 * 60 * 10;
+
+    std::cout << "Obstacle physics per tick (integrate + contacts)\n";
+    std::cout << std::setw(10) << "bodies" << std::setw(12) << "float ns" << std::setw(12) << "fixed ns"
+              << std::setw(10) << "ratio" << "\n";
+    for (std::size_t count : {32, 64, 128, 256}) {
+        std::vector<Body> field = makeField(count);
+        double floatNs = timeFloat(field, 6000);
+        double fixedNs = timeFixed(field, 6000);
+        std::cout << std::setw(10) << count << std::fixed << std::setprecision(1)
+                  << std::setw(12) << floatNs << std::setw(12) << fixedNs
+                  << std::setw(9) << floatNs / fixedNs << "x\n";
+    }
+
+    bool ok = true;
+    std::cout << "Versus match, " << ticks << " ticks, per-tick checksums digested\n";
+    for (VersusPhysics physics : {VersusPhysics::Float, VersusPhysics::Fixed}) {
+        double firstNs = 0.0;
+        double secondNs = 0.0;
+        std::uint64_t first = playMatch(physics, ticks, firstNs);
+        std::uint64_t second = playMatch(physics, ticks, secondNs);
+        bool same = first == second;
+        ok = ok && same;
+        std::cout << (physics == VersusPhysics::Fixed ? "fixed" : "float") << ": digest " << std::hex
+                  << std::setw(16) << std::setfill('0') << first << std::dec << std::setfill(' ')
+                  << (same ? "" : " (second run differs!)") << ", " << std::setprecision(0)
+                  << firstNs << " ns per tick\n";
+    }
+    std::cout << (ok ? "Deterministic within this build" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
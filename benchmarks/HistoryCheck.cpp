@@ -0,0 +1,170 @@
+// Run history check.
+// Fills a history with a kiosk's worth of runs, then times what the game
+// does at startup and on game over: open the file, read the top entries and
+// today's tally. Fails (exit code 1) if that is slow, or if the top-N or
+// per-day index disagrees with a full scan. Then kills a writer mid-append
+// again and again and fails if a reopen ever finds a damaged commit.
+// Usage: HistoryCheck [runs] [file]
+#include "../RunHistory.h"
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+const double startupBudgetMicros = 20000.0;
+const int crashRounds = 20;
+const std::uint64_t firstTimestamp = 1700000000;   // Nov 2023
+const std::uint64_t secondsPerRun = 47;
+
+double microsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool checkIndexes(const RunHistory& history, const std::vector<std::int32_t>& scores, std::uint32_t lastDay) {
+    // Top 10 by score, earlier runs first on ties
+    std::vector<std::uint32_t> order(scores.size());
+    for (std::uint32_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(),
+        [&](std::uint32_t a, std::uint32_t b) { return scores[a] > scores[b]; });
+    std::uint32_t best[10];
+    std::uint32_t count = history.top(best, 10);
+    if (count != std::min<std::size_t>(10, scores.size()) || !std::equal(best, best + count, order.begin())) {
+        std::cout << "Top-N index disagrees with a full scan" << std::endl;
+        return false;
+    }
+
+    std::uint32_t runs = 0;
+    std::int32_t bestScore = 0;
+    for (std::uint32_t i = 0; i < scores.size(); ++i) {
+        if (history.record(i).day == lastDay) {
+            bestScore = runs == 0 ? scores[i] : std::max(bestScore, scores[i]);
+            runs++;
+        }
+    }
+    RunDay day;
+    if (!history.findDay(lastDay, day) || day.runs != runs || history.record(day.bestRecord).score != bestScore) {
+        std::cout << "Day index disagrees with a full scan" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool checkCrashes(const std::string& path) {
+    std::remove(path.c_str());
+    std::mt19937 gen(7);
+    std::uint32_t lastSize = 0;
+    for (int round = 0; round < crashRounds; ++round) {
+        pid_t child = fork();
+        if (child == 0) {
+            RunHistory writer;
+            if (!writer.open(path)) {
+                _exit(1);
+            }
+            for (std::uint64_t i = 0;; ++i) {
+                writer.append(firstTimestamp + i * secondsPerRun, i, 60.0f, 900.0f, static_cast<std::int32_t>(i % 977));
+            }
+        }
+        usleep(1000 + gen() % 20000);
+        kill(child, SIGKILL);
+        waitpid(child, nullptr, 0);
+
+        RunHistory history;
+        if (!history.open(path)) {
+            std::cout << "Round " << round << ": no intact commit after the writer was killed" << std::endl;
+            return false;
+        }
+        std::uint32_t size = history.size();
+        std::uint32_t best[RunHistory::topCapacity];
+        std::uint32_t count = history.top(best, RunHistory::topCapacity);
+        bool intact = size >= lastSize;
+        for (std::uint32_t i = 0; i < size && intact; ++i) {
+            intact = history.isValid(history.record(i));
+        }
+        for (std::uint32_t i = 0; i < count && intact; ++i) {
+            intact = best[i] < size && (i == 0 || history.record(best[i - 1]).score >= history.record(best[i]).score);
+        }
+        if (!intact) {
+            std::cout << "Round " << round << ": damaged history after the writer was killed" << std::endl;
+            return false;
+        }
+        lastSize = size;
+    }
+    std::cout << "Killed the writer " << crashRounds << " times mid-append: " << lastSize
+              << " runs, every commit intact" << std::endl;
+    std::remove(path.c_str());
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::uint32_t runs = argc > 1 ? static_cast<std::uint32_t>(std::stoul(argv[1])) : 2000000;
+    std::string path = argc > 2 ? argv[2] : "HistoryCheck.tgh";
+    std::remove(path.c_str());
+
+    // Bulk fill without syncs; commits are still ordered
+    std::vector<std::int32_t> scores(runs);
+    std::mt19937 gen(20240601);
+    std::uint32_t lastDay = 0;
+    {
+        RunHistory history;
+        if (!history.open(path)) {
+            return 1;
+        }
+        history.setSyncCommits(false);
+        auto start = std::chrono::steady_clock::now();
+        for (std::uint32_t i = 0; i < runs; ++i) {
+            std::uint64_t timestamp = firstTimestamp + i * secondsPerRun;
+            scores[i] = static_cast<std::int32_t>(gen() % 100000);
+            if (history.append(timestamp, gen(), 30.0f + (gen() % 1200) / 10.0f, 1200.0f, scores[i]) < 0) {
+                return 1;
+            }
+            lastDay = RunHistory::dayOf(timestamp);
+        }
+        double micros = microsSince(start);
+        std::cout << "Appended " << runs << " runs in " << static_cast<int>(micros / 1000.0) << " ms ("
+                  << micros * 1000.0 / std::max<std::uint32_t>(runs, 1) << " ns per run)" << std::endl;
+    }
+
+    // What startup and the game-over screen cost
+    bool ok = true;
+    {
+        auto start = std::chrono::steady_clock::now();
+        RunHistory history;
+        if (!history.open(path)) {
+            return 1;
+        }
+        std::uint32_t best[5];
+        std::uint32_t count = history.top(best, 5);
+        std::int64_t checksum = 0;
+        for (std::uint32_t i = 0; i < count; ++i) {
+            checksum += history.record(best[i]).score;
+        }
+        RunDay day;
+        history.findDay(lastDay, day);
+        double micros = microsSince(start);
+        std::cout << "Open + top 5 + day tally: " << micros << " us (" << history.size() << " runs, best "
+                  << checksum / std::max<std::uint32_t>(count, 1) << " avg of top " << count << ", "
+                  << day.runs << " runs on the last day)" << std::endl;
+        if (micros > startupBudgetMicros) {
+            std::cout << "Startup query over budget (" << startupBudgetMicros << " us)" << std::endl;
+            ok = false;
+        }
+        ok = checkIndexes(history, scores, lastDay) && ok;
+    }
+    std::remove(path.c_str());
+
+    ok = checkCrashes(path) && ok;
+    std::cout << (ok ? "Run history OK" : "Run history FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
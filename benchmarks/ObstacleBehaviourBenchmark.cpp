@@ -0,0 +1,250 @@
+// Obstacle kinds: per-tick cost of the behaviour step plus integration for
+//  - straight:  every obstacle straight, the single loop Game ran before kinds
+//  - + batches: the same field with ObstacleBehaviours::update run on empty
+//               batches, i.e. what kinds cost a field that has none
+//  - mixed:     about a fifth of each kind in their static per-kind batches
+//  - virtual:   the same mix as heap objects with a virtual update each, in
+//               spawn order (the layout the batches replace)
+// Kinds are spread over the field in a scrambled order.
+// Mixed and virtual run the same policy steps, so their fields must end up
+// identical. Exits non-zero if they differ or the empty batches slow the
+// straight loop down noticeably.
+// Usage: ObstacleBehaviourBenchmark [ticks]
+#include "../ObstacleBehaviours.h"
+#include "../Obstacle.h"
+#include "../EntityStore.h"
+#include "../EntitySystems.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+
+const float tickDelta = 1.0f / 60.0f;
+const int repeats = 7;                  // Best of, to keep scheduler noise out of the comparison
+const double overheadLimit = 0.10;      // Allowed slowdown of the straight loop from empty batches
+const double overheadSlackNs = 200.0;   // Absolute slack per tick for the tiny fields
+
+ObstacleKind kindFor(std::size_t index, bool mixed) {
+    if (!mixed) {
+        return ObstacleKind::Straight;
+    }
+    // Kinds arrive in no particular order, as they do from the track
+    std::uint32_t hash = static_cast<std::uint32_t>(index) * 2654435761u;
+    return static_cast<ObstacleKind>((hash >> 16) % static_cast<std::uint32_t>(ObstacleKind::Count));
+}
+
+void spawnPosition(std::size_t index, float& x, float& y, float& radius) {
+    x = 40.0f + static_cast<float>((index * 37) % 380);
+    y = -50.0f + static_cast<float>((index * 53) % 900);
+    radius = 15.0f + static_cast<float>(index % 21);
+}
+
+// Obstacles that fall off the bottom start again at the top, so the field
+// keeps its size and mix for the whole run
+void wrap(Transform& transform) {
+    if (transform.position.y > 880.0f) {
+        transform.position.y -= 930.0f;
+    }
+}
+
+struct Field {
+    EntityStore store;
+    ObstacleBehaviours behaviours;
+
+    Field(std::size_t count, bool mixed)
+        : behaviours(count) {
+        store.setCapacity(EntityKind::Obstacle, count);
+        for (std::size_t i = 0; i < count; ++i) {
+            float x, y, radius;
+            spawnPosition(i, x, y, radius);
+            EntityId id = createObstacle(store, x, y, 600.0f, radius, 1.0f);
+            behaviours.attach(store, id, kindFor(i, mixed), 0.0f);
+        }
+    }
+
+    void tick(const BehaviourContext& context, bool runBehaviours) {
+        if (runBehaviours) {
+            behaviours.update(store, context);
+        }
+        integrateVelocities(store, context.deltaTime);
+        Archetype& obstacles = store.archetype(EntityKind::Obstacle);
+        for (std::size_t i = 0; i < obstacles.size(); ++i) {
+            wrap(obstacles.transforms[i]);
+        }
+    }
+};
+
+// One heap object per obstacle, dispatched through a vtable
+class VirtualObstacle {
+public:
+    Transform transform;
+    Velocity velocity;
+    Collider collider;
+
+    virtual ~VirtualObstacle() = default;
+    virtual void update(const BehaviourContext& context) = 0;
+};
+
+template <typename Behaviour>
+class PolicyObstacle : public VirtualObstacle {
+private:
+    typename Behaviour::State state;
+
+public:
+    explicit PolicyObstacle(const typename Behaviour::State& start) : state(start) {}
+
+    void update(const BehaviourContext& context) override {
+        Behaviour::step(state, transform, velocity, collider, context);
+        transform.position += velocity.linear * context.deltaTime;
+        wrap(transform);
+    }
+};
+
+class StraightObstacle : public VirtualObstacle {
+public:
+    void update(const BehaviourContext& context) override {
+        transform.position += velocity.linear * context.deltaTime;
+        wrap(transform);
+    }
+};
+
+template <typename Behaviour>
+std::unique_ptr<VirtualObstacle> makePolicy(const Collider& collider, Velocity& velocity) {
+    auto state = Behaviour::start(0.0f, collider, velocity);
+    return std::make_unique<PolicyObstacle<Behaviour>>(state);
+}
+
+std::vector<std::unique_ptr<VirtualObstacle>> makeVirtualField(std::size_t count) {
+    std::vector<std::unique_ptr<VirtualObstacle>> field;
+    for (std::size_t i = 0; i < count; ++i) {
+        float x, y, radius;
+        spawnPosition(i, x, y, radius);
+        Collider collider;
+        collider.radius = radius;
+        Velocity velocity;
+        velocity.linear = sf::Vector2f(0.0f, 600.0f);
+        std::unique_ptr<VirtualObstacle> obstacle;
+        switch (kindFor(i, true)) {
+            case ObstacleKind::Weaving:      obstacle = makePolicy<WeaveBehaviour>(collider, velocity); break;
+            case ObstacleKind::Homing:       obstacle = makePolicy<HomingBehaviour>(collider, velocity); break;
+            case ObstacleKind::Accelerating: obstacle = makePolicy<AccelerateBehaviour>(collider, velocity); break;
+            case ObstacleKind::Splitting:    obstacle = makePolicy<SplitBehaviour>(collider, velocity); break;
+            default:                         obstacle = std::make_unique<StraightObstacle>(); break;
+        }
+        obstacle->transform.position = sf::Vector2f(x, y);
+        obstacle->velocity = velocity;
+        obstacle->collider = collider;
+        field.push_back(std::move(obstacle));
+    }
+    return field;
+}
+
+BehaviourContext contextAt(int tick) {
+    BehaviourContext context;
+    context.time = tick * tickDelta;
+    context.deltaTime = tickDelta;
+    context.target = sf::Vector2f(240.0f + 150.0f * std::sin(tick * 0.02f), 760.0f);
+    return context;
+}
+
+template <typename Tick>
+double nsPerTick(int ticks, int firstTick, Tick tick) {
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    for (int i = 0; i < ticks; ++i) {
+        tick(firstTick + i);
+    }
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / ticks;
+}
+
+// Best of several runs each; the two alternate so drift in machine load hits both
+template <typename First, typename Second>
+void bestNsPerTick(int ticks, First first, Second second, double& firstNs, double& secondNs) {
+    firstNs = 1e30;
+    secondNs = 1e30;
+    for (int repeat = 0; repeat < repeats; ++repeat) {
+        firstNs = std::min(firstNs, nsPerTick(ticks, repeat * ticks, first));
+        secondNs = std::min(secondNs, nsPerTick(ticks, repeat * ticks, second));
+    }
+}
+
+struct Result {
+    double straightNs = 0.0;
+    double emptyBatchesNs = 0.0;
+    double mixedNs = 0.0;
+    double virtualNs = 0.0;
+    double maxDifference = 0.0;   // Between the mixed field and the virtual one, in px
+};
+
+Result run(std::size_t count, int ticks) {
+    Result result;
+    Field straight(count, false);
+    Field emptyBatches(count, false);
+    bestNsPerTick(ticks,
+                  [&straight](int tick) { straight.tick(contextAt(tick), false); },
+                  [&emptyBatches](int tick) { emptyBatches.tick(contextAt(tick), true); },
+                  result.straightNs, result.emptyBatchesNs);
+
+    Field mixed(count, true);
+    auto virtualField = makeVirtualField(count);
+    bestNsPerTick(ticks,
+                  [&mixed](int tick) { mixed.tick(contextAt(tick), true); },
+                  [&virtualField](int tick) {
+                      BehaviourContext context = contextAt(tick);
+                      for (auto& obstacle : virtualField) {
+                          obstacle->update(context);
+                      }
+                  },
+                  result.mixedNs, result.virtualNs);
+
+    // Both were created in spawn order and nothing despawns, so rows line up
+    const Archetype& obstacles = mixed.store.archetype(EntityKind::Obstacle);
+    for (std::size_t i = 0; i < count; ++i) {
+        sf::Vector2f difference = obstacles.transforms[i].position - virtualField[i]->transform.position;
+        result.maxDifference = std::max<double>(result.maxDifference,
+                                                std::fabs(difference.x) + std::fabs(difference.y));
+    }
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int ticks = argc > 1 ? std::max(1, std::atoi(argv[1])) : 2000;
+    const std::size_t counts[] = {64, 256, 1024, 4096};
+
+    std::cout << "Obstacle kinds, best of " << repeats << " x " << ticks << " ticks, ns per obstacle per tick\n";
+    std::cout << std::setw(10) << "obstacles" << std::setw(11) << "straight" << std::setw(11) << "+ batches"
+              << std::setw(9) << "mixed" << std::setw(10) << "virtual" << std::setw(14) << "max diff px" << "\n";
+
+    bool ok = true;
+    std::cout << std::fixed;
+    for (std::size_t count : counts) {
+        Result result = run(count, ticks);
+        double perObstacle = 1.0 / static_cast<double>(count);
+        std::cout << std::setw(10) << count << std::setprecision(2)
+                  << std::setw(11) << result.straightNs * perObstacle
+                  << std::setw(11) << result.emptyBatchesNs * perObstacle
+                  << std::setw(9) << result.mixedNs * perObstacle
+                  << std::setw(10) << result.virtualNs * perObstacle
+                  << std::setprecision(4) << std::setw(14) << result.maxDifference << "\n";
+
+        if (result.maxDifference > 1e-2) {
+            std::cout << "  batched and virtual obstacles moved differently\n";
+            ok = false;
+        }
+        if (result.emptyBatchesNs > result.straightNs * (1.0 + overheadLimit) + overheadSlackNs) {
+            std::cout << "  empty behaviour batches slowed the straight loop down\n";
+            ok = false;
+        }
+    }
+    std::cout << (ok ? "OK" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
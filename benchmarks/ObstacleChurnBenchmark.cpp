@@ -0,0 +1,162 @@
+// Spawn/despawn churn: heap-allocated obstacle objects (the layout Game used
+// before the EntityStore) vs obstacle rows in the EntityStore.
+// Mirrors Game::update's spawn -> integrate -> dodge removal sequence
+// at a fixed 60 Hz tick with obstacles moving at maxSpeed.
+#include "../Obstacle.h"
+#include "../EntityStore.h"
+#include "../EntitySystems.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+const float tickDelta = 1.0f / 60.0f;
+const float maxSpeed = 1200.0f;
+const int simulatedTicks = 60 * 60 * 5;  // Five minutes of gameplay
+
+struct Scenario {
+    const char* name;
+    float spawnInterval;  // Seconds between spawns
+    int spawnsPerTick;    // Obstacles spawned each time the interval elapses
+};
+
+// Stand-in for the old Obstacle class: one heap object per obstacle, each
+// owning its own drawable that is kept in sync on every update. Draws the
+// same random numbers per spawn as createObstacle so only the storage differs.
+class LegacyObstacle {
+private:
+    sf::CircleShape shape;
+    sf::Vector2f position;
+    sf::Vector2f velocity;
+
+public:
+    LegacyObstacle(float x, float y, float speed)
+        : position(x, y) {
+        static std::mt19937 gen(1234);
+        static std::uniform_real_distribution<float> sizeDis(15.0f, 35.0f);
+        static std::uniform_real_distribution<float> speedVarDis(0.95f, 1.05f);
+        shape.setRadius(sizeDis(gen));
+        velocity = sf::Vector2f(0, speed * speedVarDis(gen));
+        shape.setPosition(position);
+        shape.setOutlineThickness(1.5f);
+    }
+
+    void update(float deltaTime) {
+        position += velocity * deltaTime;
+        shape.setPosition(position);
+    }
+
+    bool isOffscreen() const { return position.y > 880.0f; }
+};
+
+float spawnX(int counter) {
+    return 60.0f + static_cast<float>((counter * 37) % 360);
+}
+
+double runLegacy(const Scenario& scenario, std::size_t& peak) {
+    std::vector<std::unique_ptr<LegacyObstacle>> obstacles;
+    float spawnTimer = 0.0f;
+    int counter = 0;
+    peak = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < simulatedTicks; ++tick) {
+        spawnTimer += tickDelta;
+        if (spawnTimer >= scenario.spawnInterval) {
+            spawnTimer = 0.0f;
+            for (int i = 0; i < scenario.spawnsPerTick; ++i) {
+                obstacles.push_back(std::make_unique<LegacyObstacle>(spawnX(counter++), -50.0f, maxSpeed));
+            }
+        }
+        for (auto& obstacle : obstacles) {
+            obstacle->update(tickDelta);
+        }
+        obstacles.erase(
+            std::remove_if(obstacles.begin(), obstacles.end(),
+                [](const std::unique_ptr<LegacyObstacle>& obstacle) { return obstacle->isOffscreen(); }),
+            obstacles.end()
+        );
+        peak = std::max(peak, obstacles.size());
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / simulatedTicks;
+}
+
+double runEntities(const Scenario& scenario, std::size_t capacity, std::size_t& peak, int& dropped) {
+    EntityStore store;
+    Archetype& obstacles = store.archetype(EntityKind::Obstacle);
+    obstacles.setCapacity(capacity);
+    float spawnTimer = 0.0f;
+    int counter = 0;
+    peak = 0;
+    dropped = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < simulatedTicks; ++tick) {
+        spawnTimer += tickDelta;
+        if (spawnTimer >= scenario.spawnInterval) {
+            spawnTimer = 0.0f;
+            for (int i = 0; i < scenario.spawnsPerTick; ++i) {
+                if (!createObstacle(store, spawnX(counter++), -50.0f, maxSpeed).isValid()) {
+                    dropped++;
+                }
+            }
+        }
+        integrateVelocities(store, tickDelta);
+        for (std::size_t i = obstacles.size(); i > 0; --i) {
+            if (isObstacleOffscreen(obstacles.transforms[i - 1])) {
+                store.destroyAt(EntityKind::Obstacle, i - 1);
+            }
+        }
+        peak = std::max(peak, obstacles.size());
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / simulatedTicks;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t capacity = 1024;
+    if (argc > 1) {
+        capacity = static_cast<std::size_t>(std::stoul(argv[1]));
+    }
+
+    const Scenario scenarios[] = {
+        {"min interval (0.2 s)", 0.2f, 1},
+        {"stress: every tick", 0.0f, 1},
+        {"stress: 4 per tick", 0.0f, 4},
+        {"stress: 16 per tick", 0.0f, 16},
+    };
+
+    std::cout << "Obstacle churn over " << simulatedTicks << " ticks, obstacle capacity " << capacity << "\n";
+    std::cout << std::left << std::setw(24) << "scenario"
+              << std::right << std::setw(12) << "legacy ns"
+              << std::setw(12) << "entity ns"
+              << std::setw(10) << "speedup"
+              << std::setw(8) << "peak"
+              << std::setw(10) << "dropped" << "\n";
+
+    for (const auto& scenario : scenarios) {
+        std::size_t legacyPeak = 0;
+        std::size_t entityPeak = 0;
+        int dropped = 0;
+        double legacy = runLegacy(scenario, legacyPeak);
+        double entities = runEntities(scenario, capacity, entityPeak, dropped);
+
+        std::cout << std::left << std::setw(24) << scenario.name
+                  << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(12) << legacy
+                  << std::setw(12) << entities
+                  << std::setw(9) << (legacy / entities) << "x"
+                  << std::setw(8) << entityPeak
+                  << std::setw(10) << dropped << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,96 @@
+// Headless render budget check.
+// Drives each scene through the RecordingRenderer and fails (exit code 1)
+// when the worst frame exceeds the scene's draw-call or vertex budget.
+// Usage: RenderBudgetCheck [dump-directory]
+#include "../Game.h"
+#include "../RecordingRenderer.h"
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace {
+
+const float tickDelta = 1.0f / 60.0f;
+
+struct SceneResult {
+    RenderStats worst;
+};
+
+// Run a scene for the given number of frames and keep the worst frame
+SceneResult runScene(Game& game, RecordingRenderer& renderer, int frames,
+                     const std::string& dumpPath) {
+    SceneResult result;
+    for (int frame = 0; frame < frames; ++frame) {
+        // Weave left and right so the trail and rotation code is exercised
+        PlayerInput input;
+        input.left = (frame / 30) % 2 == 0;
+        input.right = !input.left;
+        input.forward = (frame / 45) % 2 == 0;
+        game.setInput(input);
+
+        game.tick(tickDelta);
+        game.renderFrame();
+
+        const RenderStats& stats = renderer.getFrameStats();
+        if (stats.drawCalls > result.worst.drawCalls) {
+            result.worst.drawCalls = stats.drawCalls;
+            if (!dumpPath.empty()) {
+                renderer.writeLastFrame(dumpPath);
+            }
+        }
+        result.worst.vertices = std::max(result.worst.vertices, stats.vertices);
+        result.worst.stateChanges = std::max(result.worst.stateChanges, stats.stateChanges);
+        result.worst.textRebuilds = std::max(result.worst.textRebuilds, stats.textRebuilds);
+    }
+    return result;
+}
+
+bool report(const char* scene, const SceneResult& result, const RenderBudget& budget) {
+    bool ok = budget.allows(result.worst);
+    std::cout << scene
+              << ": draws " << result.worst.drawCalls << "/" << budget.maxDrawCalls
+              << ", vertices " << result.worst.vertices << "/" << budget.maxVertices
+              << ", state changes " << result.worst.stateChanges
+              << ", text rebuilds " << result.worst.textRebuilds
+              << (ok ? "  OK" : "  OVER BUDGET") << std::endl;
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string dumpDirectory = argc > 1 ? argv[1] : "";
+    auto dumpPath = [&dumpDirectory](const char* scene) {
+        return dumpDirectory.empty() ? std::string() : dumpDirectory + "/" + scene + ".txt";
+    };
+
+    // Budgets per scene, sized with headroom over the current worst frames
+    const RenderBudget menuBudget{60, 2500};
+    const RenderBudget gameplayBudget{600, 20000};
+    const RenderBudget gameOverBudget{70, 3000};
+
+    auto recorder = std::make_unique<RecordingRenderer>();
+    RecordingRenderer& renderer = *recorder;
+    renderer.setRecording(!dumpDirectory.empty());
+    Game game(std::move(recorder));
+
+    bool ok = true;
+    ok &= report("menu", runScene(game, renderer, 120, dumpPath("menu")), menuBudget);
+
+    game.setState(GameState::Playing);
+    game.reset();
+    ok &= report("gameplay", runScene(game, renderer, 60 * 30, dumpPath("gameplay")), gameplayBudget);
+
+    // Reduced internal resolution adds only the upscale quad
+    game.setRenderScale(0.7f);
+    game.setState(GameState::Playing);
+    game.reset();
+    ok &= report("gameplay-scaled", runScene(game, renderer, 60 * 10, dumpPath("gameplay-scaled")), gameplayBudget);
+    game.setRenderScale(1.0f);
+
+    game.setState(GameState::GameOver);
+    ok &= report("game-over", runScene(game, renderer, 120, dumpPath("game-over")), gameOverBudget);
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,169 @@
+// Versus rollback check.
+// Runs two RollbackSessions in one process, each with its own scripted
+// erratic input, over links with increasing latency, jitter and loss (plus
+// one over real loopback UDP sockets), and two of them again in fixed-point
+// mode. Every frame it records each side's confirmed-state checksum and fails (exit code 1) if the two sides ever
+// disagree about a confirmed tick. It also fails if a frame's re-simulation
+// does not fit the 60 Hz frame budget. Reports rollback depth and
+// re-simulation cost per frame.
+// Usage: RollbackCheck [frames]
+#include "../ConditionedTransport.h"
+#include "../MemoryTransport.h"
+#include "../RollbackSession.h"
+#include "../UdpTransport.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+const float frameBudgetMicros = 1e6f / 60.0f;
+const std::uint64_t seed = 20240601;
+
+struct Scenario {
+    const char* name;
+    LinkConditions conditions;
+    bool udp;
+    VersusPhysics physics = VersusPhysics::Float;
+};
+
+// Holds a random key combination for a few ticks, so predictions miss often
+class ScriptedInput {
+private:
+    std::mt19937 gen;
+    PlayerInput held;
+    int remaining;
+
+public:
+    explicit ScriptedInput(std::uint32_t seed) : gen(seed), remaining(0) {}
+
+    PlayerInput next() {
+        if (remaining-- <= 0) {
+            std::uint8_t bits = static_cast<std::uint8_t>(gen() % 16);
+            held = decodeInput(bits);
+            remaining = 2 + static_cast<int>(gen() % 12);
+        }
+        return held;
+    }
+};
+
+double percentile(std::vector<double>& values, double fraction) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    return values[static_cast<std::size_t>(fraction * (values.size() - 1) + 0.5)];
+}
+
+bool runScenario(const Scenario& scenario, int frames) {
+    std::unique_ptr<VersusTransport> links[2];
+    if (scenario.udp) {
+        auto first = std::make_unique<UdpTransport>();
+        auto second = std::make_unique<UdpTransport>();
+        if (!first->open(47801, 47802) || !second->open(47802, 47801)) {
+            std::cout << scenario.name << ": loopback sockets unavailable, skipped" << std::endl;
+            return true;
+        }
+        links[0] = std::move(first);
+        links[1] = std::move(second);
+    } else {
+        auto pair = MemoryTransport::createPair();
+        links[0] = std::move(pair.first);
+        links[1] = std::move(pair.second);
+    }
+
+    ConditionedTransport* conditioned[2];
+    std::unique_ptr<RollbackSession> sessions[2];
+    ScriptedInput inputs[2] = {ScriptedInput(1), ScriptedInput(2)};
+    for (int side = 0; side < 2; ++side) {
+        LinkConditions conditions = scenario.conditions;
+        conditions.seed += side;
+        auto wrapped = std::make_unique<ConditionedTransport>(std::move(links[side]), conditions);
+        wrapped->useManualClock();
+        conditioned[side] = wrapped.get();
+        sessions[side] = std::make_unique<RollbackSession>(std::move(wrapped), side, seed, scenario.physics);
+    }
+
+    // checksums[side][tick] of confirmed states, 0 = not seen
+    std::vector<std::uint64_t> checksums[2];
+    std::vector<double> resimMicros;
+    PlayerInput pending[2];
+    bool consumed[2] = {true, true};
+    for (int frame = 0; frame < frames; ++frame) {
+        for (int side = 0; side < 2; ++side) {
+            conditioned[side]->advanceClock(1.0 / 60.0);
+            if (consumed[side]) {
+                pending[side] = inputs[side].next();
+            }
+            RollbackSession& session = *sessions[side];
+            consumed[side] = session.advance(pending[side]);
+            resimMicros.push_back(session.getStats().lastResimMicros);
+
+            std::uint32_t tick = session.getConfirmedTick();
+            if (checksums[side].size() <= tick) {
+                checksums[side].resize(tick + 1, 0);
+            }
+            checksums[side][tick] = session.getConfirmedChecksum();
+        }
+    }
+
+    int mismatches = 0;
+    int compared = 0;
+    std::size_t common = std::min(checksums[0].size(), checksums[1].size());
+    for (std::size_t tick = 1; tick < common; ++tick) {
+        if (checksums[0][tick] != 0 && checksums[1][tick] != 0) {
+            compared++;
+            mismatches += checksums[0][tick] != checksums[1][tick] ? 1 : 0;
+        }
+    }
+
+    const RollbackStats& a = sessions[0]->getStats();
+    const RollbackStats& b = sessions[1]->getStats();
+    std::uint64_t rollbacks = a.rollbacks + b.rollbacks;
+    std::uint64_t resimulated = a.resimulatedTicks + b.resimulatedTicks;
+    double p99 = percentile(resimMicros, 0.99);
+    double worst = resimMicros.empty() ? 0.0 : resimMicros.back();
+    const VersusState& state = sessions[0]->getSimulation().getState();
+
+    std::cout << std::fixed << std::setprecision(1)
+              << scenario.name << ": " << a.ticks << "/" << b.ticks << " ticks, "
+              << (a.stalls + b.stalls) << " stalls, " << rollbacks << " rollbacks, depth avg "
+              << (rollbacks ? static_cast<double>(resimulated) / rollbacks : 0.0)
+              << " max " << std::max(a.maxDepth, b.maxDepth)
+              << ", resim per frame p99 " << p99 << " us worst " << worst << " us, "
+              << "rounds " << state.round << " (wins " << state.wins[0] << "-" << state.wins[1] << "), "
+              << compared << " confirmed ticks compared, " << mismatches << " mismatches, "
+              << (a.desyncs + b.desyncs) << " desyncs reported"
+              << std::endl;
+
+    return mismatches == 0 && a.desyncs + b.desyncs == 0 && compared > 0 &&
+           std::max(a.maxDepth, b.maxDepth) <= RollbackSession::maxRollbackTicks && p99 < frameBudgetMicros;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int frames = argc > 1 ? std::stoi(argv[1]) : 60 * 60;
+
+    // latency ms (one way), jitter ms, loss rate, seed
+    const Scenario scenarios[] = {
+        {"memory-ideal", {0.0f, 0.0f, 0.0f, 1}, false},
+        {"memory-30ms", {30.0f, 10.0f, 0.0f, 1}, false},
+        {"memory-50ms-lossy", {50.0f, 20.0f, 0.1f, 1}, false},
+        {"memory-100ms", {100.0f, 30.0f, 0.05f, 1}, false},
+        {"udp-loopback-20ms", {20.0f, 5.0f, 0.02f, 1}, true},
+        {"fixed-memory-50ms-lossy", {50.0f, 20.0f, 0.1f, 1}, false, VersusPhysics::Fixed},
+        {"fixed-udp-loopback-20ms", {20.0f, 5.0f, 0.02f, 1}, true, VersusPhysics::Fixed},
+    };
+
+    int failures = 0;
+    for (const Scenario& scenario : scenarios) {
+        failures += runScenario(scenario, frames) ? 0 : 1;
+    }
+    std::cout << (failures == 0 ? "All scenarios consistent" : "FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
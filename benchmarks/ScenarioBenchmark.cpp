@@ -0,0 +1,424 @@
+// End-to-end scenario benchmark.
+// Drives the full Game tick + render path (through the RecordingRenderer, so
+// all of Game's draw code runs but no GPU work is done) over fixed scripted
+// scenarios and reports per-scenario frame-time percentiles, throughput and
+// peak RSS growth as JSON. Each scenario runs in its own process. Every scenario plays the same seeded track each run.
+// With --repeat each scenario runs several times and the report keeps the
+// best timings, which keeps load from other processes out of the numbers. With --baseline it compares against a previous
+// report and exits 1 when any scenario regressed past the threshold.
+// Reports also hold the time of a fixed reference workload, and baseline
+// timings are scaled by it first, so a report from another machine still
+// compares. benchmarks/scenario-baseline.json is the reference report that
+// the CTest run compares against.
+// Usage: ScenarioBenchmark [--output report.json] [--baseline baseline.json]
+//                          [--threshold 0.15] [--repeat 1] [--only scenario]
+#include "../Game.h"
+#include "../RecordingRenderer.h"
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <cstdlib>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+const float tickDelta = 1.0f / 60.0f;
+const std::uint64_t worldSeed = 0x5eed7a1e;
+
+struct Scenario {
+    const char* name;
+    GameState state;
+    int frames;
+    float speed;           // 0 = leave the game's own progression alone
+    float spawnInterval;
+    bool cascade;          // Drop clustered obstacle bursts that collide in chains
+    bool autopilot;        // The planner drives instead of the scripted weave
+    int lives;             // 0 = the game's own; enough keeps one session going for the whole run
+};
+
+struct ScenarioResult {
+    const char* name = "";
+    int frames = 0;
+    int restarts = 0;
+    double p50Us = 0.0;
+    double p90Us = 0.0;
+    double p99Us = 0.0;
+    double maxUs = 0.0;
+    double ticksPerSecond = 0.0;
+    long rssGrowthKb = 0;             // Peak RSS above the process at the start of the scenario
+    std::size_t arenaPeakBytes = 0;   // Per-tick scratch high-water, for sizing the frame arena
+    double referenceUs = 0.0;         // See referenceUs(); the same for every scenario of a report
+};
+static_assert(std::is_trivially_copyable<ScenarioResult>::value, "ScenarioResult is sent back through a pipe");
+
+PlayerInput scriptedInput(int frame) {
+    // Weave left and right with bursts of thrust, like a player dodging
+    PlayerInput input;
+    input.left = (frame / 30) % 2 == 0;
+    input.right = !input.left;
+    input.forward = (frame / 45) % 2 == 0;
+    return input;
+}
+
+long peakRssKb() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;  // Bytes on macOS
+#else
+    return usage.ru_maxrss;         // Kilobytes on Linux
+#endif
+}
+
+// Fixed CPU work that runs none of the game's code: a dependent random walk
+// with branches and float updates over a buffer bigger than L1. Its time
+// tells how fast this machine is, so baselines from another one can be scaled.
+double referenceUs() {
+    std::vector<float> values(1 << 15, 1.0f);
+    double best = 1e30;
+    for (int run = 0; run < 20; ++run) {
+        auto start = std::chrono::steady_clock::now();
+        std::uint32_t state = 12345u;
+        float sum = 0.0f;
+        for (int step = 0; step < (1 << 18); ++step) {
+            state = state * 1664525u + 1013904223u;
+            float& value = values[state >> 17];
+            value = (state & 0x100u) ? value * 0.999f + 0.001f : value * 1.001f - 0.001f;
+            sum += value;
+        }
+        best = std::min(best, std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+        if (sum == 0.0f) {
+            values[0] = 1.0f;  // Keeps the loop from being optimised away
+        }
+    }
+    return best;
+}
+
+double percentile(const std::vector<double>& sorted, double fraction) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    std::size_t index = static_cast<std::size_t>(fraction * (sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+void startScenario(Game& game, const Scenario& scenario) {
+    game.setWorldSeed(worldSeed);
+    game.setState(scenario.state);
+    game.reset();
+    if (scenario.speed > 0.0f) {
+        game.setDifficulty(scenario.speed, scenario.spawnInterval);
+    }
+    if (scenario.lives > 0) {
+        game.setLives(scenario.lives);
+    }
+}
+
+void dropCascade(Game& game, int frame) {
+    // A column of obstacles with rising speeds: the fast ones catch the slow
+    // ones and the contacts spread sideways through the cluster
+    for (int i = 0; i < 12; ++i) {
+        float x = 200.0f + static_cast<float>((frame / 120 + i * 7) % 80);
+        float y = -50.0f - 45.0f * static_cast<float>(i);
+        float radius = 15.0f + static_cast<float>((i * 7) % 21);  // Fixed, unlike random spawns
+        game.spawnObstacleAt(x, y, 250.0f + 60.0f * static_cast<float>(i), radius);
+    }
+}
+
+ScenarioResult runScenario(const Scenario& scenario) {
+    long startRssKb = peakRssKb();
+    auto recorder = std::make_unique<RecordingRenderer>();
+    Game game(std::move(recorder));
+    game.setAutopilot(scenario.autopilot);
+    startScenario(game, scenario);
+
+    ScenarioResult result;
+    result.name = scenario.name;
+    result.frames = scenario.frames;
+
+    std::vector<double> frameTimes;
+    frameTimes.reserve(scenario.frames);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < scenario.frames; ++frame) {
+        // Long runs outlive the five lives; start over like a player would
+        if (game.getState() != scenario.state) {
+            startScenario(game, scenario);
+            result.restarts++;
+        }
+        if (scenario.cascade && frame % 120 == 0) {
+            dropCascade(game, frame);
+        }
+
+        auto frameStart = std::chrono::steady_clock::now();
+        game.setInput(scriptedInput(frame));
+        game.tick(tickDelta);
+        game.renderFrame();
+        auto frameEnd = std::chrono::steady_clock::now();
+        frameTimes.push_back(std::chrono::duration<double, std::micro>(frameEnd - frameStart).count());
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::sort(frameTimes.begin(), frameTimes.end());
+    result.p50Us = percentile(frameTimes, 0.50);
+    result.p90Us = percentile(frameTimes, 0.90);
+    result.p99Us = percentile(frameTimes, 0.99);
+    result.maxUs = frameTimes.empty() ? 0.0 : frameTimes.back();
+    result.ticksPerSecond = seconds > 0.0 ? scenario.frames / seconds : 0.0;
+    result.rssGrowthKb = peakRssKb() - startRssKb;
+    result.arenaPeakBytes = game.getFrameArena().getHighWater();
+    return result;
+}
+
+// Runs the scenario in a child process, so its peak RSS is its own rather
+// than that of every scenario before it. A forked child starts with only the
+// pages it touches counted.
+bool runIsolated(const Scenario& scenario, ScenarioResult& result) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return false;
+    }
+    pid_t child = fork();
+    if (child < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+    if (child == 0) {
+        close(fds[0]);
+        ScenarioResult measured = runScenario(scenario);
+        bool sent = write(fds[1], &measured, sizeof(measured)) == static_cast<ssize_t>(sizeof(measured));
+        _exit(sent ? 0 : 1);
+    }
+
+    close(fds[1]);
+    // Smaller than PIPE_BUF, so it arrives in one piece
+    bool received = read(fds[0], &result, sizeof(result)) == static_cast<ssize_t>(sizeof(result));
+    close(fds[0]);
+    int status = 0;
+    waitpid(child, &status, 0);
+    return received && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+// Best timings over repeated runs of one scenario; the track is seeded, so
+// everything else is the same from run to run
+ScenarioResult bestResult(const std::vector<ScenarioResult>& runs) {
+    ScenarioResult result = runs.front();
+    for (const ScenarioResult& run : runs) {
+        result.p50Us = std::min(result.p50Us, run.p50Us);
+        result.p90Us = std::min(result.p90Us, run.p90Us);
+        result.p99Us = std::min(result.p99Us, run.p99Us);
+        result.maxUs = std::min(result.maxUs, run.maxUs);
+        result.ticksPerSecond = std::max(result.ticksPerSecond, run.ticksPerSecond);
+        result.rssGrowthKb = std::max(result.rssGrowthKb, run.rssGrowthKb);
+        result.arenaPeakBytes = std::max(result.arenaPeakBytes, run.arenaPeakBytes);
+    }
+    return result;
+}
+
+void writeReport(std::ostream& out, const std::vector<ScenarioResult>& results) {
+    // One scenario per line keeps the file diffable and easy to read back
+    out << "{\"scenarios\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const ScenarioResult& r = results[i];
+        out << std::fixed << std::setprecision(2)
+            << "  {\"name\": \"" << r.name << "\""
+            << ", \"frames\": " << r.frames
+            << ", \"restarts\": " << r.restarts
+            << ", \"p50Us\": " << r.p50Us
+            << ", \"p90Us\": " << r.p90Us
+            << ", \"p99Us\": " << r.p99Us
+            << ", \"maxUs\": " << r.maxUs
+            << ", \"ticksPerSecond\": " << r.ticksPerSecond
+            << ", \"rssGrowthKb\": " << r.rssGrowthKb
+            << ", \"arenaPeakBytes\": " << r.arenaPeakBytes
+            << ", \"referenceUs\": " << r.referenceUs << "}"
+            << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "]}\n";
+}
+
+// Reads a report written by writeReport: name -> field -> value
+bool readReport(const std::string& path, std::map<std::string, std::map<std::string, double>>& report) {
+    std::ifstream in(path);
+    if (!in) {
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(in, line)) {
+        std::size_t nameStart = line.find("\"name\": \"");
+        if (nameStart == std::string::npos) {
+            continue;
+        }
+        nameStart += 9;
+        std::string name = line.substr(nameStart, line.find('"', nameStart) - nameStart);
+
+        std::size_t position = 0;
+        while ((position = line.find(", \"", position)) != std::string::npos) {
+            std::size_t keyStart = position + 3;
+            std::size_t keyEnd = line.find('"', keyStart);
+            std::string key = line.substr(keyStart, keyEnd - keyStart);
+            report[name][key] = std::strtod(line.c_str() + keyEnd + 3, nullptr);
+            position = keyEnd;
+        }
+    }
+    return true;
+}
+
+// Returns the number of regressed metrics, printing each to stderr.
+// Baseline timings are first scaled by how much slower this machine ran the
+// reference workload. A metric regresses when it is worse by more than
+// `threshold` (relative) and by more than its noise floor (absolute), so
+// sub-microsecond frames on the idle menu cannot fail the gate on timer
+// jitter alone.
+int compareWithBaseline(const std::vector<ScenarioResult>& results,
+                        const std::map<std::string, std::map<std::string, double>>& baseline,
+                        double threshold) {
+    const double frameNoiseUs = 2.0;
+    const double tailNoiseUs = 25.0;   // p99 frames catch scheduler jitter from the worker threads
+    const double rssNoiseKb = 1024.0;
+
+    int regressions = 0;
+    auto check = [&](const std::string& scenario, const char* metric, double expected, double current,
+                     double worsening, double noiseFloor) {
+        if (expected <= 0.0) {
+            return;
+        }
+        double change = worsening / expected;
+        if (change > threshold && worsening > noiseFloor) {
+            std::cerr << std::fixed << std::setprecision(2)
+                      << "REGRESSION " << scenario << " " << metric << ": "
+                      << expected << " -> " << current
+                      << " (" << std::setprecision(1) << change * 100.0 << "% worse)" << std::endl;
+            regressions++;
+        }
+    };
+
+    for (const ScenarioResult& r : results) {
+        auto entry = baseline.find(r.name);
+        if (entry == baseline.end()) {
+            std::cerr << "note: no baseline for " << r.name << std::endl;
+            continue;
+        }
+        const std::map<std::string, double>& fields = entry->second;
+        auto baselineValue = [&fields](const char* metric) {
+            auto field = fields.find(metric);
+            return field == fields.end() ? 0.0 : field->second;
+        };
+        double baseReference = baselineValue("referenceUs");
+        double scale = baseReference > 0.0 && r.referenceUs > 0.0 ? r.referenceUs / baseReference : 1.0;
+
+        double p50Us = scale * baselineValue("p50Us");
+        double p99Us = scale * baselineValue("p99Us");
+        double rssKb = baselineValue("rssGrowthKb");
+        check(r.name, "p50Us", p50Us, r.p50Us, r.p50Us - p50Us, frameNoiseUs);
+        check(r.name, "p99Us", p99Us, r.p99Us, r.p99Us - p99Us, tailNoiseUs);
+        check(r.name, "rssGrowthKb", rssKb, static_cast<double>(r.rssGrowthKb),
+              static_cast<double>(r.rssGrowthKb) - rssKb, rssNoiseKb);
+
+        // Throughput: lower is worse; the noise floor applies to the per-tick cost
+        double baseTicks = baselineValue("ticksPerSecond") / scale;
+        if (baseTicks > 0.0 && r.ticksPerSecond > 0.0) {
+            double extraUsPerTick = 1e6 / r.ticksPerSecond - 1e6 / baseTicks;
+            if (extraUsPerTick > frameNoiseUs) {
+                check(r.name, "ticksPerSecond", baseTicks, r.ticksPerSecond, baseTicks - r.ticksPerSecond, 0.0);
+            }
+        }
+    }
+    return regressions;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string outputPath;
+    std::string baselinePath;
+    std::string only;
+    double threshold = 0.15;
+    int repeat = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--output" && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else if (arg == "--baseline" && i + 1 < argc) {
+            baselinePath = argv[++i];
+        } else if (arg == "--threshold" && i + 1 < argc) {
+            threshold = std::stod(argv[++i]);
+        } else if (arg == "--repeat" && i + 1 < argc) {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--only" && i + 1 < argc) {
+            only = argv[++i];
+        } else {
+            std::cerr << "Usage: ScenarioBenchmark [--output report.json] [--baseline baseline.json]"
+                         " [--threshold 0.15] [--repeat 1] [--only scenario]" << std::endl;
+            return 2;
+        }
+    }
+
+    const Scenario scenarios[] = {
+        {"idle-menu", GameState::Menu, 60 * 60, 0.0f, 0.0f, false, false, 0},
+        {"early-game", GameState::Playing, 60 * 30, 0.0f, 0.0f, false, false, 0},
+        {"late-game-max-speed", GameState::Playing, 60 * 60, 1200.0f, 0.2f, false, false, 0},
+        {"autopilot-max-speed", GameState::Playing, 60 * 60, 1200.0f, 0.2f, false, true, 0},
+        {"collision-cascade", GameState::Playing, 60 * 60, 600.0f, 0.5f, true, false, 0},
+        {"long-session", GameState::Playing, 60 * 60 * 10, 0.0f, 0.0f, false, false, 100000},
+    };
+
+    // The game logs dodges and hits to stdout; keep that out of the report
+    std::streambuf* coutBuffer = std::cout.rdbuf(nullptr);
+    double reference = referenceUs();
+    std::vector<ScenarioResult> results;
+    for (const Scenario& scenario : scenarios) {
+        if (only.empty() || only == scenario.name) {
+            std::vector<ScenarioResult> runs(repeat);
+            for (ScenarioResult& run : runs) {
+                if (!runIsolated(scenario, run)) {
+                    std::cout.rdbuf(coutBuffer);
+                    std::cerr << "Scenario " << scenario.name << " did not finish" << std::endl;
+                    return 2;
+                }
+            }
+            results.push_back(bestResult(runs));
+            results.back().referenceUs = reference;
+        }
+    }
+    std::cout.rdbuf(coutBuffer);
+    std::cout.clear();
+
+    if (outputPath.empty()) {
+        writeReport(std::cout, results);
+    } else {
+        std::ofstream out(outputPath);
+        writeReport(out, results);
+        if (!out) {
+            std::cerr << "Could not write " << outputPath << std::endl;
+            return 2;
+        }
+    }
+
+    if (baselinePath.empty()) {
+        return 0;
+    }
+
+    std::map<std::string, std::map<std::string, double>> baseline;
+    if (!readReport(baselinePath, baseline)) {
+        std::cerr << "Could not read baseline " << baselinePath << std::endl;
+        return 2;
+    }
+    int regressions = compareWithBaseline(results, baseline, threshold);
+    std::cerr << (regressions == 0 ? "No regressions" : "Regressions found")
+              << " (threshold " << std::setprecision(0) << std::fixed << threshold * 100.0 << "%)" << std::endl;
+    return regressions == 0 ? 0 : 1;
+}
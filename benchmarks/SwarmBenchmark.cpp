@@ -0,0 +1,184 @@
+// Boid swarm cost over boid count: grid rebuild, steering and integration
+// per tick, plus building the triangle batch. For smaller swarms it also
+// times an all-pairs steering pass on the same state and checks that the
+// grid found the same neighbours. Exits non-zero if the results differ or
+// several thousand boids no longer fit a 60 Hz frame.
+// Usage: SwarmBenchmark [ticks]
+#include "../BoidSwarm.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+const double frameBudgetUs = 1e6 / 60.0;
+const std::size_t budgetBoids = 4000;      // Must fit the whole frame budget
+const std::size_t bruteForceLimit = 2000;  // All-pairs is O(n²); skip it above this
+
+// Counts what a frame would draw and nothing else
+class NullRenderer : public Renderer {
+private:
+    sf::View view;
+
+public:
+    void clear(const sf::Color&) override {}
+    void setView(const sf::View& newView) override { view = newView; }
+    const sf::View& getView() const override { return view; }
+    void draw(const sf::Shape&) override { current.drawCalls++; }
+    void draw(const sf::Text&) override { current.drawCalls++; }
+    void draw(const sf::Vertex*, std::size_t count, sf::PrimitiveType) override {
+        current.drawCalls++;
+        current.vertices += static_cast<int>(count);
+    }
+    void display() override { finishFrame(); }
+};
+
+// The flocking rules over every pair, in the same form as BoidSwarm's steering
+void bruteForceSteering(const BoidSwarm& swarm, std::vector<float>& outX, std::vector<float>& outY) {
+    const float near = BoidSwarm::neighbourRadius * BoidSwarm::neighbourRadius;
+    const float close = BoidSwarm::separationRadius * BoidSwarm::separationRadius;
+    const float* x = swarm.positionsX();
+    const float* y = swarm.positionsY();
+    const float* vx = swarm.velocitiesX();
+    const float* vy = swarm.velocitiesY();
+    std::size_t count = swarm.size();
+    for (std::size_t i = 0; i < count; ++i) {
+        float n = 0.0f, offsetX = 0.0f, offsetY = 0.0f, velocityX = 0.0f, velocityY = 0.0f;
+        float awayX = 0.0f, awayY = 0.0f;
+        for (std::size_t j = 0; j < count; ++j) {
+            float dx = x[j] - x[i];
+            float dy = y[j] - y[i];
+            float d2 = dx * dx + dy * dy;
+            if (d2 < near) {
+                n += 1.0f;
+                offsetX += dx;
+                offsetY += dy;
+                velocityX += vx[j];
+                velocityY += vy[j];
+            }
+            if (d2 < close) {
+                awayX -= dx / (d2 + 1.0f);
+                awayY -= dy / (d2 + 1.0f);
+            }
+        }
+        outX[i] = BoidSwarm::cohesionWeight * offsetX / n +
+                  BoidSwarm::alignmentWeight * (velocityX / n - vx[i]) + BoidSwarm::separationWeight * awayX;
+        outY[i] = BoidSwarm::cohesionWeight * offsetY / n +
+                  BoidSwarm::alignmentWeight * (velocityY / n - vy[i]) + BoidSwarm::separationWeight * awayY;
+    }
+}
+
+struct Result {
+    std::size_t live = 0;
+    double updateUs = 0.0;
+    double drawUs = 0.0;
+    double neighboursPerBoid = 0.0;
+    double bruteForceUs = -1.0;
+    double maxError = 0.0;     // Worst steering difference relative to its size
+};
+
+Result run(std::size_t boids, int ticks) {
+    using Clock = std::chrono::steady_clock;
+    BoidSwarm swarm(boids);
+    swarm.clear(7);
+    NullRenderer renderer;
+
+    // Flocks of 250 spread over the field, all leaning towards a player near the bottom
+    const sf::Vector2f player(240.0f, 760.0f);
+    for (std::size_t released = 0; released < boids; released += 250) {
+        float x = 60.0f + static_cast<float>((released / 250 * 97) % 360);
+        float y = 60.0f + static_cast<float>((released / 250 * 151) % 640);
+        swarm.release(sf::Vector2f(x, y), static_cast<std::uint32_t>(std::min<std::size_t>(250, boids - released)),
+                      50.0f, sf::Vector2f(0.0f, 0.0f));
+    }
+    for (int tick = 0; tick < 120; ++tick) {
+        swarm.update(1.0f / 60.0f, player, 0.0f);
+    }
+
+    Result result;
+    std::uint64_t checks = 0;
+    std::uint64_t boidTicks = 0;
+    double updateNs = 0.0;
+    double drawNs = 0.0;
+    for (int tick = 0; tick < ticks; ++tick) {
+        auto start = Clock::now();
+        swarm.update(1.0f / 60.0f, player, 0.0f);
+        auto updated = Clock::now();
+        swarm.draw(renderer);
+        renderer.display();
+        auto drawn = Clock::now();
+        updateNs += std::chrono::duration<double, std::nano>(updated - start).count();
+        drawNs += std::chrono::duration<double, std::nano>(drawn - updated).count();
+        checks += swarm.getStats().neighbourChecks;
+        boidTicks += swarm.size();
+    }
+    result.live = swarm.size();
+    result.updateUs = updateNs / ticks / 1000.0;
+    result.drawUs = drawNs / ticks / 1000.0;
+    result.neighboursPerBoid = boidTicks ? static_cast<double>(checks) / boidTicks : 0.0;
+
+    if (boids <= bruteForceLimit) {
+        // A zero-length tick re-sorts and steers without moving anything, so
+        // the steering columns line up with the position columns
+        swarm.update(0.0f, player, 0.0f);
+        std::vector<float> referenceX(swarm.size());
+        std::vector<float> referenceY(swarm.size());
+        int repeats = std::max(1, static_cast<int>(200000 / std::max<std::size_t>(1, boids)));
+        auto start = Clock::now();
+        for (int repeat = 0; repeat < repeats; ++repeat) {
+            bruteForceSteering(swarm, referenceX, referenceY);
+        }
+        result.bruteForceUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / repeats;
+        for (std::size_t i = 0; i < swarm.size(); ++i) {
+            double scale = 1.0 + std::fabs(referenceX[i]) + std::fabs(referenceY[i]);
+            double error = (std::fabs(swarm.steeringX()[i] - referenceX[i]) +
+                            std::fabs(swarm.steeringY()[i] - referenceY[i])) / scale;
+            result.maxError = std::max(result.maxError, error);
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int ticks = argc > 1 ? std::max(1, std::atoi(argv[1])) : 600;
+    const std::size_t counts[] = {250, 500, 1000, 2000, 4000, 8000};
+
+    std::cout << "Swarm, " << ticks << " ticks per size, all flocks on screen around the player\n";
+    std::cout << std::setw(7) << "boids" << std::setw(7) << "live" << std::setw(12) << "update us"
+              << std::setw(10) << "draw us" << std::setw(14) << "checks/boid" << std::setw(16) << "all-pairs us"
+              << std::setw(11) << "max err" << std::setw(10) << "frame %" << "\n";
+
+    bool ok = true;
+    std::cout << std::fixed;
+    for (std::size_t boids : counts) {
+        Result result = run(boids, ticks);
+        double frameShare = 100.0 * (result.updateUs + result.drawUs) / frameBudgetUs;
+        std::cout << std::setw(7) << boids << std::setw(7) << result.live << std::setprecision(1)
+                  << std::setw(12) << result.updateUs << std::setw(10) << result.drawUs
+                  << std::setw(14) << result.neighboursPerBoid;
+        if (result.bruteForceUs >= 0.0) {
+            std::cout << std::setw(16) << result.bruteForceUs << std::setprecision(6) << std::setw(11)
+                      << result.maxError;
+        } else {
+            std::cout << std::setw(16) << "-" << std::setw(11) << "-";
+        }
+        std::cout << std::setprecision(1) << std::setw(9) << frameShare << "%\n";
+
+        if (result.maxError > 1e-3) {
+            std::cout << "  grid steering differs from all-pairs steering\n";
+            ok = false;
+        }
+        if (boids == budgetBoids && frameShare > 100.0) {
+            std::cout << "  " << budgetBoids << " boids do not fit a 60 Hz frame\n";
+            ok = false;
+        }
+    }
+    std::cout << (ok ? "OK" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,123 @@
+// Wave script scheduling cost: many concurrent scripts, few of them due per
+// tick. Per-tick cost should follow the scripts resumed, not the scripts
+// alive, so 512 slow scripts cost about what 16 fast ones do.
+#include "../WaveDirector.h"
+#include "../WaveScripts.h"
+#include "../EntityStore.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+const int measuredTicks = 60 * 60;   // One minute of gameplay
+const std::size_t directorCapacity = 512;
+
+// Drops one obstacle every `period` ticks, forever
+class MetronomeWave : public WaveScript {
+private:
+    std::uint32_t phase;
+    std::uint32_t period;
+    float x;
+
+public:
+    MetronomeWave(std::uint32_t phase, std::uint32_t period, float x) : phase(phase), period(period), x(x) {}
+
+    WaveStep resume(WaveDirector& director) override {
+        WAVE_BEGIN;
+        WAVE_WAIT_TICKS(phase);
+        for (;;) {
+            director.spawn(x, 1.0f, 15.0f);
+            WAVE_WAIT_TICKS(period);
+        }
+        WAVE_END;
+    }
+};
+
+struct Scenario {
+    const char* name;
+    std::uint32_t scripts;
+    std::uint32_t period;    // 0 = built-in patterns, restarted as they finish
+};
+
+struct Result {
+    double nsPerTick = 0.0;
+    double resumesPerTick = 0.0;
+    std::uint32_t running = 0;
+};
+
+Result run(const Scenario& scenario) {
+    EntityStore store;
+    store.setCapacity(EntityKind::Obstacle, 4096);
+    WaveDirector director(directorCapacity);
+    director.clear(42);
+    for (std::uint32_t i = 0; i < scenario.scripts; ++i) {
+        if (scenario.period) {
+            director.start<MetronomeWave>(i % scenario.period, scenario.period, 10.0f + (i * 37) % 420);
+        } else {
+            startRandomWave(director, 1.0f);
+        }
+    }
+    sf::Vector2f player(240.0f, 760.0f);
+
+    // Warm up past the staggered starts
+    for (int tick = 0; tick < 300; ++tick) {
+        director.update(store, 600.0f, player);
+        store.clear(EntityKind::Obstacle);
+    }
+
+    Result result;
+    std::uint64_t resumesBefore = director.getStats().resumes;
+    double totalNs = 0.0;
+    for (int tick = 0; tick < measuredTicks; ++tick) {
+        // Keep the pattern mix topped up; conditions see a quiet field half the time
+        if (!scenario.period) {
+            while (director.getStats().running < scenario.scripts && startRandomWave(director, 1.0f)) {
+            }
+            player.x = (tick / 120) % 2 ? 60.0f : 240.0f;
+        }
+        auto start = std::chrono::steady_clock::now();
+        director.update(store, 600.0f, player);
+        auto end = std::chrono::steady_clock::now();
+        totalNs += std::chrono::duration<double, std::nano>(end - start).count();
+        result.running = std::max(result.running, director.getStats().running);
+        if (tick % 2 == 0) {
+            store.clear(EntityKind::Obstacle);
+        }
+    }
+    result.nsPerTick = totalNs / measuredTicks;
+    result.resumesPerTick = static_cast<double>(director.getStats().resumes - resumesBefore) / measuredTicks;
+    return result;
+}
+
+} // namespace
+
+int main() {
+    const Scenario scenarios[] = {
+        {"16 scripts, every 4", 16, 4},
+        {"512 scripts, every 128", 512, 128},
+        {"512 scripts, every 4", 512, 4},
+        {"512 built-in patterns", 512, 0},
+    };
+
+    std::cout << "Wave scripts over " << measuredTicks << " ticks, pool of " << directorCapacity
+              << " frames of " << WaveDirector::maxScriptBytes << " bytes\n";
+    std::cout << std::left << std::setw(26) << "scenario"
+              << std::right << std::setw(10) << "running"
+              << std::setw(14) << "resumes/tick"
+              << std::setw(12) << "ns/tick"
+              << std::setw(12) << "ns/resume" << "\n";
+
+    for (const auto& scenario : scenarios) {
+        Result result = run(scenario);
+        std::cout << std::left << std::setw(26) << scenario.name
+                  << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(10) << result.running
+                  << std::setw(14) << result.resumesPerTick
+                  << std::setw(12) << result.nsPerTick
+                  << std::setw(12) << (result.resumesPerTick > 0.0 ? result.nsPerTick / result.resumesPerTick : 0.0)
+                  << "\n";
+    }
+    return 0;
+}
@@ -1,10 +1,122 @@
 #include "Game.h"
+#include "NullAudioSink.h"
+#include "SfmlAudioSink.h"
+#include "ConditionedTransport.h"
+#include "UdpTransport.h"
 #include <iostream>
+#include <string>
 
-int main() {
+int main(int argc, char** argv) {
     try {
         Game game;
+        
+        // --telemetry <file>: record one binary record per frame
+        // --trace-dir <dir>: where hitch traces go (default: current directory)
+        // --frame-budget <ms>: gameplay frames slower than this dump a trace
+        // --no-trace: turn the flight recorder off
+        // --render-scale <0.25-1|auto>: internal resolution of the gameplay layers
+        // --metrics [name]: publish live metrics in shared memory (default /triangle-game)
+        // --no-audio: no sound at all
+        // --audio-wav <file>: mix to a WAV file instead of the sound device
+        // --autopilot: the computer plays, and starts games from idle menus (attract mode)
+        // --autopilot-budget <us>: planning time per tick (default 500)
+        // --world-seed <n>: play the same generated track every game
+        // --versus <side 0|1> <port> <peer-port>: two-player match with another process on this machine
+        // --link <latency-ms> <loss 0-1>: degrade the versus link, for testing rollback
+        // --fixed-point: versus physics in integers, bit-exact across builds and machines (both peers)
+        // --spectate <file|unix:path>: stream what is on screen for a viewer
+        // --view <file|unix:path>: be that viewer instead of playing
+        // --history <file>: where finished runs are kept (default triangle-runs.tgh)
+        // --no-history: keep no record of runs
+        bool audioEnabled = true;
+        std::string audioWav;
+        int versusSide = -1;
+        int versusPort = 0;
+        int versusPeerPort = 0;
+        std::uint64_t versusSeed = 1;   // Both peers must agree; --world-seed overrides
+        LinkConditions link;
+        VersusPhysics versusPhysics = VersusPhysics::Float;
+        std::string historyPath = defaultHistoryPath;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--telemetry" && hasValue) {
+                game.enableTelemetry(argv[++i]);
+            } else if (arg == "--trace-dir" && hasValue) {
+                game.setTraceDirectory(argv[++i]);
+            } else if (arg == "--frame-budget" && hasValue) {
+                game.setFrameBudget(std::stof(argv[++i]));
+            } else if (arg == "--render-scale" && hasValue) {
+                std::string value = argv[++i];
+                if (value == "auto") {
+                    game.setAutoRenderScale(true);
+                } else {
+                    game.setRenderScale(std::stof(value));
+                }
+            } else if (arg == "--audio-wav" && hasValue) {
+                audioWav = argv[++i];
+            } else if (arg == "--metrics") {
+                bool named = hasValue && argv[i + 1][0] == '/';
+                game.enableMetrics(named ? argv[++i] : defaultLiveMetricsName);
+            } else if (arg == "--autopilot-budget" && hasValue) {
+                game.setAutopilot(true, std::stof(argv[++i]));
+            } else if (arg == "--world-seed" && hasValue) {
+                versusSeed = std::stoull(argv[++i]);
+                game.setWorldSeed(versusSeed);
+            } else if (arg == "--versus" && i + 3 < argc) {
+                versusSide = std::stoi(argv[++i]) == 0 ? 0 : 1;
+                versusPort = std::stoi(argv[++i]);
+                versusPeerPort = std::stoi(argv[++i]);
+            } else if (arg == "--link" && i + 2 < argc) {
+                link.latencyMs = std::stof(argv[++i]);
+                link.lossRate = std::stof(argv[++i]);
+            } else if (arg == "--spectate" && hasValue) {
+                game.enableSpectatorOutput(argv[++i]);
+            } else if (arg == "--view" && hasValue) {
+                if (!game.enableViewer(argv[++i])) {
+                    return 1;
+                }
+                audioEnabled = false;
+            } else if (arg == "--autopilot") {
+                game.setAutopilot(true);
+            } else if (arg == "--no-trace") {
+                game.getTracer().setEnabled(false);
+            } else if (arg == "--history" && hasValue) {
+                historyPath = argv[++i];
+            } else if (arg == "--fixed-point") {
+                versusPhysics = VersusPhysics::Fixed;
+            } else if (arg == "--no-history") {
+                historyPath.clear();
+            } else if (arg == "--no-audio") {
+                audioEnabled = false;
+            }
+        }
+        
+        if (versusSide >= 0) {
+            auto socket = std::make_unique<UdpTransport>();
+            if (!socket->open(static_cast<std::uint16_t>(versusPort), static_cast<std::uint16_t>(versusPeerPort))) {
+                std::cerr << "Error: could not open UDP port " << versusPort << std::endl;
+                return 1;
+            }
+            auto transport = std::make_unique<ConditionedTransport>(std::move(socket), link);
+            game.enableVersus(std::make_unique<RollbackSession>(std::move(transport), versusSide, versusSeed,
+                                                                  versusPhysics));
+        }
+        
+        if (!historyPath.empty()) {
+            game.enableHistory(historyPath);
+        }
+        
+        if (audioEnabled) {
+            if (audioWav.empty()) {
+                game.enableAudio(std::make_unique<SfmlAudioSink>());
+            } else {
+                game.enableAudio(std::make_unique<NullAudioSink>(audioWav));
+            }
+        }
+        
         game.run();
+        game.logAllocationReport();
     }
     catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
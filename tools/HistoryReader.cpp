@@ -0,0 +1,89 @@
+// Prints the run history a game keeps (--history): the best runs and the
+// runs of one day. Reads the file without locking it, so it works while a
+// game is running.
+// Usage: HistoryReader [file] [--top N] [--day YYYY-MM-DD|today]
+#include "../RunHistory.h"
+#include <algorithm>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+void printRun(const RunHistory& history, std::uint32_t index) {
+    const RunRecord& run = history.record(index);
+    std::time_t when = static_cast<std::time_t>(run.timestamp);
+    std::tm local;
+    localtime_r(&when, &local);
+    std::cout << std::setw(10) << index << std::setw(8) << run.score
+              << std::fixed << std::setprecision(1) << std::setw(9) << run.survivalSeconds << " s"
+              << std::setw(8) << run.peakSpeed << "  " << std::put_time(&local, "%Y-%m-%d %H:%M")
+              << "  seed " << run.worldSeed << (history.isValid(run) ? "" : "  (bad checksum)") << "\n";
+}
+
+bool parseDay(const std::string& text, std::uint32_t& day) {
+    if (text == "today") {
+        day = RunHistory::dayOf(static_cast<std::uint64_t>(std::time(nullptr)));
+        return true;
+    }
+    std::tm date = {};
+    if (!strptime(text.c_str(), "%Y-%m-%d", &date)) {
+        return false;
+    }
+    date.tm_hour = 12;   // Midday, clear of DST changes
+    date.tm_isdst = -1;
+    day = RunHistory::dayOf(static_cast<std::uint64_t>(std::mktime(&date)));
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string path = "triangle-runs.tgh";
+    std::uint32_t topCount = 10;
+    std::string dayText = "today";
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--top" && i + 1 < argc) {
+            topCount = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--day" && i + 1 < argc) {
+            dayText = argv[++i];
+        } else if (arg[0] != '-') {
+            path = arg;
+        } else {
+            std::cerr << "Usage: HistoryReader [file] [--top N] [--day YYYY-MM-DD|today]" << std::endl;
+            return 1;
+        }
+    }
+
+    RunHistory history;
+    if (!history.open(path, true)) {
+        return 1;
+    }
+    std::cout << path << ": " << history.size() << " runs\n";
+    std::cout << std::setw(10) << "run" << std::setw(8) << "score" << std::setw(11) << "survived"
+              << std::setw(8) << "speed" << "  when\n";
+
+    std::vector<std::uint32_t> best(std::min(topCount, RunHistory::topCapacity));
+    std::uint32_t count = history.top(best.data(), static_cast<std::uint32_t>(best.size()));
+    std::cout << "Top " << count << ":\n";
+    for (std::uint32_t i = 0; i < count; ++i) {
+        printRun(history, best[i]);
+    }
+
+    std::uint32_t day = 0;
+    RunDay runs;
+    if (!parseDay(dayText, day)) {
+        std::cerr << "Bad day " << dayText << std::endl;
+        return 1;
+    }
+    if (!history.findDay(day, runs)) {
+        std::cout << dayText << ": no runs\n";
+        return 0;
+    }
+    std::cout << dayText << ": " << runs.runs << " runs, best:\n";
+    printRun(history, runs.bestRecord);
+    return 0;
+}
@@ -0,0 +1,236 @@
+// Reads the live metrics block a running game publishes (--metrics).
+// Attaches read-only, takes a consistent snapshot through the seqlock and
+// prints it, once or every N seconds, as text or in Prometheus exposition
+// format for scraping.
+// Usage: MetricsReader [--name /triangle-game] [--watch seconds] [--prometheus]
+#include "../LiveMetrics.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace {
+
+// Plain copy of the block's fields
+struct Snapshot {
+    std::uint32_t pid;
+    std::uint64_t frame;
+    std::uint64_t heartbeatNs;
+    std::uint32_t state;
+    std::int32_t score;
+    std::int32_t lives;
+    float gameSpeed;
+    float lastFrameMs;
+    std::uint32_t obstacles;
+    std::uint32_t explosionParticles;
+    std::uint32_t backgroundParticles;
+    std::uint32_t trailSamples;
+    std::uint64_t pairContacts;
+    std::uint64_t playerHits;
+    std::uint64_t dodges;
+    std::uint64_t frameBuckets[liveMetricsBucketCount];
+};
+
+const char* stateName(std::uint32_t state) {
+    switch (state) {
+        case 0: return "menu";
+        case 1: return "playing";
+        case 2: return "game-over";
+        default: return "unknown";
+    }
+}
+
+bool readSnapshot(const LiveMetricsBlock& block, Snapshot& out) {
+    const auto relaxed = std::memory_order_relaxed;
+    for (int attempt = 0; attempt < 10000; ++attempt) {
+        std::uint64_t before = block.sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+        out.pid = block.pid;
+        out.frame = block.frame.load(relaxed);
+        out.heartbeatNs = block.heartbeatNs.load(relaxed);
+        out.state = block.state.load(relaxed);
+        out.score = block.score.load(relaxed);
+        out.lives = block.lives.load(relaxed);
+        out.gameSpeed = block.gameSpeed.load(relaxed);
+        out.lastFrameMs = block.lastFrameMs.load(relaxed);
+        out.obstacles = block.obstacles.load(relaxed);
+        out.explosionParticles = block.explosionParticles.load(relaxed);
+        out.backgroundParticles = block.backgroundParticles.load(relaxed);
+        out.trailSamples = block.trailSamples.load(relaxed);
+        out.pairContacts = block.pairContacts.load(relaxed);
+        out.playerHits = block.playerHits.load(relaxed);
+        out.dodges = block.dodges.load(relaxed);
+        for (int i = 0; i < liveMetricsBucketCount; ++i) {
+            out.frameBuckets[i] = block.frameBuckets[i].load(relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (block.sequence.load(relaxed) == before) {
+            return true;
+        }
+    }
+    return false;
+}
+
+double ageSeconds(const Snapshot& s) {
+    auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    return (static_cast<double>(now) - static_cast<double>(s.heartbeatNs)) * 1e-9;
+}
+
+// Upper bound of the bucket holding the given fraction of frames
+std::string bucketPercentile(const Snapshot& s, double fraction) {
+    std::uint64_t total = 0;
+    for (std::uint64_t count : s.frameBuckets) {
+        total += count;
+    }
+    if (total == 0) {
+        return "-";
+    }
+    std::uint64_t seen = 0;
+    for (int i = 0; i < liveMetricsBucketCount; ++i) {
+        seen += s.frameBuckets[i];
+        if (seen >= fraction * total) {
+            if (i == liveMetricsBucketCount - 1) {
+                return ">" + std::to_string(static_cast<int>(liveMetricsBucketMs[i - 1])) + " ms";
+            }
+            std::ostringstream label;
+            label << "<=" << liveMetricsBucketMs[i] << " ms";
+            return label.str();
+        }
+    }
+    return "-";
+}
+
+void printText(const Snapshot& s) {
+    std::cout << std::fixed << std::setprecision(1)
+              << "pid " << s.pid << "  frame " << s.frame << "  " << stateName(s.state)
+              << "  updated " << ageSeconds(s) * 1000.0 << " ms ago"
+              << (ageSeconds(s) > 2.0 ? "  (STALE)" : "") << '\n'
+              << "score " << s.score << "  lives " << s.lives << "  speed " << s.gameSpeed
+              << "  last frame " << s.lastFrameMs << " ms"
+              << "  p50 " << bucketPercentile(s, 0.50) << "  p99 " << bucketPercentile(s, 0.99) << '\n'
+              << "obstacles " << s.obstacles << "  explosion particles " << s.explosionParticles
+              << "  background particles " << s.backgroundParticles << "  trail samples " << s.trailSamples << '\n'
+              << "pair contacts " << s.pairContacts << "  player hits " << s.playerHits
+              << "  dodges " << s.dodges << '\n';
+    std::cout << "frame ms:";
+    for (int i = 0; i < liveMetricsBucketCount; ++i) {
+        if (i < liveMetricsBucketCount - 1) {
+            std::cout << "  <=" << liveMetricsBucketMs[i] << ": " << s.frameBuckets[i];
+        } else {
+            std::cout << "  more: " << s.frameBuckets[i];
+        }
+    }
+    std::cout << '\n' << std::endl;
+}
+
+void printPrometheus(const Snapshot& s) {
+    std::cout << "# TYPE triangle_frame_seconds histogram\n";
+    std::uint64_t cumulative = 0;
+    for (int i = 0; i < liveMetricsBucketCount; ++i) {
+        cumulative += s.frameBuckets[i];
+        std::cout << "triangle_frame_seconds_bucket{le=\"";
+        if (i < liveMetricsBucketCount - 1) {
+            std::cout << liveMetricsBucketMs[i] / 1000.0f;
+        } else {
+            std::cout << "+Inf";
+        }
+        std::cout << "\"} " << cumulative << '\n';
+    }
+    std::cout << "triangle_frame_seconds_count " << cumulative << '\n'
+              << "# TYPE triangle_frames_total counter\ntriangle_frames_total " << s.frame << '\n'
+              << "# TYPE triangle_state gauge\ntriangle_state " << s.state << '\n'
+              << "# TYPE triangle_score gauge\ntriangle_score " << s.score << '\n'
+              << "# TYPE triangle_lives gauge\ntriangle_lives " << s.lives << '\n'
+              << "# TYPE triangle_game_speed gauge\ntriangle_game_speed " << s.gameSpeed << '\n'
+              << "# TYPE triangle_entities gauge\n"
+              << "triangle_entities{kind=\"obstacle\"} " << s.obstacles << '\n'
+              << "triangle_entities{kind=\"explosion\"} " << s.explosionParticles << '\n'
+              << "triangle_entities{kind=\"background\"} " << s.backgroundParticles << '\n'
+              << "triangle_entities{kind=\"trail\"} " << s.trailSamples << '\n'
+              << "# TYPE triangle_collisions_total counter\n"
+              << "triangle_collisions_total{type=\"pair\"} " << s.pairContacts << '\n'
+              << "triangle_collisions_total{type=\"player\"} " << s.playerHits << '\n'
+              << "triangle_collisions_total{type=\"dodge\"} " << s.dodges << '\n'
+              << "# TYPE triangle_heartbeat_age_seconds gauge\n"
+              << "triangle_heartbeat_age_seconds " << ageSeconds(s) << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string name = defaultLiveMetricsName;
+    double watchSeconds = 0.0;
+    bool prometheus = false;
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--name") == 0 && hasValue) {
+            name = argv[++i];
+        } else if (std::strcmp(argv[i], "--watch") == 0 && hasValue) {
+            watchSeconds = std::stod(argv[++i]);
+        } else if (std::strcmp(argv[i], "--prometheus") == 0) {
+            prometheus = true;
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--name " << defaultLiveMetricsName
+                      << "] [--watch seconds] [--prometheus]" << std::endl;
+            return 1;
+        }
+    }
+
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        std::cerr << "Error: no metrics at " << name << " (is the game running with --metrics?)" << std::endl;
+        return 1;
+    }
+    // Mapping past the end of a shorter object would fault on first read
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(LiveMetricsBlock))) {
+        close(fd);
+        std::cerr << "Error: " << name << " is not a version " << liveMetricsVersion << " metrics block" << std::endl;
+        return 1;
+    }
+    void* mapping = mmap(nullptr, sizeof(LiveMetricsBlock), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Error: cannot map " << name << std::endl;
+        return 1;
+    }
+    const LiveMetricsBlock& block = *static_cast<const LiveMetricsBlock*>(mapping);
+    if (block.magic != liveMetricsMagic || block.version != liveMetricsVersion ||
+        block.blockSize != sizeof(LiveMetricsBlock)) {
+        std::cerr << "Error: " << name << " is not a version " << liveMetricsVersion << " metrics block" << std::endl;
+        munmap(mapping, sizeof(LiveMetricsBlock));
+        return 1;
+    }
+
+    int status = 0;
+    do {
+        Snapshot snapshot;
+        if (!readSnapshot(block, snapshot)) {
+            std::cerr << "Error: could not get a consistent snapshot" << std::endl;
+            status = 1;
+            break;
+        }
+        if (prometheus) {
+            printPrometheus(snapshot);
+        } else {
+            printText(snapshot);
+        }
+        if (watchSeconds > 0.0) {
+            std::this_thread::sleep_for(std::chrono::duration<double>(watchSeconds));
+        }
+    } while (watchSeconds > 0.0);
+
+    munmap(mapping, sizeof(LiveMetricsBlock));
+    return status;
+}
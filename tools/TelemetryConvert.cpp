@@ -0,0 +1,102 @@
+// Converts a telemetry session file written by TelemetryRecorder to CSV or JSON.
+// Usage: TelemetryConvert <session.bin> [--csv | --json]   (CSV by default)
+#include "../TelemetryRecord.h"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+const char* stateName(std::uint8_t state) {
+    switch (state) {
+        case 0: return "menu";
+        case 1: return "playing";
+        case 2: return "game-over";
+        default: return "unknown";
+    }
+}
+
+void writeCsvHeader() {
+    std::cout << "frame,state,frame_us,event_us,update_us,render_us,obstacles,"
+                 "explosion_particles,trail_particles,background_particles,pairs_tested,"
+                 "game_speed,spawn_interval,score,lives\n";
+}
+
+void writeCsv(const TelemetryRecord& r) {
+    std::cout << r.frame << ',' << stateName(r.state) << ','
+              << r.frameTime << ',' << r.eventTime << ',' << r.updateTime << ',' << r.renderTime << ','
+              << r.obstacles << ',' << r.explosionParticles << ',' << r.trailParticles << ','
+              << r.backgroundParticles << ',' << r.pairsTested << ','
+              << r.gameSpeed << ',' << r.spawnInterval << ',' << r.score << ',' << r.lives << '\n';
+}
+
+void writeJson(const TelemetryRecord& r, bool first) {
+    std::cout << (first ? "\n  " : ",\n  ")
+              << "{\"frame\":" << r.frame
+              << ",\"state\":\"" << stateName(r.state) << '"'
+              << ",\"frameUs\":" << r.frameTime
+              << ",\"eventUs\":" << r.eventTime
+              << ",\"updateUs\":" << r.updateTime
+              << ",\"renderUs\":" << r.renderTime
+              << ",\"obstacles\":" << r.obstacles
+              << ",\"explosionParticles\":" << r.explosionParticles
+              << ",\"trailParticles\":" << r.trailParticles
+              << ",\"backgroundParticles\":" << r.backgroundParticles
+              << ",\"pairsTested\":" << r.pairsTested
+              << ",\"gameSpeed\":" << r.gameSpeed
+              << ",\"spawnInterval\":" << r.spawnInterval
+              << ",\"score\":" << r.score
+              << ",\"lives\":" << r.lives << '}';
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <session.bin> [--csv | --json]" << std::endl;
+        return 1;
+    }
+    bool json = argc > 2 && std::strcmp(argv[2], "--json") == 0;
+
+    std::FILE* file = std::fopen(argv[1], "rb");
+    if (!file) {
+        std::cerr << "Error: cannot open " << argv[1] << std::endl;
+        return 1;
+    }
+
+    TelemetryFileHeader header;
+    if (std::fread(&header, sizeof(header), 1, file) != 1 ||
+        header.magic != telemetryMagic || header.version != telemetryVersion ||
+        header.recordSize != sizeof(TelemetryRecord)) {
+        std::cerr << "Error: " << argv[1] << " is not a version " << telemetryVersion
+                  << " telemetry file" << std::endl;
+        std::fclose(file);
+        return 1;
+    }
+
+    if (json) {
+        std::cout << '[';
+    } else {
+        writeCsvHeader();
+    }
+
+    TelemetryRecord buffer[256];
+    bool first = true;
+    std::size_t count;
+    while ((count = std::fread(buffer, sizeof(TelemetryRecord), 256, file)) > 0) {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (json) {
+                writeJson(buffer[i], first);
+            } else {
+                writeCsv(buffer[i]);
+            }
+            first = false;
+        }
+    }
+
+    if (json) {
+        std::cout << "\n]\n";
+    }
+    std::fclose(file);
+    return 0;
+}